@@ -0,0 +1,197 @@
+"""编译前生成只包含实际用到字形的 U8g2 中文字体子集。
+
+作为 PlatformIO 的 pre 脚本运行 (见 platformio.ini 的 extra_scripts):
+    1. 扫描 src/ 下所有 .cpp / .h 中的字符串字面量，收集码位 >= 256 的字符
+    2. 从 U8g2 库的 u8g2_fonts.c 中读出 wqy12 / wqy16 GB2312 字体
+    3. 保留全部 ASCII 段 (码位 < 256)，Unicode 段只保留用到的字形，重建查找表
+    4. 生成 $BUILD_DIR/font_subset/font_subset_gen.h 与 font_subset_gen.cpp，
+       src/FontSubset/FontSubset.h 检测到生成的头文件后自动改用子集字体
+
+也可以单独运行，检查会生成什么:
+    python3 scripts/font_subset.py <u8g2_fonts.c> <输出目录> [src 目录]
+
+U8g2 字体格式 (u8g2_font.c):
+    23 字节头部，其中 [21:23] 为 Unicode 段相对数据区的偏移 (大端)
+    ASCII 段:   [编码 1B][到下一个字形的长度 1B][数据]...，长度为 0 的项结束
+    Unicode 段: 查找表 [偏移 2B][该组最后一个编码 2B]...，最后一项编码为 0xFFFF
+                字形   [编码 2B][到下一个字形的长度 1B][数据]...，编码 0 结束
+"""
+
+import os
+import re
+import sys
+
+FONTS = ["u8g2_font_wqy12_t_gb2312", "u8g2_font_wqy16_t_gb2312"]
+HEADER_SIZE = 23
+GROUP_SIZE = 16  # 查找表每组的字形数量，组内线性查找
+
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+# 字符串 / 字符字面量或注释，从左到右匹配: 字面量里的 "//" 和 "/*" 不会被当成注释，
+# 注释和字符字面量 ('"') 里的引号也不会被当成字符串的开头
+TOKEN = re.compile(r'"(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\'|/\*.*?\*/|//[^\n]*', re.S)
+
+
+def string_literals(text):
+    """按顺序返回源码中字符串字面量的内容 (不含引号)，跳过注释。"""
+    return [m.group(0)[1:-1] for m in TOKEN.finditer(text) if m.group(0)[0] == '"']
+
+
+def used_codepoints(src_dir):
+    """收集源码字符串字面量中码位 >= 256 的字符。"""
+    chars = set()
+    for root, _, files in os.walk(src_dir):
+        for name in files:
+            if not name.endswith((".cpp", ".h", ".c")):
+                continue
+            with open(os.path.join(root, name), encoding="utf-8", errors="ignore") as f:
+                text = f.read()
+            # 跳过注释，避免把电路图和说明里的汉字也算进去
+            for literal in string_literals(text):
+                chars.update(ord(c) for c in literal if ord(c) >= 256)
+    return sorted(chars)
+
+
+def unescape_c(literal):
+    """把 C 字符串字面量的内容 (不含引号) 解码为字节。"""
+    out = bytearray()
+    i = 0
+    while i < len(literal):
+        c = literal[i]
+        if c != "\\":
+            out += c.encode("latin-1")
+            i += 1
+            continue
+        i += 1
+        c = literal[i]
+        if c in "01234567":
+            j = i
+            while j < len(literal) and j - i < 3 and literal[j] in "01234567":
+                j += 1
+            out.append(int(literal[i:j], 8) & 0xFF)
+            i = j
+        elif c == "x":
+            j = i + 1
+            while j < len(literal) and literal[j] in "0123456789abcdefABCDEF":
+                j += 1
+            out.append(int(literal[i + 1:j], 16) & 0xFF)
+            i = j
+        else:
+            out.append({"n": 10, "t": 9, "r": 13, "a": 7, "b": 8, "f": 12, "v": 11}.get(c, ord(c)))
+            i += 1
+    return bytes(out)
+
+
+def read_font(fonts_c, name):
+    """从 u8g2_fonts.c 中取出一个字体的字节数据。"""
+    # 字形数据里可能出现 ';'，只能按相邻的字符串字面量匹配到结尾
+    m = re.search(re.escape(name) + r'\s*\[\s*(\d+)\s*\][^=]*=\s*((?:"(?:[^"\\\n]|\\.)*"\s*)+);',
+                  fonts_c)
+    if m is None:
+        return None
+    size = int(m.group(1))
+    data = b"".join(unescape_c(s) for s in LITERAL.findall(m.group(2)))
+    return data[:size]
+
+
+def subset_font(font, keep):
+    """保留 ASCII 段和 keep 中的 Unicode 字形，返回 (新字体, 保留数量, 缺失的码位)。"""
+    unicode_pos = HEADER_SIZE + ((font[21] << 8) | font[22])
+
+    # 跳过查找表，找到第一个 Unicode 字形
+    table = unicode_pos
+    while True:
+        last = (font[table + 2] << 8) | font[table + 3]
+        table += 4
+        if last == 0xFFFF:
+            break
+    first_offset = (font[unicode_pos] << 8) | font[unicode_pos + 1]
+    pos = unicode_pos + first_offset
+
+    glyphs = {}
+    while True:
+        encoding = (font[pos] << 8) | font[pos + 1]
+        if encoding == 0:
+            break
+        size = font[pos + 2]
+        glyphs[encoding] = font[pos:pos + size]
+        pos += size
+
+    wanted = [c for c in keep if c in glyphs]
+    missing = [c for c in keep if c not in glyphs]
+
+    groups = [wanted[i:i + GROUP_SIZE] for i in range(0, len(wanted), GROUP_SIZE)] or [[]]
+    lookup = bytearray()
+    previous = 4 * len(groups)  # 第一项的偏移是查找表本身的长度
+    for i, group in enumerate(groups):
+        last = 0xFFFF if i == len(groups) - 1 else group[-1]
+        lookup += bytes([previous >> 8, previous & 0xFF, last >> 8, last & 0xFF])
+        previous = sum(len(glyphs[c]) for c in group)
+
+    body = b"".join(glyphs[c] for group in groups for c in group)
+    out = font[:unicode_pos] + bytes(lookup) + body + b"\x00\x00"
+    return out, len(wanted), missing
+
+
+def emit(out_dir, subsets):
+    os.makedirs(out_dir, exist_ok=True)
+    with open(os.path.join(out_dir, "font_subset_gen.h"), "w") as h:
+        h.write("// 由 scripts/font_subset.py 生成，请勿手动修改\n")
+        h.write("#ifndef FONT_SUBSET_GEN_H\n#define FONT_SUBSET_GEN_H\n\n#include <stdint.h>\n\n")
+        for name, data in subsets:
+            h.write("extern const uint8_t %s[%d];\n" % (name, len(data)))
+        h.write("\n#endif\n")
+    with open(os.path.join(out_dir, "font_subset_gen.cpp"), "w") as c:
+        c.write("// 由 scripts/font_subset.py 生成，请勿手动修改\n")
+        c.write('#include "font_subset_gen.h"\n\n')
+        for name, data in subsets:
+            c.write("const uint8_t %s[%d] = {\n" % (name, len(data)))
+            for i in range(0, len(data), 16):
+                c.write("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+            c.write("};\n\n")
+
+
+def generate(fonts_c_path, out_dir, src_dir):
+    with open(fonts_c_path, encoding="latin-1") as f:
+        fonts_c = f.read()
+    keep = used_codepoints(src_dir)
+    print("字体子集: 源码中用到 %d 个非 ASCII 字符" % len(keep))
+
+    subsets = []
+    for name in FONTS:
+        font = read_font(fonts_c, name)
+        if font is None:
+            print("字体子集: 找不到 %s，跳过" % name)
+            return False
+        data, count, missing = subset_font(font, keep)
+        subset_name = name.replace("_gb2312", "_subset")
+        subsets.append((subset_name, data))
+        print("字体子集: %s %d -> %d 字节，节省 %d 字节 (%d 个字形)"
+              % (name, len(font), len(data), len(font) - len(data), count))
+        if missing:
+            print("字体子集: %s 中没有这些字符: %s" % (name, "".join(chr(c) for c in missing)))
+    emit(out_dir, subsets)
+    return True
+
+
+def run_pio(env):
+    project_dir = env.subst("$PROJECT_DIR")
+    fonts_c = os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"),
+                           "U8g2", "src", "clib", "u8g2_fonts.c")
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "font_subset")
+    if not os.path.exists(fonts_c):
+        print("字体子集: 找不到 %s，使用完整字体" % fonts_c)
+        return
+    if generate(fonts_c, out_dir, os.path.join(project_dir, "src")):
+        env.Append(CPPPATH=[out_dir])
+        env.BuildSources(os.path.join("$BUILD_DIR", "font_subset_obj"), out_dir)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+    src = sys.argv[3] if len(sys.argv) > 3 else os.path.join(os.path.dirname(__file__), "..", "src")
+    sys.exit(0 if generate(sys.argv[1], sys.argv[2], src) else 1)
+else:
+    Import("env")  # noqa: F821  (PlatformIO / SCons 注入)
+    run_pio(env)  # noqa: F821
@@ -0,0 +1,192 @@
+#include <Arduino.h>
+#include <esp_adc/adc_continuous.h>
+#include <soc/soc_caps.h>
+#include "AdcStream.h"
+
+/*
+数据流:
+    ADC1 (连续模式, 按 pattern 轮流转换各通道) --DMA--> 驱动内部缓冲
+        --> 转换完成回调唤醒采样任务 --> adc_continuous_read 取出一帧
+        --> 按通道累加 oversample 次求平均 --> Channel 环形缓冲
+        --> 各订阅者按自己的抽取系数直接读取环形缓冲中的样本块
+*/
+
+namespace AdcStream
+{
+    const int FRAME_SAMPLES = 64; // 每帧转换结果数
+    const int FRAME_BYTES = FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES;
+
+    Stream adcStream;
+    Stats stats = {};
+    adc_continuous_handle_t handle = NULL;
+    TaskHandle_t readerTask = NULL;
+
+    int pinOf[MAX_CHANNELS];          // 通道编号 -> 引脚
+    int8_t channelOf[SOC_ADC_MAX_CHANNEL_NUM]; // ADC1 硬件通道 -> 通道编号
+    uint32_t sums[MAX_CHANNELS];
+    int counts[MAX_CHANNELS];
+
+    // 转换完成 (在中断中执行): 只唤醒采样任务
+    bool IRAM_ATTR handle_conv_done(adc_continuous_handle_t h, const adc_continuous_evt_data_t *data, void *arg)
+    {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(readerTask, &woken);
+        return woken == pdTRUE;
+    }
+
+    bool IRAM_ATTR handle_overflow(adc_continuous_handle_t h, const adc_continuous_evt_data_t *data, void *arg)
+    {
+        stats.overflows++;
+        return false;
+    }
+
+    void readerLoop(void *arg)
+    {
+        static uint8_t frame[FRAME_BYTES];
+        for (;;)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            uint32_t len = 0;
+            while (adc_continuous_read(handle, frame, FRAME_BYTES, &len, 0) == ESP_OK)
+            {
+                stats.frames++;
+                for (uint32_t i = 0; i < len; i += SOC_ADC_DIGI_RESULT_BYTES)
+                {
+                    adc_digi_output_data_t *p = (adc_digi_output_data_t *)&frame[i];
+                    int hw = p->type1.channel;
+                    if (hw >= SOC_ADC_MAX_CHANNEL_NUM || channelOf[hw] < 0)
+                        continue;
+                    int ch = channelOf[hw];
+                    sums[ch] += p->type1.data;
+                    if (++counts[ch] >= stats.oversample)
+                    {
+                        adcStream.push(ch, sums[ch] / counts[ch]);
+                        stats.samples++;
+                        sums[ch] = 0;
+                        counts[ch] = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    // 撤销 begin() 中已完成的步骤 (驱动还没有启动)，handle 回到 NULL 后可以重新 begin()
+    void release()
+    {
+        if (readerTask != NULL)
+        {
+            vTaskDelete(readerTask);
+            readerTask = NULL;
+        }
+        if (handle != NULL)
+        {
+            adc_continuous_deinit(handle);
+            handle = NULL;
+        }
+        adcStream.reset();
+        for (int i = 0; i < SOC_ADC_MAX_CHANNEL_NUM; i++)
+            channelOf[i] = -1;
+    }
+
+    bool begin(const int *pins, int count, int rateHz)
+    {
+        if (handle != NULL || count <= 0 || count > MAX_CHANNELS || count > SOC_ADC_PATT_LEN_MAX)
+            return false;
+
+        // 先检查全部引脚和转换频率，失败时还没有创建任何资源
+        adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX] = {};
+        for (int i = 0; i < count; i++)
+        {
+            adc_unit_t unit;
+            adc_channel_t channel;
+            if (adc_continuous_io_to_channel(pins[i], &unit, &channel) != ESP_OK || unit != ADC_UNIT_1)
+            {
+                Serial.printf("AdcStream: GPIO%d 不是 ADC1 引脚\n", pins[i]);
+                return false;
+            }
+            pattern[i].atten = ADC_ATTEN_DB_12; // 与 analogRead 默认量程一致 (0 - 3.3V)
+            pattern[i].channel = channel;
+            pattern[i].unit = ADC_UNIT_1;
+            pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        }
+
+        // 转换频率不能低于硬件下限，多出来的转换做过采样平均
+        int base = rateHz * count;
+        stats.oversample = (SOC_ADC_SAMPLE_FREQ_THRES_LOW + base - 1) / base;
+        if (stats.oversample < 1)
+            stats.oversample = 1;
+        stats.hardwareHz = base * stats.oversample;
+        if (stats.hardwareHz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)
+            return false;
+
+        adc_continuous_handle_cfg_t handleCfg = {};
+        handleCfg.max_store_buf_size = FRAME_BYTES * 4;
+        handleCfg.conv_frame_size = FRAME_BYTES;
+        if (adc_continuous_new_handle(&handleCfg, &handle) != ESP_OK)
+        {
+            handle = NULL;
+            return false;
+        }
+
+        adc_continuous_config_t cfg = {};
+        cfg.pattern_num = count;
+        cfg.adc_pattern = pattern;
+        cfg.sample_freq_hz = stats.hardwareHz;
+        cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+        if (adc_continuous_config(handle, &cfg) != ESP_OK)
+        {
+            release();
+            return false;
+        }
+
+        for (int i = 0; i < SOC_ADC_MAX_CHANNEL_NUM; i++)
+            channelOf[i] = -1;
+        for (int i = 0; i < count; i++)
+        {
+            int ch = adcStream.addChannel();
+            pinOf[ch] = pins[i];
+            channelOf[pattern[i].channel] = ch;
+            sums[ch] = 0;
+            counts[ch] = 0;
+        }
+
+        if (xTaskCreatePinnedToCore(readerLoop, "adc_stream", 3072, NULL, 5, &readerTask, 0) != pdPASS)
+        {
+            readerTask = NULL;
+            release();
+            return false;
+        }
+
+        adc_continuous_evt_cbs_t cbs = {};
+        cbs.on_conv_done = handle_conv_done;
+        cbs.on_pool_ovf = handle_overflow;
+        if (adc_continuous_register_event_callbacks(handle, &cbs, NULL) != ESP_OK ||
+            adc_continuous_start(handle) != ESP_OK)
+        {
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    Subscriber *subscribe(int pin, int decimation)
+    {
+        for (int ch = 0; ch < adcStream.channels(); ch++)
+        {
+            if (pinOf[ch] == pin)
+                return adcStream.subscribe(ch, decimation);
+        }
+        return nullptr;
+    }
+
+    Stream &stream()
+    {
+        return adcStream;
+    }
+
+    const Stats &getStats()
+    {
+        return stats;
+    }
+} // namespace AdcStream
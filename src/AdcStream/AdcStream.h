@@ -0,0 +1,258 @@
+#ifndef ADC_STREAM_H
+#define ADC_STREAM_H
+
+#include <stdint.h>
+#include <math.h>
+#include <atomic>
+
+namespace AdcStream
+{
+    const int MAX_CHANNELS = 8;     // ADC1 最多 8 个通道 (GPIO32 - 39)
+    const int MAX_SUBSCRIBERS = 8;
+    const int RING_LEN = 256;       // 每个通道保留的样本数 (2 的幂)
+    // 订阅者落后超过该样本数时跳到最新数据，保证交出的样本块在处理期间不会被覆盖
+    const int MAX_LAG = RING_LEN / 2;
+
+    static_assert((RING_LEN & (RING_LEN - 1)) == 0, "RING_LEN 必须是 2 的幂");
+
+    // 一段连续样本，直接指向通道的环形缓冲 (不复制); 抽取时每隔 stride 个取一个
+    struct Block
+    {
+        const uint16_t *data;
+        int count;
+        int stride;
+
+        uint16_t at(int i) const { return data[i * stride]; }
+        uint16_t last() const { return at(count - 1); }
+
+        int mean() const
+        {
+            uint32_t sum = 0;
+            for (int i = 0; i < count; i++)
+                sum += at(i);
+            return count ? sum / count : 0;
+        }
+    };
+
+    // 单个通道: 一个写者 (采样任务)，每个订阅者各自维护读位置
+    struct Channel
+    {
+        uint16_t data[RING_LEN];
+        std::atomic<uint32_t> head{0}; // 累计写入的样本数
+
+        void push(uint16_t v)
+        {
+            uint32_t h = head.load(std::memory_order_relaxed);
+            data[h & (RING_LEN - 1)] = v;
+            head.store(h + 1, std::memory_order_release);
+        }
+    };
+
+    // 一个通道的订阅: 按自己的抽取系数读取样本块
+    class Subscriber
+    {
+    public:
+        // 取出下一段连续的样本 (在环形缓冲回绕处分段); 没有新样本返回 false
+        // 样本块在处理期间有效，处理时间不要超过 MAX_LAG 个样本的采样时间
+        bool read(Block *block)
+        {
+            uint32_t head = channel->head.load(std::memory_order_acquire);
+            int32_t lag = (int32_t)(head - cursor);
+            if (lag <= 0)
+                return false;
+            if (lag > MAX_LAG)
+            {
+                // 跳过太旧的样本，保持抽取相位
+                uint32_t skip = (lag - MAX_LAG + decimation - 1) / decimation * decimation;
+                cursor += skip;
+                lost += skip / decimation;
+                lag -= skip;
+                if (lag <= 0)
+                    return false;
+            }
+            uint32_t start = cursor & (RING_LEN - 1);
+            uint32_t contiguous = RING_LEN - start;
+            if ((uint32_t)lag < contiguous)
+                contiguous = lag;
+            int count = (contiguous + decimation - 1) / decimation;
+
+            block->data = channel->data + start;
+            block->count = count;
+            block->stride = decimation;
+            cursor += count * decimation;
+            return true;
+        }
+
+        // 读出所有新样本: mean 为 true 时返回平均值，否则返回最新值; 没有新样本时返回 fallback
+        int latest(int fallback, bool mean = false)
+        {
+            Block b;
+            uint32_t sum = 0;
+            int n = 0;
+            int value = fallback;
+            while (read(&b))
+            {
+                value = b.last();
+                if (mean)
+                {
+                    for (int i = 0; i < b.count; i++)
+                        sum += b.at(i);
+                    n += b.count;
+                }
+            }
+            return mean && n > 0 ? sum / n : value;
+        }
+
+        uint32_t lostSamples() const { return lost; }
+
+    private:
+        friend class Stream;
+        Channel *channel = nullptr;
+        int decimation = 1;
+        uint32_t cursor = 0;
+        uint32_t lost = 0;
+    };
+
+    // 通道和订阅的集合; 写入端 push() 由采样任务 (板上) 或 Synth (主机) 调用
+    class Stream
+    {
+    public:
+        // 返回通道编号，已满时返回 -1
+        int addChannel()
+        {
+            return channelCount < MAX_CHANNELS ? channelCount++ : -1;
+        }
+
+        // decimation: 每 decimation 个样本交出一个; 从订阅时刻之后的样本开始
+        Subscriber *subscribe(int channel, int decimation = 1)
+        {
+            if (channel < 0 || channel >= channelCount || subscriberCount >= MAX_SUBSCRIBERS)
+                return nullptr;
+            Subscriber &s = subscribers[subscriberCount++];
+            s.channel = &rings[channel];
+            s.decimation = decimation < 1 ? 1 : decimation;
+            s.cursor = rings[channel].head.load(std::memory_order_acquire);
+            s.lost = 0;
+            return &s;
+        }
+
+        void push(int channel, uint16_t value) { rings[channel].push(value); }
+
+        // 清空通道和订阅，只在没有写入端时调用 (例如驱动初始化失败后)
+        void reset()
+        {
+            for (int i = 0; i < MAX_CHANNELS; i++)
+                rings[i].head.store(0, std::memory_order_relaxed);
+            channelCount = 0;
+            subscriberCount = 0;
+        }
+
+        uint32_t written(int channel) const { return rings[channel].head.load(std::memory_order_acquire); }
+        int channels() const { return channelCount; }
+
+    private:
+        Channel rings[MAX_CHANNELS];
+        Subscriber subscribers[MAX_SUBSCRIBERS];
+        int channelCount = 0;
+        int subscriberCount = 0;
+    };
+
+    // 主机端的合成信号源: 按采样率把波形写入 Stream，代替 ADC
+    struct Wave
+    {
+        enum Shape
+        {
+            SINE,
+            SQUARE,
+            TRIANGLE,
+            NOISE
+        };
+        Shape shape;
+        float offset;    // 中心值 (ADC 计数)
+        float amplitude; // 峰值幅度
+        float hz;        // 频率 (NOISE 忽略)
+    };
+
+    class Synth
+    {
+    public:
+        Synth(Stream &stream, int rateHz) : stream(stream), rate(rateHz) {}
+
+        // 添加一个通道，返回通道编号
+        int add(const Wave &wave)
+        {
+            int ch = stream.addChannel();
+            if (ch >= 0)
+                waves[ch] = wave;
+            return ch;
+        }
+
+        // 写入到 nowUs 为止应产生的样本
+        void pump(uint64_t nowUs)
+        {
+            uint64_t due = nowUs * rate / 1000000;
+            for (; produced < due; produced++)
+            {
+                double t = (double)produced / rate;
+                for (int ch = 0; ch < stream.channels(); ch++)
+                    stream.push(ch, sample(waves[ch], t));
+            }
+        }
+
+    private:
+        uint16_t sample(const Wave &w, double t)
+        {
+            const float PI_F = 3.14159265f;
+            float phase = (float)(w.hz * t - floor(w.hz * t));
+            float v;
+            switch (w.shape)
+            {
+            case Wave::SQUARE:
+                v = phase < 0.5f ? 1 : -1;
+                break;
+            case Wave::TRIANGLE:
+                v = phase < 0.5f ? 4 * phase - 1 : 3 - 4 * phase;
+                break;
+            case Wave::NOISE:
+                seed = seed * 1664525u + 1013904223u;
+                v = (seed >> 8) / 8388608.0f - 1;
+                break;
+            default:
+                v = sinf(2 * PI_F * phase);
+                break;
+            }
+            float x = w.offset + w.amplitude * v;
+            return x < 0 ? 0 : x > 4095 ? 4095 : (uint16_t)x;
+        }
+
+        Stream &stream;
+        int rate;
+        Wave waves[MAX_CHANNELS] = {};
+        uint64_t produced = 0;
+        uint32_t seed = 1;
+    };
+
+    // ---- 板上驱动 (AdcStream.cpp，ESP32 连续模式 ADC + DMA) ----
+
+    struct Stats
+    {
+        uint32_t frames;    // DMA 转换帧数
+        uint32_t samples;   // 写入各通道的样本总数 (过采样平均之后)
+        uint32_t overflows; // 驱动内部缓冲溢出次数 (采样任务来不及读取)
+        int hardwareHz;     // 实际的 ADC 转换频率 (所有通道合计)
+        int oversample;     // 每个输出样本平均的转换次数
+    };
+
+    // 按 rateHz (每个通道) 连续采样 pins 列表; 引脚必须属于 ADC1 (GPIO32 - 39)
+    // ESP32 连续模式的转换频率下限为 20kHz，多出的转换用于过采样平均
+    // 失败时释放已创建的驱动资源，可以改正参数后再次调用
+    bool begin(const int *pins, int count, int rateHz);
+
+    // 按引脚订阅，未在 begin 中配置时返回 nullptr
+    Subscriber *subscribe(int pin, int decimation = 1);
+
+    Stream &stream();
+    const Stats &getStats();
+} // namespace AdcStream
+
+#endif
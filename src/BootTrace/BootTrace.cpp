@@ -0,0 +1,51 @@
+#include <Arduino.h>
+#include <string.h>
+#include "BootTrace.h"
+
+namespace BootTrace
+{
+    Mark marks[MAX_MARKS];
+    int count = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    int find(const char *name)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (strcmp(marks[i].name, name) == 0)
+                return i;
+        }
+        return -1;
+    }
+
+    void mark(const char *name)
+    {
+        uint32_t now = micros();
+        portENTER_CRITICAL(&mux);
+        if (count < MAX_MARKS && find(name) < 0)
+        {
+            marks[count].name = name;
+            marks[count].us = now;
+            count++;
+        }
+        portEXIT_CRITICAL(&mux);
+    }
+
+    uint32_t get(const char *name)
+    {
+        portENTER_CRITICAL(&mux);
+        int i = find(name);
+        uint32_t us = i >= 0 ? marks[i].us : 0;
+        portEXIT_CRITICAL(&mux);
+        return us;
+    }
+
+    void dump(Print &out)
+    {
+        out.println("--- 启动阶段耗时 ---");
+        for (int i = 0; i < count; i++)
+        {
+            out.printf("%-12s %8.1f ms\n", marks[i].name, marks[i].us / 1000.0);
+        }
+    }
+} // namespace BootTrace
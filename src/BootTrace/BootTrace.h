@@ -0,0 +1,28 @@
+#ifndef BOOT_TRACE_H
+#define BOOT_TRACE_H
+
+#include <stdint.h>
+
+class Print;
+
+namespace BootTrace
+{
+    const int MAX_MARKS = 12;
+
+    struct Mark
+    {
+        const char *name; // 阶段名称 (需为字符串常量)
+        uint32_t us;      // 距上电的时间 (micros)
+    };
+
+    // 记录一个启动阶段的时间点，重复的名称只记录第一次
+    void mark(const char *name);
+
+    // 查询某阶段的时间点 (us)，未到达时返回 0
+    uint32_t get(const char *name);
+
+    // 打印所有已记录的阶段
+    void dump(Print &out);
+} // namespace BootTrace
+
+#endif
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "Button.h"
+#include "../Gesture/Gesture.h"
 
 /*
 电路图:
@@ -19,25 +20,38 @@ namespace Button {
     // LED 初始状态为关闭
     int led_logic = LOW;
 
-    // LED 当前状态
-    bool status = false;
+    // 手势引擎中的按键编号
+    int button = -1;
 
     void init() {
         // 设定引脚为输出模式
         pinMode(LED_PIN, OUTPUT);
-        pinMode(BUTTON_PIN, INPUT_PULLDOWN);
+        // 按下为高电平 (内部下拉)，边沿由中断记录
+        button = Gesture::attach(BUTTON_PIN, false);
     }
 
+    // 单击翻转 LED，长按熄灭，其余手势打印到串口; 不再阻塞消抖
     void update() {
-        if (digitalRead(BUTTON_PIN) == HIGH) {
-            delay(100); // 消抖延时
-            if (digitalRead(BUTTON_PIN) == HIGH && !status) {
+        Gesture::Event e;
+        while (Gesture::poll(button, &e)) {
+            switch (e.type) {
+            case Gesture::CLICK:
                 led_logic = !led_logic;
                 digitalWrite(LED_PIN, led_logic);
-                status = true;
+                Serial.println("单击");
+                break;
+            case Gesture::DOUBLE_CLICK:
+                Serial.println("双击");
+                break;
+            case Gesture::LONG_PRESS:
+                led_logic = LOW;
+                digitalWrite(LED_PIN, led_logic);
+                Serial.println("长按");
+                break;
+            case Gesture::HOLD_REPEAT:
+                Serial.printf("按住 %u\n", e.repeat);
+                break;
             }
-        } else {
-            status = false;
         }
     }
-} // namespace Button
\ No newline at end of file
+} // namespace Button
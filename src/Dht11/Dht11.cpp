@@ -0,0 +1,103 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "Dht11.h"
+
+/*
+DHT11 单总线时序:
+    主机拉低 >= 18ms --> 释放 (上拉) --> 传感器拉低 80us / 拉高 80us 应答
+    --> 40 位数据: 每位 50us 低电平 + 26~28us (0) 或 70us (1) 高电平
+只在下降沿打时间戳，相邻下降沿的间隔就能区分 0 和 1。
+*/
+
+namespace Dht11
+{
+    const uint32_t START_LOW_MS = 20; // 起始信号拉低时间
+    const uint32_t CAPTURE_MS = 10;   // 应答约 4.2ms，留足余量
+    const uint32_t MIN_INTERVAL_MS = 1000;
+
+    portMUX_TYPE cacheMux = portMUX_INITIALIZER_UNLOCKED;
+
+    void Sensor::begin(int dataPin, uint32_t intervalMs)
+    {
+        pin = dataPin;
+        interval = intervalMs < MIN_INTERVAL_MS ? MIN_INTERVAL_MS : intervalMs;
+        phase = START;
+        pinMode(pin, INPUT_PULLUP);
+
+        esp_timer_create_args_t args = {};
+        args.callback = handleTimer;
+        args.arg = this;
+        args.name = "dht11";
+        esp_timer_create(&args, &timer);
+
+        // 上电后传感器需要 1 秒稳定时间
+        esp_timer_start_once(timer, MIN_INTERVAL_MS * 1000);
+    }
+
+    Reading Sensor::read()
+    {
+        portENTER_CRITICAL(&cacheMux);
+        Reading r = cache;
+        portEXIT_CRITICAL(&cacheMux);
+        return r;
+    }
+
+    void Sensor::handleTimer(void *arg)
+    {
+        static_cast<Sensor *>(arg)->step();
+    }
+
+    void IRAM_ATTR Sensor::handleEdge(void *arg)
+    {
+        static_cast<Sensor *>(arg)->decoder.onFall(micros());
+    }
+
+    // 状态机，运行在 esp_timer 任务中
+    void Sensor::step()
+    {
+        switch (phase)
+        {
+        case START:
+            pinMode(pin, OUTPUT);
+            digitalWrite(pin, LOW);
+            phase = CAPTURE;
+            esp_timer_start_once(timer, START_LOW_MS * 1000);
+            break;
+
+        case CAPTURE:
+            decoder.reset();
+            pinMode(pin, INPUT_PULLUP);
+            attachInterruptArg(pin, handleEdge, this, FALLING);
+            phase = DECODE;
+            esp_timer_start_once(timer, CAPTURE_MS * 1000);
+            break;
+
+        case DECODE:
+        {
+            detachInterrupt(pin);
+
+            uint8_t bytes[5];
+            Status status = decoder.decode(bytes);
+
+            portENTER_CRITICAL(&cacheMux);
+            cache.status = status;
+            if (status == OK)
+            {
+                cache.humidity = Decoder::toHumidity(bytes);
+                cache.temperature = Decoder::toTemperature(bytes);
+                cache.valid = true;
+                cache.timestamp = millis();
+            }
+            else
+            {
+                cache.failures++;
+            }
+            portEXIT_CRITICAL(&cacheMux);
+
+            phase = START;
+            esp_timer_start_once(timer, (interval - START_LOW_MS - CAPTURE_MS) * 1000);
+            break;
+        }
+        }
+    }
+} // namespace Dht11
@@ -0,0 +1,142 @@
+#ifndef DHT11_H
+#define DHT11_H
+
+#include <stdint.h>
+
+struct esp_timer;
+
+namespace Dht11
+{
+    // 一次完整应答的下降沿数量: 应答低电平 1 个 + 起始位 1 个 + 40 个数据位
+    const int EDGE_COUNT = 42;
+
+    // 相邻两个下降沿的间隔: 数据 0 约 78us (50 + 28)，数据 1 约 120us (50 + 70)
+    const uint32_t BIT_THRESHOLD_US = 100;
+
+    enum Status
+    {
+        OK,        // 读取成功
+        TIMEOUT,   // 边沿数量不够 (传感器无应答或接线问题)
+        BAD_PULSE, // 边沿间隔不合理
+        CHECKSUM   // 校验和错误
+    };
+
+    // 缓存的读数
+    struct Reading
+    {
+        float temperature;     // 最近一次成功读取的温度 (°C)
+        float humidity;        // 最近一次成功读取的湿度 (%)
+        bool valid;            // 是否至少成功读取过一次
+        Status status;         // 最近一次读取的结果
+        uint32_t timestamp;    // 最近一次成功读取的时间 (millis)
+        uint32_t failures;     // 累计失败次数
+    };
+
+    // 40 位数据解码器
+    // 输入为下降沿时间戳 (us)，不依赖 Arduino，可以在主机上用录制的脉冲序列验证。
+    class Decoder
+    {
+    public:
+        void reset()
+        {
+            head = 0;
+            count = 0;
+        }
+
+        // 下降沿中断中调用; 环形保存最近 MAX_EDGES 个，毛刺再多也不会挤掉最后的数据位
+        // 强制内联，展开在板上的 IRAM 中断函数中，不会跳到 flash
+        __attribute__((always_inline)) inline void onFall(uint32_t nowUs)
+        {
+            edges[head] = nowUs;
+            head = head + 1 == MAX_EDGES ? 0 : head + 1;
+            count++;
+        }
+
+        // 收到的下降沿总数 (包括已被覆盖的)
+        int edgeCount() const { return count; }
+
+        // 解码成功时写入 bytes[5] (湿度整数, 湿度小数, 温度整数, 温度小数, 校验和)
+        Status decode(uint8_t *bytes) const
+        {
+            if (count < EDGE_COUNT - 1)
+                return TIMEOUT;
+
+            // 只取最后 41 个下降沿 (起始位 + 40 位)，前面多出来的毛刺直接忽略
+            int first = head - (EDGE_COUNT - 1);
+            if (first < 0)
+                first += MAX_EDGES;
+            for (int i = 0; i < 5; i++)
+                bytes[i] = 0;
+            for (int bit = 0; bit < 40; bit++)
+            {
+                uint32_t width = edge(first + bit + 1) - edge(first + bit);
+                if (width < 60 || width > 160)
+                    return BAD_PULSE;
+                bytes[bit / 8] <<= 1;
+                if (width > BIT_THRESHOLD_US)
+                    bytes[bit / 8] |= 1;
+            }
+
+            uint8_t sum = bytes[0] + bytes[1] + bytes[2] + bytes[3];
+            if (sum != bytes[4])
+                return CHECKSUM;
+            return OK;
+        }
+
+        // 由 5 字节数据计算温湿度
+        static float toHumidity(const uint8_t *bytes)
+        {
+            return bytes[0] + bytes[1] * 0.1f;
+        }
+
+        static float toTemperature(const uint8_t *bytes)
+        {
+            // 部分 DHT11 用温度小数字节的最高位表示负数
+            float t = bytes[2] + (bytes[3] & 0x7F) * 0.1f;
+            return (bytes[3] & 0x80) ? -t : t;
+        }
+
+    private:
+        static const int MAX_EDGES = EDGE_COUNT + 4;
+
+        uint32_t edge(int i) const { return edges[i >= MAX_EDGES ? i - MAX_EDGES : i]; }
+
+        volatile uint32_t edges[MAX_EDGES];
+        volatile int head = 0; // 下一个写入位置
+        volatile int count = 0;
+    };
+
+    // 后台读取 DHT11
+    // esp_timer 驱动整个事务: 拉低 20ms 起始信号 -> 释放总线并在中断中记录下降沿
+    // -> 解码并更新缓存。整个过程不关中断，也不占用 loop()。
+    class Sensor
+    {
+    public:
+        // intervalMs: 读取周期，DHT11 最快 1 秒一次
+        void begin(int pin, uint32_t intervalMs = 2000);
+
+        // 读取缓存结果，立即返回
+        Reading read();
+
+    private:
+        enum Phase
+        {
+            START,   // 拉低总线发送起始信号
+            CAPTURE, // 释放总线，记录应答边沿
+            DECODE   // 解码
+        };
+
+        static void handleTimer(void *arg);
+        static void handleEdge(void *arg);
+        void step();
+
+        int pin = -1;
+        uint32_t interval = 2000;
+        Phase phase = START;
+        Decoder decoder;
+        Reading cache = {0, 0, false, TIMEOUT, 0, 0};
+        esp_timer *timer = nullptr;
+    };
+} // namespace Dht11
+
+#endif
@@ -0,0 +1,53 @@
+#include <Arduino.h>
+#include "Dsp.h"
+
+namespace Dsp
+{
+    const int BENCH_BLOCK = 64;   // 块大小 (32 - 128 之间)
+    const int BENCH_ROUNDS = 200; // 每种方式处理的块数
+
+    void benchmark(Print &out)
+    {
+        static float input[BENCH_BLOCK], output[BENCH_BLOCK];
+        static int16_t inputQ[BENCH_BLOCK], outputQ[BENCH_BLOCK];
+        for (int i = 0; i < BENCH_BLOCK; i++)
+        {
+            input[i] = 600 * sinf(2 * 3.14159265f * 1.2f * i / 100);
+            inputQ[i] = (int16_t)(input[i] * 4); // 留 2 位余量
+        }
+        Coeffs hp = highPass(100, 0.5f);
+        Coeffs lp = lowPass(100, 5);
+
+        // 逐样本 float (原来 HeartBratTest 的处理方式)
+        Biquad a(hp), b(lp);
+        uint32_t start = ESP.getCycleCount();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            for (int i = 0; i < BENCH_BLOCK; i++)
+                output[i] = b.step(a.step(input[i]));
+        uint32_t perSample = ESP.getCycleCount() - start;
+
+        // 块 float (ESP-DSP 内核)
+        Biquad c(hp), d(lp);
+        Chain chain;
+        chain.add(c);
+        chain.add(d);
+        start = ESP.getCycleCount();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            chain.process(input, output, BENCH_BLOCK);
+        uint32_t block = ESP.getCycleCount() - start;
+
+        // 块 Q15
+        BiquadQ15 e(hp), f(lp);
+        start = ESP.getCycleCount();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+        {
+            e.process(inputQ, outputQ, BENCH_BLOCK);
+            f.process(outputQ, outputQ, BENCH_BLOCK);
+        }
+        uint32_t blockQ = ESP.getCycleCount() - start;
+
+        float samples = BENCH_ROUNDS * BENCH_BLOCK;
+        out.printf("DSP 两级双二阶，每样本周期数: 逐样本 float %.1f, 块 float %.1f (%s), 块 Q15 %.1f\n",
+                   perSample / samples, block / samples, DSP_USE_ESP_DSP ? "ESP-DSP" : "参考实现", blockQ / samples);
+    }
+} // namespace Dsp
@@ -0,0 +1,318 @@
+#ifndef DSP_H
+#define DSP_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+// 板上使用 ESP-DSP 的汇编内核 (ESP32 上 dsps_biquad_f32 / dsps_fir_f32 即 *_ae32 版本)，
+// 主机或没有 ESP-DSP 时使用下面的参考实现，两者的计算顺序一致。
+#if defined(ESP_PLATFORM) && __has_include("esp_dsp.h")
+#include "esp_dsp.h"
+#define DSP_USE_ESP_DSP 1
+#else
+#define DSP_USE_ESP_DSP 0
+#endif
+
+class Print;
+
+namespace Dsp
+{
+    const int MAX_BLOCK = 128; // 单次处理的最大样本数
+    const int MAX_STAGES = 6;  // 一条滤波链的最大级数
+    const int MAX_TAPS = 32;   // FIR 最大阶数
+
+    // 双二阶系数，顺序与 ESP-DSP 一致: b0 b1 b2 a1 a2 (a0 归一化为 1)
+    struct Coeffs
+    {
+        float c[5];
+    };
+
+    // RBJ Audio EQ Cookbook 设计的二阶低通 / 高通
+    inline Coeffs design(float fs, float f0, float q, bool high)
+    {
+        const float PI_F = 3.14159265f;
+        float w0 = 2 * PI_F * f0 / fs;
+        float cw = cosf(w0);
+        float alpha = sinf(w0) / (2 * q);
+        float a0 = 1 + alpha;
+        float edge = (high ? 1 + cw : 1 - cw) / 2;
+        Coeffs k = {{edge / a0, (high ? -(1 + cw) : 1 - cw) / a0, edge / a0, -2 * cw / a0, (1 - alpha) / a0}};
+        return k;
+    }
+
+    inline Coeffs lowPass(float fs, float f0, float q = 0.7071f) { return design(fs, f0, q, false); }
+    inline Coeffs highPass(float fs, float f0, float q = 0.7071f) { return design(fs, f0, q, true); }
+
+    // 参考内核: 与 dsps_biquad_f32 相同的直接 II 型，w[2] 为状态
+    inline void biquadRef(const float *in, float *out, int len, const float *coef, float *w)
+    {
+        for (int i = 0; i < len; i++)
+        {
+            float d0 = in[i] - coef[3] * w[0] - coef[4] * w[1];
+            out[i] = coef[0] * d0 + coef[1] * w[0] + coef[2] * w[1];
+            w[1] = w[0];
+            w[0] = d0;
+        }
+    }
+
+    // 参考内核: y[n] = sum(h[k] * x[n - k])，delay 为环形延迟线
+    inline void firRef(const float *in, float *out, int len, const float *taps, float *delay, int n, int *pos)
+    {
+        for (int i = 0; i < len; i++)
+        {
+            delay[*pos] = in[i];
+            float acc = 0;
+            int p = *pos;
+            for (int k = 0; k < n; k++)
+            {
+                acc += taps[k] * delay[p];
+                p = p == 0 ? n - 1 : p - 1;
+            }
+            out[i] = acc;
+            *pos = *pos + 1 == n ? 0 : *pos + 1;
+        }
+    }
+
+    // 滤波链中的一级; in 与 out 可以是同一块内存
+    class Stage
+    {
+    public:
+        virtual ~Stage() {}
+        virtual void process(const float *in, float *out, int len) = 0;
+
+        // 以 x 作为稳态输入预置状态，返回稳态输出 (避免上电时的大阶跃)
+        virtual float settle(float x) = 0;
+    };
+
+    class Biquad : public Stage
+    {
+    public:
+        explicit Biquad(const Coeffs &k) { memcpy(coef, k.c, sizeof(coef)); }
+
+        // 逐样本处理 (不经过块内核)
+        float step(float x)
+        {
+            float d0 = x - coef[3] * w[0] - coef[4] * w[1];
+            float y = coef[0] * d0 + coef[1] * w[0] + coef[2] * w[1];
+            w[1] = w[0];
+            w[0] = d0;
+            return y;
+        }
+
+        void process(const float *in, float *out, int len) override
+        {
+#if DSP_USE_ESP_DSP
+            dsps_biquad_f32(in, out, len, coef, w);
+#else
+            biquadRef(in, out, len, coef, w);
+#endif
+        }
+
+        float settle(float x) override
+        {
+            float d = x / (1 + coef[3] + coef[4]);
+            w[0] = w[1] = d;
+            return d * (coef[0] + coef[1] + coef[2]);
+        }
+
+    private:
+        float coef[5];
+        float w[2] = {0, 0};
+    };
+
+    // 对称 (线性相位) FIR: h[k] == h[n - 1 - k]，所以系数顺序不影响结果。
+    // 板上的 fir_f32_t 保存指向自身 h / delay 的指针，不能复制
+    class Fir : public Stage
+    {
+    public:
+        Fir() {}
+        Fir(const Fir &) = delete;
+        Fir &operator=(const Fir &) = delete;
+
+        // 系数不对称、为空或超过 MAX_TAPS 时返回 false，滤波器保持未初始化 (输出 0)
+        bool init(const float *coeffs, int n)
+        {
+            taps = 0;
+            if (n <= 0 || n > MAX_TAPS)
+                return false;
+            float peak = 0;
+            for (int i = 0; i < n; i++)
+                peak = fmaxf(peak, fabsf(coeffs[i]));
+            for (int i = 0; i < n / 2; i++)
+            {
+                if (fabsf(coeffs[i] - coeffs[n - 1 - i]) > peak * 1e-6f)
+                    return false;
+            }
+            taps = n;
+            memcpy(h, coeffs, taps * sizeof(float));
+            memset(delay, 0, sizeof(delay));
+#if DSP_USE_ESP_DSP
+            dsps_fir_init_f32(&fir, h, delay, taps);
+#else
+            pos = 0;
+#endif
+            return true;
+        }
+
+        void process(const float *in, float *out, int len) override
+        {
+            if (taps == 0)
+            {
+                memset(out, 0, len * sizeof(float));
+                return;
+            }
+#if DSP_USE_ESP_DSP
+            dsps_fir_f32(&fir, in, out, len);
+#else
+            firRef(in, out, len, h, delay, taps, &pos);
+#endif
+        }
+
+        float settle(float x) override
+        {
+            float gain = 0;
+            for (int i = 0; i < taps; i++)
+            {
+                delay[i] = x;
+                gain += h[i];
+            }
+            return x * gain;
+        }
+
+    private:
+        float h[MAX_TAPS];
+        float delay[MAX_TAPS] = {};
+        int taps = 0;
+#if DSP_USE_ESP_DSP
+        fir_f32_t fir;
+#else
+        int pos = 0;
+#endif
+    };
+
+    // 按顺序串联的滤波级，逐块处理 (每块最多 MAX_BLOCK 个样本)
+    class Chain
+    {
+    public:
+        bool add(Stage &stage)
+        {
+            if (count >= MAX_STAGES)
+                return false;
+            stages[count++] = &stage;
+            return true;
+        }
+
+        // in 与 out 可以相同; len 超过 MAX_BLOCK 时分块处理
+        void process(const float *in, float *out, int len)
+        {
+            while (len > 0)
+            {
+                int n = len > MAX_BLOCK ? MAX_BLOCK : len;
+                const float *src = in;
+                for (int i = 0; i < count; i++)
+                {
+                    float *dst = i == count - 1 ? out : scratch[i & 1];
+                    stages[i]->process(src, dst, n);
+                    src = dst;
+                }
+                if (count == 0 && out != in)
+                    memcpy(out, in, n * sizeof(float));
+                in += n;
+                out += n;
+                len -= n;
+            }
+        }
+
+        void settle(float x)
+        {
+            for (int i = 0; i < count; i++)
+                x = stages[i]->settle(x);
+        }
+
+    private:
+        Stage *stages[MAX_STAGES];
+        int count = 0;
+        float scratch[2][MAX_BLOCK];
+    };
+
+    // ---- Q15 定点版本 (ESP-DSP 没有定点双二阶，板上和主机都使用这里的实现) ----
+
+    inline int16_t saturate16(int32_t v)
+    {
+        return v > 32767 ? 32767 : v < -32768 ? -32768 : (int16_t)v;
+    }
+
+    // 系数用 Q14 表示 (|a1| 可以接近 2)，样本为 Q15，直接 I 型避免中间状态溢出
+    // 32 位累加，输入需留 2 位余量 (例如 12 位 ADC 去掉直流后左移 2 位)
+    class BiquadQ15
+    {
+    public:
+        explicit BiquadQ15(const Coeffs &k)
+        {
+            for (int i = 0; i < 5; i++)
+                q[i] = (int16_t)lrintf(k.c[i] * 16384);
+        }
+
+        void process(const int16_t *in, int16_t *out, int len)
+        {
+            for (int i = 0; i < len; i++)
+            {
+                int32_t acc = (int32_t)q[0] * in[i] + (int32_t)q[1] * x1 + (int32_t)q[2] * x2 -
+                              (int32_t)q[3] * y1 - (int32_t)q[4] * y2 + err;
+                int16_t y = saturate16(acc >> 14);
+                err = acc & ((1 << 14) - 1); // 截掉的小数部分带入下一个样本 (误差反馈)
+                x2 = x1;
+                x1 = in[i];
+                y2 = y1;
+                y1 = y;
+                out[i] = y;
+            }
+        }
+
+    private:
+        int16_t q[5];
+        int16_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        int32_t err = 0;
+    };
+
+    class FirQ15
+    {
+    public:
+        FirQ15(const float *coeffs, int n)
+        {
+            taps = n > MAX_TAPS ? MAX_TAPS : n;
+            for (int i = 0; i < taps; i++)
+                h[i] = saturate16(lrintf(coeffs[i] * 32768));
+        }
+
+        void process(const int16_t *in, int16_t *out, int len)
+        {
+            for (int i = 0; i < len; i++)
+            {
+                delay[pos] = in[i];
+                int32_t acc = 0;
+                int p = pos;
+                for (int k = 0; k < taps; k++)
+                {
+                    acc += (int32_t)h[k] * delay[p];
+                    p = p == 0 ? taps - 1 : p - 1;
+                }
+                out[i] = saturate16((acc + (1 << 14)) >> 15);
+                pos = pos + 1 == taps ? 0 : pos + 1;
+            }
+        }
+
+    private:
+        int16_t h[MAX_TAPS];
+        int16_t delay[MAX_TAPS] = {};
+        int taps = 0;
+        int pos = 0;
+    };
+
+    // 板上基准测试 (Dsp.cpp): 两级双二阶 (0.5 - 5Hz 带通) 分别以逐样本 float、
+    // 块 float 和块 Q15 处理，打印每个样本的 CPU 周期数
+    void benchmark(Print &out);
+} // namespace Dsp
+
+#endif
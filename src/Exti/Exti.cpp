@@ -1,5 +1,8 @@
 #include <Arduino.h>
+#include <esp_cpu.h>
+#include <hal/gpio_ll.h>
 #include "Exti.h"
+#include "../GpioEvent/GpioEvent.h"
 
 /*
 电路图:
@@ -11,17 +14,70 @@
     |       GPIO14 |----------------| 按键 ------- 3.3V |
     |              |                | (内部上拉)        |
     +--------------+                +------------------+
+    GPIO26 不接线: 基准测试时由 LEDC 输出，自己触发中断
 */
 namespace Exti {
     int LED_PIN = 2;
     int BUTTON_PIN = 14;
+    int BENCH_PIN = 26;
 
-    // 使用 volatile 确保 ISR 和主循环可见性
-    volatile bool led_logic = false;
+    const int RING_LEN = 256; // 中断与主循环之间的边沿记录 (2 的幂)
+    const int BATCH = 32;     // 主循环每次取出的最大条数
 
-    // 中断服务函数
-    void IRAM_ATTR handle_interrupt() {
-        led_logic = !led_logic;
+    // 基准测试的边沿速率 (每秒边沿数，PWM 频率为其一半) 和每档持续时间
+    const int BENCH_RATES[] = {1000, 5000, 10000, 20000, 50000, 100000, 200000, 400000};
+    const uint32_t BENCH_MS = 200;
+
+    GpioEvent::Ring<GpioEvent::Record, RING_LEN> events;
+    bool led_logic = false;
+    uint32_t lastEdgeCycles = 0;
+    uint32_t reportedOverflows = 0;
+
+    // 中断服务函数: 只记录引脚、电平和周期计数，处理全部留给主循环
+    // 电平在进入中断后读取，抖动极快时可能已经是下一次跳变之后的值
+    void IRAM_ATTR handle_interrupt(void *arg) {
+        int pin = (int)(intptr_t)arg;
+        GpioEvent::Record r = {(uint8_t)pin, (uint8_t)gpio_ll_get_level(&GPIO, (gpio_num_t)pin),
+                               (uint32_t)esp_cpu_get_cycle_count()};
+        events.push(r);
+    }
+
+    void benchmark(Print &out) {
+        GpioEvent::Record batch[BATCH];
+        while (events.popBatch(batch, BATCH) > 0) {
+        }
+
+        int best = 0;
+        for (int rate : BENCH_RATES) {
+            // attachInterrupt 会打开引脚的输入使能，LEDC 输出的边沿同样触发中断
+            ledcAttach(BENCH_PIN, rate / 2, 8);
+            ledcWrite(BENCH_PIN, 128);
+            uint32_t dropsBefore = events.overflows();
+            uint32_t received = 0;
+            attachInterruptArg(BENCH_PIN, handle_interrupt, (void *)(intptr_t)BENCH_PIN, CHANGE);
+            uint32_t start = millis();
+            while (millis() - start < BENCH_MS) {
+                received += events.popBatch(batch, BATCH);
+            }
+            detachInterrupt(BENCH_PIN);
+            ledcDetach(BENCH_PIN);
+            int n;
+            while ((n = events.popBatch(batch, BATCH)) > 0) {
+                received += n;
+            }
+
+            // 中断来不及响应时硬件会合并边沿，所以除了队列丢弃还要比较收到的条数
+            uint32_t drops = events.overflows() - dropsBefore;
+            uint32_t expected = (uint32_t)rate * BENCH_MS / 1000;
+            out.printf("%6d 边沿/s: 收到 %lu (期望约 %lu)，队列丢弃 %lu\n", rate,
+                       (unsigned long)received, (unsigned long)expected, (unsigned long)drops);
+            if (drops > 0 || received < expected * 95 / 100) {
+                break;
+            }
+            best = rate;
+        }
+        out.printf("无丢失的最高持续边沿速率: %d 边沿/s\n", best);
+        reportedOverflows = events.overflows();
     }
 
     void init() {
@@ -29,14 +85,29 @@ namespace Exti {
         pinMode(LED_PIN, OUTPUT);
         pinMode(BUTTON_PIN, INPUT_PULLDOWN);
 
-        attachInterrupt(BUTTON_PIN, handle_interrupt, FALLING);
+        benchmark(Serial);
+        attachInterruptArg(BUTTON_PIN, handle_interrupt, (void *)(intptr_t)BUTTON_PIN, CHANGE);
     }
 
+    // 成批取出边沿: 每个下降沿翻转 LED (与原来的 FALLING 中断一致)，并打印与上一个边沿的间隔
     void update() {
-        if (led_logic) {
-            digitalWrite(LED_PIN, HIGH);
-        } else {
-            digitalWrite(LED_PIN, LOW);
+        GpioEvent::Record batch[BATCH];
+        int n;
+        while ((n = events.popBatch(batch, BATCH)) > 0) {
+            for (int i = 0; i < n; i++) {
+                const GpioEvent::Record &r = batch[i];
+                if (r.level == 0) {
+                    led_logic = !led_logic;
+                }
+                uint32_t us = (r.cycles - lastEdgeCycles) / getCpuFrequencyMhz();
+                lastEdgeCycles = r.cycles;
+                Serial.printf("GPIO%d -> %d，距上一个边沿 %lu us\n", r.pin, r.level, (unsigned long)us);
+            }
+        }
+        if (events.overflows() != reportedOverflows) {
+            reportedOverflows = events.overflows();
+            Serial.printf("边沿队列溢出，累计丢弃 %lu\n", (unsigned long)reportedOverflows);
         }
+        digitalWrite(LED_PIN, led_logic ? HIGH : LOW);
     }
-} // namespace Exti
\ No newline at end of file
+} // namespace Exti
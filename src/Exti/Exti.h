@@ -1,12 +1,17 @@
 #ifndef EXTI_H
 #define EXTI_H
 
+class Print;
+
 namespace Exti {
     // 初始化 setup 函数
     void init();
 
     // 更新 loop 函数
     void update();
+
+    // 用 LEDC 在 GPIO26 上产生逐档加快的边沿，打印不丢边沿的最高持续速率 (init 中调用)
+    void benchmark(Print &out);
 } // namespace Exti
 
-#endif
\ No newline at end of file
+#endif
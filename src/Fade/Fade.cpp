@@ -0,0 +1,113 @@
+#include <Arduino.h>
+#include "Fade.h"
+#include "../TimerWheel/TimerWheel.h"
+
+namespace Fade
+{
+    struct Channel
+    {
+        int pin;
+        Sequencer sequencer;
+        bool busy; // 有硬件渐变或保持定时器在进行，结束时会再通知任务
+    };
+
+    Channel channels[MAX_CHANNELS];
+    int channelCount = 0;
+    QueueHandle_t queue = nullptr; // 需要设置下一步的通道编号
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+    Stats stats = {};
+
+    // LEDC 渐变结束中断: 只通知任务，ledcFade 会等待信号量，不能在中断中调用
+    void ARDUINO_ISR_ATTR onFadeEnd(void *arg)
+    {
+        int ch = (int)(intptr_t)arg;
+        BaseType_t woken = pdFALSE;
+        xQueueSendFromISR(queue, &ch, &woken);
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+
+    // 保持结束 (TimerWheel 的 "timers" 任务中)
+    void onHoldEnd(void *arg)
+    {
+        int ch = (int)(intptr_t)arg;
+        xQueueSend(queue, &ch, 0);
+    }
+
+    // 设置通道的下一步: 跳变直接写入并继续，渐变交给硬件，保持交给 TimerWheel
+    void advance(int ch)
+    {
+        Channel &c = channels[ch];
+        for (;;)
+        {
+            Step step;
+            portENTER_CRITICAL(&mux);
+            bool more = c.sequencer.next(&step);
+            c.busy = more && !step.isJump();
+            portEXIT_CRITICAL(&mux);
+            if (!more)
+                return;
+
+            if (step.isJump())
+            {
+                ledcWrite(c.pin, step.to);
+                stats.jumps++;
+                continue;
+            }
+            stats.steps++;
+            if (step.isHold())
+                TimerWheel::start(step.ms, onHoldEnd, (void *)(intptr_t)ch);
+            else
+                ledcFadeWithInterruptArg(c.pin, step.from, step.to, step.ms, onFadeEnd, (void *)(intptr_t)ch);
+            return;
+        }
+    }
+
+    void fadeTask(void *)
+    {
+        int ch;
+        for (;;)
+        {
+            if (xQueueReceive(queue, &ch, portMAX_DELAY) == pdTRUE)
+                advance(ch);
+        }
+    }
+
+    int attach(int pin, uint32_t freq)
+    {
+        if (queue == nullptr)
+        {
+            queue = xQueueCreate(MAX_CHANNELS * 2, sizeof(int));
+            if (queue == nullptr)
+                return -1;
+            TimerWheel::begin();
+            xTaskCreate(fadeTask, "fade", 3072, NULL, 2, NULL);
+        }
+        if (channelCount >= MAX_CHANNELS || !ledcAttach(pin, freq, DUTY_BITS))
+            return -1;
+        Channel &c = channels[channelCount];
+        c.pin = pin;
+        c.busy = false;
+        ledcWrite(pin, 0);
+        return channelCount++;
+    }
+
+    void play(int channel, const Animation &animation)
+    {
+        if (channel < 0 || channel >= channelCount)
+            return;
+        Channel &c = channels[channel];
+        portENTER_CRITICAL(&mux);
+        c.sequencer.start(animation, c.sequencer.level());
+        bool idle = !c.busy;
+        c.busy = true;
+        portEXIT_CRITICAL(&mux);
+        if (idle)
+            xQueueSend(queue, &channel, 0);
+    }
+
+    const Stats &getStats()
+    {
+        return stats;
+    }
+} // namespace Fade
@@ -0,0 +1,211 @@
+#ifndef FADE_H
+#define FADE_H
+
+#include <stdint.h>
+
+namespace Fade
+{
+    const int DUTY_BITS = 13; // LEDC 分辨率，5kHz 下 ESP32 最多 13 位
+    const uint32_t MAX_DUTY = (1u << DUTY_BITS) - 1;
+    const float GAMMA = 2.8f;
+    const int SEGMENTS = 4; // 每个关键帧拆成几段硬件渐变来逼近伽马曲线
+
+    // ---- 编译期数学 (std::pow 不是 constexpr) ----
+
+    constexpr double constLn(double x)
+    {
+        // x = m * 2^k，m 在 [0.5, 1]，ln(m) = 2 atanh((m - 1) / (m + 1))
+        int k = 0;
+        while (x < 0.5)
+        {
+            x *= 2;
+            k++;
+        }
+        double z = (x - 1) / (x + 1), z2 = z * z, term = z, sum = 0;
+        for (int i = 1; i < 40; i += 2)
+        {
+            sum += term / i;
+            term *= z2;
+        }
+        return 2 * sum - k * 0.69314718055994531;
+    }
+
+    constexpr double constExp(double y)
+    {
+        // exp(y) = exp(y / 2^n) ^ (2^n)
+        int n = 0;
+        while (y < -0.5 || y > 0.5)
+        {
+            y /= 2;
+            n++;
+        }
+        double sum = 1, term = 1;
+        for (int i = 1; i < 20; i++)
+        {
+            term *= y / i;
+            sum += term;
+        }
+        while (n-- > 0)
+            sum *= sum;
+        return sum;
+    }
+
+    constexpr double constPow(double x, double g) { return x <= 0 ? 0 : constExp(g * constLn(x)); }
+
+    // 感知亮度 0 - 255 到 BITS 位占空比的伽马表，编译期生成
+    template <int BITS>
+    struct GammaTable
+    {
+        uint16_t duty[256];
+
+        constexpr GammaTable() : duty()
+        {
+            for (int i = 0; i < 256; i++)
+                duty[i] = (uint16_t)(constPow(i / 255.0, GAMMA) * ((1u << BITS) - 1) + 0.5);
+        }
+
+        constexpr uint16_t operator[](int level) const { return duty[level < 0 ? 0 : level > 255 ? 255 : level]; }
+    };
+
+    constexpr GammaTable<DUTY_BITS> GAMMA_TABLE{};
+    static_assert(GAMMA_TABLE[0] == 0 && GAMMA_TABLE[255] == MAX_DUTY, "伽马表端点错误");
+
+    // 关键帧: 用 ms 毫秒渐变到感知亮度 level; ms 为 0 表示立即跳变，level 不变表示保持
+    struct Key
+    {
+        uint8_t level;
+        uint16_t ms;
+    };
+
+    struct Animation
+    {
+        const Key *keys;
+        int count;
+        bool loop;
+    };
+
+    const Key BREATHE_KEYS[] = {{255, 2560}, {0, 2560}};
+    const Key BLINK_KEYS[] = {{255, 0}, {255, 250}, {0, 0}, {0, 250}};
+    const Key RAMP_KEYS[] = {{0, 0}, {255, 2000}};
+
+    const Animation BREATHE = {BREATHE_KEYS, 2, true};
+    const Animation BLINK = {BLINK_KEYS, 4, true};
+    const Animation RAMP = {RAMP_KEYS, 2, false};
+
+    // 交给硬件的一步: 在 ms 毫秒内把占空比从 from 线性渐变到 to
+    struct Step
+    {
+        uint32_t from;
+        uint32_t to;
+        uint16_t ms;
+
+        bool isJump() const { return ms == 0; }
+        bool isHold() const { return ms > 0 && from == to; } // 硬件渐变不会对零变化产生结束中断
+    };
+
+    // 关键帧序列 -> 硬件渐变步骤; 每个关键帧按感知亮度均分为 SEGMENTS 段，段内由 LEDC 线性渐变
+    // 不依赖 Arduino，主机上可以模拟硬件逐步执行并检查时间
+    class Sequencer
+    {
+    public:
+        // 从当前感知亮度 level 开始播放
+        void start(const Animation &a, uint8_t level)
+        {
+            anim = a;
+            key = 0;
+            segment = 0;
+            fromLevel = level;
+            current = GAMMA_TABLE[level];
+            idlePass = true;
+            done = a.count == 0;
+        }
+
+        // 取出下一步，动画结束返回 false
+        bool next(Step *s)
+        {
+            while (!done)
+            {
+                if (key == anim.count)
+                {
+                    // 整轮都是跳变时停止循环，避免空转
+                    if (!anim.loop || idlePass)
+                    {
+                        done = true;
+                        break;
+                    }
+                    key = 0;
+                    idlePass = true;
+                }
+
+                const Key &k = anim.keys[key];
+                if (k.ms == 0 || k.level == fromLevel)
+                {
+                    // 跳变或保持: 一步完成
+                    s->from = current;
+                    s->to = GAMMA_TABLE[k.level];
+                    s->ms = k.ms;
+                    finishKey(k);
+                    return true;
+                }
+
+                int part = segment + 1;
+                int level = fromLevel + (k.level - fromLevel) * part / SEGMENTS;
+                uint16_t ms = (uint32_t)k.ms * part / SEGMENTS - (uint32_t)k.ms * segment / SEGMENTS;
+                s->from = current;
+                s->to = GAMMA_TABLE[level];
+                s->ms = ms;
+                if (ms > 0)
+                    current = s->to; // 没有时间的段不改变 current，下一段从硬件实际所在的占空比开始
+                if (++segment == SEGMENTS)
+                    finishKey(k); // 最后一段至少 1ms，不会被跳过
+                if (ms == 0)
+                    continue; // 关键帧太短，这一段没有时间，直接并入下一段
+                idlePass = false;
+                return true;
+            }
+            return false;
+        }
+
+        bool isDone() const { return done; }
+        uint8_t level() const { return fromLevel; } // 最近完成的关键帧亮度
+
+    private:
+        void finishKey(const Key &k)
+        {
+            if (k.ms > 0)
+                idlePass = false;
+            fromLevel = k.level;
+            current = GAMMA_TABLE[k.level];
+            segment = 0;
+            key++;
+        }
+
+        Animation anim = {nullptr, 0, false};
+        int key = 0;
+        int segment = 0;
+        uint8_t fromLevel = 0;
+        uint32_t current = 0;
+        bool idlePass = true;
+        bool done = true;
+    };
+
+    // ---- 板上驱动 (Fade.cpp): LEDC 硬件渐变，结束中断通知 "fade" 任务设置下一步 ----
+
+    const int MAX_CHANNELS = 8;
+
+    struct Stats
+    {
+        uint32_t steps; // 交给硬件 (或保持定时器) 的步骤数
+        uint32_t jumps; // 直接写入的跳变
+    };
+
+    // 以 DUTY_BITS 位分辨率挂接引脚，返回通道编号 (失败返回 -1)
+    int attach(int pin, uint32_t freq = 5000);
+
+    // 播放动画; 正在渐变时从当前这一段结束处接上新动画
+    void play(int channel, const Animation &animation);
+
+    const Stats &getStats();
+} // namespace Fade
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef FONT_SUBSET_H
+#define FONT_SUBSET_H
+
+// 项目使用的中文字体
+// 编译前 scripts/font_subset.py 会扫描 src/ 中的字符串，生成只含用到汉字的子集字体
+// (font_subset_gen.h)。找不到 U8g2 库源码时不会生成，这里退回完整的 GB2312 字体。
+// 新增界面文字后重新编译即可，不需要手动维护字表。
+
+#if defined(__has_include) && __has_include("font_subset_gen.h")
+#include "font_subset_gen.h"
+#define FONT_WQY12 u8g2_font_wqy12_t_subset
+#define FONT_WQY16 u8g2_font_wqy16_t_subset
+#else
+#define FONT_WQY12 u8g2_font_wqy12_t_gb2312
+#define FONT_WQY16 u8g2_font_wqy16_t_gb2312
+#endif
+
+#endif
@@ -0,0 +1,44 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <hal/gpio_ll.h>
+#include "Gesture.h"
+
+namespace Gesture
+{
+    Engine gestures;
+    int pins[MAX_BUTTONS];
+    bool activeLows[MAX_BUTTONS];
+
+    // 每个边沿只记录时间戳和当前电平，消抖和识别都在 poll() 中完成
+    // 读电平和取时间都用 IRAM 中可用的函数，flash 写入期间中断仍然安全
+    void IRAM_ATTR onEdge(void *arg)
+    {
+        int id = (int)(intptr_t)arg;
+        bool high = gpio_ll_get_level(&GPIO, (gpio_num_t)pins[id]);
+        gestures.edge(id, high != activeLows[id], (uint32_t)esp_timer_get_time());
+    }
+
+    int attach(int pin, bool activeLow, bool doubleClick)
+    {
+        int id = gestures.add(doubleClick);
+        if (id < 0)
+            return -1;
+        pins[id] = pin;
+        activeLows[id] = activeLow;
+        pinMode(pin, activeLow ? INPUT_PULLUP : INPUT_PULLDOWN);
+        attachInterruptArg(pin, onEdge, (void *)(intptr_t)id, CHANGE);
+        return id;
+    }
+
+    // 时间在 update() 之前读取，之后到达的边沿由 Engine 按有符号时间差处理
+    bool poll(int button, Event *e)
+    {
+        gestures.update((uint32_t)esp_timer_get_time());
+        return gestures.poll(button, e);
+    }
+
+    Engine &engine()
+    {
+        return gestures;
+    }
+} // namespace Gesture
@@ -0,0 +1,230 @@
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdint.h>
+#include "../GpioEvent/GpioEvent.h"
+
+namespace Gesture
+{
+    const int MAX_BUTTONS = 8;
+    const int EDGE_QUEUE_LEN = 64;          // 中断写入的边沿数 (2 的幂)
+    const int EVENT_QUEUE_LEN = 8;          // 每个按键缓存的手势数
+    const uint32_t DEBOUNCE_US = 10000;     // 电平保持这么久不变才算稳定
+    const uint32_t DOUBLE_GAP_US = 300000;  // 松开后在该时间内再次按下算双击
+    const uint32_t LONG_PRESS_US = 700000;  // 长按时间
+    const uint32_t REPEAT_US = 150000;      // 长按之后按住不放的重复间隔
+
+    // 中断里记录的一个原始边沿 (未消抖)
+    struct Edge
+    {
+        uint8_t button;
+        bool pressed;
+        uint32_t atUs;
+    };
+
+    enum Type
+    {
+        CLICK,
+        DOUBLE_CLICK,
+        LONG_PRESS,  // 按住超过 LONG_PRESS_US，松开时不再产生 CLICK
+        HOLD_REPEAT  // 长按之后每 REPEAT_US 一次，repeat 为序号
+    };
+
+    struct Event
+    {
+        Type type;
+        uint16_t repeat;
+        uint32_t atUs; // 手势成立的时刻
+    };
+
+    // 边沿 -> 按时间戳消抖 -> 手势识别 -> 每个按键的事件队列
+    // 时间由调用方传入，不依赖 Arduino，主机上可以喂录制或合成的抖动边沿序列。
+    class Engine
+    {
+    public:
+        // 添加一个按键，返回编号; doubleClick 为 false 时松开立即产生 CLICK (不等双击间隔)
+        int add(bool doubleClick = true)
+        {
+            if (count >= MAX_BUTTONS)
+                return -1;
+            buttons[count] = Button();
+            buttons[count].doubleClick = doubleClick;
+            return count++;
+        }
+
+        // 中断中调用: 记录一个原始边沿
+        __attribute__((always_inline)) inline void edge(int button, bool pressed, uint32_t atUs)
+        {
+            Edge e = {(uint8_t)button, pressed, atUs};
+            edges.push(e);
+        }
+
+        // 取出所有边沿并推进各按键的计时
+        // 时间差都按有符号比较: 取时间之后中断又写入的边沿 (atUs 晚于 nowUs) 视为刚刚发生，等下一次 update 再确认
+        void update(uint32_t nowUs)
+        {
+            Edge e;
+            while (edges.pop(&e))
+            {
+                if (e.button >= count)
+                    continue;
+                Button &b = buttons[e.button];
+                settle(b, e.atUs); // 这个边沿之前保持的电平可能已经稳定
+                // 相同电平的重复边沿说明中间有过更短的毛刺，同样重新计时
+                b.raw = e.pressed;
+                b.rawAt = e.atUs;
+            }
+            for (int i = 0; i < count; i++)
+            {
+                settle(buttons[i], nowUs);
+                tick(buttons[i], nowUs);
+            }
+        }
+
+        bool poll(int button, Event *e)
+        {
+            if (button < 0 || button >= count)
+                return false;
+            Button &b = buttons[button];
+            if (b.queued == 0)
+                return false;
+            *e = b.events[b.first];
+            b.first = (b.first + 1) % EVENT_QUEUE_LEN;
+            b.queued--;
+            return true;
+        }
+
+        bool isPressed(int button) const { return button >= 0 && button < count && buttons[button].stable; }
+        uint32_t edgeOverflows() const { return edges.overflows(); }
+        uint32_t eventDrops() const { return drops; }
+
+    private:
+        enum State
+        {
+            IDLE,
+            DOWN,    // 按下，尚未到长按
+            UP_WAIT, // 第一次点击已松开，等待双击
+            HELD     // 已产生长按，按住不放
+        };
+
+        struct Button
+        {
+            bool doubleClick = true;
+            bool raw = false;    // 最近一个边沿的电平
+            uint32_t rawAt = 0;  // 最近一个边沿的时刻
+            bool stable = false; // 消抖后的电平
+            State state = IDLE;
+            bool second = false; // 当前按下是双击的第二次
+            uint32_t since = 0;  // 进入当前状态的时刻
+            uint32_t nextRepeat = 0;
+            uint16_t repeats = 0;
+            Event events[EVENT_QUEUE_LEN];
+            int first = 0;
+            int queued = 0;
+        };
+
+        // 原始电平保持 DEBOUNCE_US 不变则确认，跳变时刻取最后一个边沿 (抖动结束处)
+        void settle(Button &b, uint32_t nowUs)
+        {
+            if (b.raw == b.stable || (int32_t)(nowUs - b.rawAt) < (int32_t)DEBOUNCE_US)
+                return;
+            b.stable = b.raw;
+            tick(b, b.rawAt); // 先处理跳变之前到期的计时
+            if (b.stable)
+                onPress(b, b.rawAt);
+            else
+                onRelease(b, b.rawAt);
+        }
+
+        void onPress(Button &b, uint32_t at)
+        {
+            b.second = b.state == UP_WAIT;
+            b.state = DOWN;
+            b.since = at;
+        }
+
+        void onRelease(Button &b, uint32_t at)
+        {
+            if (b.state == DOWN)
+            {
+                if (b.second)
+                {
+                    emit(b, DOUBLE_CLICK, at, 0);
+                    b.state = IDLE;
+                }
+                else if (!b.doubleClick)
+                {
+                    emit(b, CLICK, at, 0);
+                    b.state = IDLE;
+                }
+                else
+                {
+                    b.state = UP_WAIT;
+                    b.since = at;
+                }
+            }
+            else
+                b.state = IDLE;
+        }
+
+        // 处理与边沿无关的超时: 双击等待结束、长按、按住重复
+        void tick(Button &b, uint32_t nowUs)
+        {
+            if (b.state == UP_WAIT && (int32_t)(nowUs - b.since) >= (int32_t)DOUBLE_GAP_US)
+            {
+                emit(b, CLICK, b.since + DOUBLE_GAP_US, 0);
+                b.state = IDLE;
+            }
+            else if (b.state == DOWN && (int32_t)(nowUs - b.since) >= (int32_t)LONG_PRESS_US)
+            {
+                uint32_t at = b.since + LONG_PRESS_US;
+                if (b.second)
+                    emit(b, CLICK, at, 0); // 第二次按下变成长按: 第一次按下仍算一次点击
+                emit(b, LONG_PRESS, at, 0);
+                b.state = HELD;
+                b.repeats = 0;
+                b.nextRepeat = at + REPEAT_US;
+            }
+            if (b.state == HELD)
+            {
+                while ((int32_t)(nowUs - b.nextRepeat) >= 0)
+                {
+                    emit(b, HOLD_REPEAT, b.nextRepeat, ++b.repeats);
+                    b.nextRepeat += REPEAT_US;
+                }
+            }
+        }
+
+        void emit(Button &b, Type type, uint32_t at, uint16_t repeat)
+        {
+            if (b.queued == EVENT_QUEUE_LEN)
+            {
+                drops++;
+                return;
+            }
+            Event &e = b.events[(b.first + b.queued) % EVENT_QUEUE_LEN];
+            e.type = type;
+            e.repeat = repeat;
+            e.atUs = at;
+            b.queued++;
+        }
+
+        Button buttons[MAX_BUTTONS];
+        int count = 0;
+        uint32_t drops = 0;
+        GpioEvent::Ring<Edge, EDGE_QUEUE_LEN> edges; // 中断写入，update() 读出
+    };
+
+    // ---- 板上接口 (Gesture.cpp) ----
+
+    // 配置引脚并挂接 CHANGE 中断，返回按键编号 (失败返回 -1)
+    // activeLow: 按下为低电平 (内部上拉); 否则按下为高电平 (内部下拉)
+    int attach(int pin, bool activeLow = true, bool doubleClick = true);
+
+    // 取出该按键的下一个手势; 内部先用当前时间推进识别，只需在 loop 中反复调用
+    bool poll(int button, Event *e);
+
+    Engine &engine();
+} // namespace Gesture
+
+#endif
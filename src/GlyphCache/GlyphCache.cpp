@@ -0,0 +1,103 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SPITFT.h>
+#include <U8g2_for_Adafruit_GFX.h>
+#include "GlyphCache.h"
+
+/*
+字形缓存:
+    未命中: U8g2 解码压缩字形 --> 画到 16x20 的 1 bpp 画布 --> 存入缓存
+    绘制:   1 bpp 展开为 RGB565 (前景/背景) --> drawRGBBitmap 一次发送整个单元格
+原来每个字形要经过 U8g2 解码并产生大量 drawPixel / drawFastHLine 小事务，
+现在每个字形只有一次地址窗口设置加一次连续写。
+*/
+
+namespace GlyphCache
+{
+    GFXcanvas1 canvas(CELL_W, CELL_H);
+    U8G2_FOR_ADAFRUIT_GFX raster; // 只用于把字形画到画布上
+
+    void Cache::begin(Adafruit_SPITFT &display)
+    {
+        tft = &display;
+        raster.begin(canvas);
+        raster.setFontMode(1);
+        raster.setFontDirection(0);
+        raster.setForegroundColor(1);
+    }
+
+    void Cache::setFont(const uint8_t *f)
+    {
+        font = f;
+        raster.setFont(f);
+        fontAscent = raster.getFontAscent();
+        fontHeight = fontAscent - raster.getFontDescent();
+        if (fontHeight > CELL_H)
+            fontHeight = CELL_H;
+    }
+
+    void Cache::rasterize(Glyph &g, uint32_t codepoint)
+    {
+        canvas.fillScreen(0);
+        int w = raster.drawGlyph(0, fontAscent, codepoint);
+        g.width = w < 0 ? 0 : w > CELL_W ? CELL_W : w;
+
+        // GFXcanvas1 的行布局与 Glyph::bits 相同 (每行 ROW_BYTES 字节，MSB 在左)
+        memcpy(g.bits, canvas.getBuffer(), fontHeight * ROW_BYTES);
+    }
+
+    const Glyph *Cache::lookup(uint32_t codepoint)
+    {
+        Glyph *g = table.find(font, codepoint);
+        if (g != nullptr)
+        {
+            stats.hits++;
+            return g;
+        }
+
+        bool evicted = false;
+        g = table.insert(font, codepoint, &evicted);
+        rasterize(*g, codepoint);
+        stats.misses++;
+        if (evicted)
+            stats.evictions++;
+        return g;
+    }
+
+    int Cache::width(const char *utf8)
+    {
+        int w = 0;
+        while (*utf8 != 0)
+            w += lookup(nextCodepoint(&utf8))->width;
+        return w;
+    }
+
+    int Cache::drawString(int x, int baseline, const char *utf8, uint16_t fg, uint16_t bg)
+    {
+        uint32_t start = micros();
+        uint16_t pixels[CELL_W * CELL_H];
+        int top = baseline - fontAscent;
+        int cx = x;
+
+        while (*utf8 != 0)
+        {
+            const Glyph *g = lookup(nextCodepoint(&utf8));
+            int w = g->width;
+            if (w == 0)
+                continue;
+
+            uint16_t *p = pixels;
+            for (int row = 0; row < fontHeight; row++)
+            {
+                for (int col = 0; col < w; col++)
+                    *p++ = (g->bits[row][col >> 3] & (0x80 >> (col & 7))) ? fg : bg;
+            }
+            tft->drawRGBBitmap(cx, top, pixels, w, fontHeight);
+            cx += w;
+        }
+
+        stats.strings++;
+        stats.totalUs += micros() - start;
+        return cx - x;
+    }
+} // namespace GlyphCache
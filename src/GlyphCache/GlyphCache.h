@@ -0,0 +1,148 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <string.h>
+
+class Adafruit_SPITFT;
+
+namespace GlyphCache
+{
+    const int CELL_W = 16;      // 单个字形最大宽度 (wqy16 汉字为 16)
+    const int CELL_H = 20;      // 单个字形最大高度 (上升 + 下降)
+    const int MAX_GLYPHS = 96;  // 缓存的字形数量
+    const int ROW_BYTES = (CELL_W + 7) / 8;
+
+    // 一个已光栅化的字形 (1 bpp，每行 MSB 在左)
+    struct Glyph
+    {
+        const uint8_t *font;
+        uint32_t codepoint;
+        uint32_t lastUse; // LRU 时间戳
+        uint8_t width;    // 前进宽度 (像素)
+        bool used;
+        uint8_t bits[CELL_H][ROW_BYTES];
+    };
+
+    // 缓存占用的内存在编译期确定
+    const int CACHE_BYTES = MAX_GLYPHS * sizeof(Glyph);
+
+    // 按 (字体, 码位) 查找字形，满了淘汰最久未使用的
+    // 不依赖 Arduino，主机上可以直接验证命中和淘汰顺序。
+    class Table
+    {
+    public:
+        // 命中返回字形，否则返回 nullptr
+        Glyph *find(const uint8_t *font, uint32_t codepoint)
+        {
+            for (int i = 0; i < MAX_GLYPHS; i++)
+            {
+                Glyph &g = glyphs[i];
+                if (g.used && g.codepoint == codepoint && g.font == font)
+                {
+                    g.lastUse = ++tick;
+                    return &g;
+                }
+            }
+            return nullptr;
+        }
+
+        // 取一个空位或淘汰最久未使用的字形，返回待填充的位置
+        Glyph *insert(const uint8_t *font, uint32_t codepoint, bool *evicted)
+        {
+            int victim = 0;
+            for (int i = 0; i < MAX_GLYPHS; i++)
+            {
+                if (!glyphs[i].used)
+                {
+                    victim = i;
+                    break;
+                }
+                if (glyphs[i].lastUse < glyphs[victim].lastUse)
+                    victim = i;
+            }
+            Glyph &g = glyphs[victim];
+            *evicted = g.used;
+            g.used = true;
+            g.font = font;
+            g.codepoint = codepoint;
+            g.lastUse = ++tick;
+            g.width = 0;
+            memset(g.bits, 0, sizeof(g.bits));
+            return &g;
+        }
+
+        void clear()
+        {
+            for (int i = 0; i < MAX_GLYPHS; i++)
+                glyphs[i].used = false;
+        }
+
+    private:
+        Glyph glyphs[MAX_GLYPHS] = {};
+        uint32_t tick = 0;
+    };
+
+    // 解码一个 UTF-8 字符，返回码位并把 *s 移到下一个字符; 非法字节按单字节处理
+    inline uint32_t nextCodepoint(const char **s)
+    {
+        const uint8_t *p = (const uint8_t *)*s;
+        uint32_t c = p[0];
+        int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+        if (extra > 0)
+            c &= 0x3F >> extra;
+        int i = 1;
+        for (; i <= extra && (p[i] & 0xC0) == 0x80; i++)
+            c = (c << 6) | (p[i] & 0x3F);
+        *s += i;
+        return c;
+    }
+
+    struct Stats
+    {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t strings; // drawString 调用次数
+        uint32_t totalUs; // drawString 累计耗时
+
+        float hitRate() const { return hits + misses ? hits * 100.0f / (hits + misses) : 0; }
+        float usPerString() const { return strings ? (float)totalUs / strings : 0; }
+    };
+
+    // 已光栅化字形的缓存: 首次使用时用 U8g2 解码到 1 bpp 单元格，
+    // 之后每个字形展开为 RGB565 后通过一次 drawRGBBitmap (一个地址窗口) 发送。
+    class Cache
+    {
+    public:
+        void begin(Adafruit_SPITFT &tft);
+
+        // 与屏幕上使用的 U8g2 字体一致 (例如 FONT_WQY16)
+        void setFont(const uint8_t *font);
+
+        // 以不透明背景绘制字符串，(x, baseline) 为基线起点; 返回绘制的总宽度
+        int drawString(int x, int baseline, const char *utf8, uint16_t fg, uint16_t bg);
+
+        // 字符串的前进宽度之和，与 drawString 的返回值相同 (会把用到的字形加入缓存)
+        int width(const char *utf8);
+
+        int ascent() const { return fontAscent; }
+        int height() const { return fontHeight; }
+
+        const Stats &getStats() const { return stats; }
+        void resetStats() { memset(&stats, 0, sizeof(stats)); }
+
+    private:
+        const Glyph *lookup(uint32_t codepoint);
+        void rasterize(Glyph &g, uint32_t codepoint);
+
+        Adafruit_SPITFT *tft = nullptr;
+        const uint8_t *font = nullptr;
+        int fontAscent = 0;
+        int fontHeight = 0;
+        Table table;
+        Stats stats = {};
+    };
+} // namespace GlyphCache
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef GPIO_EVENT_H
+#define GPIO_EVENT_H
+
+#include <stdint.h>
+#include <atomic>
+
+namespace GpioEvent
+{
+    // 一个 GPIO 边沿: 引脚、边沿之后的电平、CPU 周期计数时间戳 (240MHz 下约 17.9 秒回绕，按差值使用)
+    struct Record
+    {
+        uint8_t pin;
+        uint8_t level;
+        uint32_t cycles;
+    };
+
+    // 单生产者单消费者无锁环形缓冲: 中断 (或定时器回调) 写入，主循环成批取出
+    // 满了丢弃新记录并计数，不覆盖未读的记录; push 强制内联，可以直接在 IRAM 中断函数里调用
+    // T 为记录类型 (Record、Gesture::Edge、ADC 采样等)，按值复制
+    template <typename T, int N>
+    class Ring
+    {
+        static_assert((N & (N - 1)) == 0, "N 必须是 2 的幂");
+
+    public:
+        __attribute__((always_inline)) inline bool push(const T &r)
+        {
+            uint32_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) >= (uint32_t)N)
+            {
+                // 只有生产者写这个计数，不需要原子加
+                dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            data[h & (N - 1)] = r;
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 取出最多 max 条记录，返回实际条数
+        int popBatch(T *out, int max)
+        {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            uint32_t available = head.load(std::memory_order_acquire) - t;
+            int n = available < (uint32_t)max ? (int)available : max;
+            for (int i = 0; i < n; i++)
+                out[i] = data[(t + i) & (N - 1)];
+            tail.store(t + n, std::memory_order_release);
+            return n;
+        }
+
+        bool pop(T *r) { return popBatch(r, 1) == 1; }
+
+        int pending() const
+        {
+            return (int)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed));
+        }
+
+        uint32_t pushed() const { return head.load(std::memory_order_acquire); } // 成功写入的累计条数
+        uint32_t overflows() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        T data[N];
+        std::atomic<uint32_t> head{0};
+        std::atomic<uint32_t> tail{0};
+        std::atomic<uint32_t> dropped{0};
+    };
+} // namespace GpioEvent
+
+#endif
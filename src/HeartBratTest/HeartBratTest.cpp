@@ -1,5 +1,9 @@
 #include <Arduino.h>
+#include <esp_timer.h>
 #include "HeartBratTest.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Pulse/Pulse.h"
+#include "../Dsp/Dsp.h"
 
 /*
 电路图:
@@ -13,58 +17,133 @@
     |       GPIO34 |----------------| S (Signal/信号)  |
     |              |                |                  |
     +--------------+                +------------------+
+
+数据流:
+    esp_timer (100 Hz) --> analogRead --> SampleRing --> loop() 中每 32 个样本一块
+    Dsp::Chain: 0.5 - 5 Hz 带通 (按块，ESP-DSP 内核)
+    Detector: 斜率自适应阈值找峰 (不应期) --> 心跳间隔平均 --> BPM + 置信度
 */
 namespace HeartBratTest {
-    const int SENSOR_PIN = 34;    // 传感器连接的模拟引脚
-    const int SAMPLE_RATE = 20;   // 采样间隔 (ms)
-    
-    int sensorValue = 0;          // 当前传感器读数
-    float signalFiltered = 0;     // 过滤后的信号
-    float signalAvg = 0;          // 信号平均值 (用于动态阈值)
-    
-    unsigned long lastSampleTime = 0;
+    const int SENSOR_PIN = 34;         // 传感器连接的模拟引脚
+    const int SAMPLE_HZ = 100;         // 固定采样率，由 esp_timer 驱动
+    const int PROCESS_INTERVAL = 100;  // 处理缓冲样本的间隔 (ms)
+    const int BENCH_SAMPLES = 20000;   // 吞吐量测试的合成样本数 (定义 BOOT_BENCHMARK 时启动时运行)
+    const int BLOCK = 32;              // 每次送入带通滤波链的样本数
+
+    // 定时器回调写入，loop() 中取出; 256 个样本可以容纳 2.5 秒的 loop 停顿
+    Pulse::SampleRing<256> ring;
+    Pulse::Detector detector;
+    Dsp::Biquad bandLow(Pulse::Detector::bandLow(SAMPLE_HZ));
+    Dsp::Biquad bandHigh(Pulse::Detector::bandHigh(SAMPLE_HZ));
+    Dsp::Chain bandPass; // 按块带通，结果逐个送入 detector.feedFiltered()
+    bool settled = false;
+    esp_timer_handle_t sampleTimer = NULL;
+
+    unsigned long lastProcessTime = 0;
     unsigned long lastOutputTime = 0; // 上次输出时间
-    bool isBeat = false;
-    int bpm = 0;
+
+    // 固定速率采样 (运行在 esp_timer 任务中，不受 loop() 的节奏影响)
+    void handle_sample(void *arg) {
+        ring.push(analogRead(SENSOR_PIN)); // 缓冲满时丢弃，计入 ring.overflows()
+    }
+
+    // 用合成 PPG 波形测量检测器每秒能处理的样本数
+    void benchmark() {
+        Pulse::Synth synth(SAMPLE_HZ, 72);
+        Pulse::Detector bench;
+        bench.begin(SAMPLE_HZ);
+
+        // 分块生成样本，只计时检测部分 (单个样本的耗时低于 micros() 的分辨率)
+        float block[250];
+        uint32_t elapsed = 0;
+        for (int done = 0; done < BENCH_SAMPLES; done += 250) {
+            for (int i = 0; i < 250; i++)
+                block[i] = synth.next();
+            uint32_t start = micros();
+            for (int i = 0; i < 250; i++)
+                bench.feed(block[i]);
+            elapsed += micros() - start;
+        }
+        Serial.printf("心跳检测吞吐量: %.0f 样本/秒 (合成 72 BPM -> %d BPM, 置信度 %d%%)\n",
+                      elapsed ? BENCH_SAMPLES * 1000000.0f / elapsed : 0, bench.bpm(), bench.confidence());
+    }
 
     void init() {
         pinMode(SENSOR_PIN, INPUT);
-        Serial.println("心跳检测模块初始化完成 (引脚: 34)");
+#ifdef BOOT_BENCHMARK
+        benchmark();
+        Dsp::benchmark(Serial);
+#endif
+
+        detector.begin(SAMPLE_HZ);
+        bandPass.add(bandLow);
+        bandPass.add(bandHigh);
+        esp_timer_create_args_t args = {};
+        args.callback = handle_sample;
+        args.name = "heart";
+        esp_timer_create(&args, &sampleTimer);
+        esp_timer_start_periodic(sampleTimer, 1000000 / SAMPLE_HZ);
+        Serial.printf("心跳检测模块初始化完成 (引脚: %d, %d Hz)\n", SENSOR_PIN, SAMPLE_HZ);
+    }
+
+    void filterBlock(float *block, int n) {
+        if (!settled) {
+            bandPass.settle(block[0]); // 从第一个样本的直流电平开始，避免上电阶跃
+            settled = true;
+        }
+        bandPass.process(block, block, n);
+        for (int i = 0; i < n; i++)
+            detector.feedFiltered(block[i]);
+    }
+
+    // 1. 取出缓冲中的样本，按块带通后送入检测器
+    void process() {
+        float block[BLOCK];
+        int n = 0;
+        uint16_t v;
+        while (ring.pop(&v)) {
+            block[n++] = v;
+            if (n == BLOCK) {
+                filterBlock(block, n);
+                n = 0;
+            }
+        }
+        if (n > 0)
+            filterBlock(block, n);
+    }
+
+    // 2. 输出结果
+    void report() {
+        Serial.print("当前心率 BPM: ");
+        int bpm = detector.bpm();
+        if (bpm > 0) {
+            Serial.printf("%d (置信度 %d%%)\n", bpm, detector.confidence());
+        } else {
+            Serial.println("等待信号...");
+        }
+        if (ring.overflows() > 0)
+            Serial.printf("采样缓冲溢出，丢弃 %lu 个样本\n", (unsigned long)ring.overflows());
     }
 
     void update() {
         unsigned long currentTime = millis();
-        
-        // 1. 采样与心跳检测
-        if (currentTime - lastSampleTime >= SAMPLE_RATE) {
-            lastSampleTime = currentTime;
-            
-            sensorValue = analogRead(SENSOR_PIN);
-
-            // 简单的低通滤波器，减少噪声
-            signalFiltered = signalFiltered * 0.9 + sensorValue * 0.1;
-            
-            // 动态计算信号平均值，作为基准线
-            signalAvg = signalAvg * 0.99 + signalFiltered * 0.01;
-
-            // 过滤掉不合理的心率 (40 - 200 BPM)
-            if (signalAvg > 40 && signalAvg < 200) {
-                bpm = signalAvg;
-            } else {
-                bpm = 0; // 无效心率
-            }
+
+        if (currentTime - lastProcessTime >= PROCESS_INTERVAL) {
+            lastProcessTime = currentTime;
+            process();
         }
 
-        // 2. 每秒输出一次结果
+        // 每秒输出一次结果
         if (currentTime - lastOutputTime >= 1000) {
             lastOutputTime = currentTime;
-
-            Serial.print("当前心率 BPM: ");
-            if (bpm > 0) {
-                Serial.println(bpm);
-            } else {
-                Serial.println("等待信号...");
-            }
+            report();
         }
     }
+
+    void schedule() {
+        init();
+        // 采样由定时器完成，这里只需定期取出缓冲中的样本
+        Scheduler::add("heart", process, PROCESS_INTERVAL);
+        Scheduler::add("heart_out", report, 1000);
+    }
 } // namespace HeartBratTest
\ No newline at end of file
@@ -7,6 +7,9 @@ namespace HeartBratTest {
 
     // 更新 loop 函数
     void update();
+
+    // 初始化并注册采样 / 输出任务到 Scheduler (替代 update)
+    void schedule();
 } // namespace HeartBratTest
 
 #endif
\ No newline at end of file
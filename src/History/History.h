@@ -0,0 +1,158 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace History
+{
+    // 一段时间内的聚合值 (定点数，缩放由使用者决定，例如温度 x10)
+    struct Agg
+    {
+        int16_t min;
+        int16_t max;
+        int16_t avg;
+    };
+
+    // 固定长度环形缓冲，写满后覆盖最旧的数据
+    template <typename T, int LEN>
+    class Ring
+    {
+    public:
+        void push(const T &v)
+        {
+            slots[head] = v;
+            head = head + 1 == LEN ? 0 : head + 1;
+            if (count < LEN)
+                count++;
+        }
+
+        int size() const { return count; }
+        static int capacity() { return LEN; }
+
+        // i = 0 为最旧，size() - 1 为最新
+        const T &at(int i) const
+        {
+            int idx = head - count + i;
+            return slots[idx < 0 ? idx + LEN : idx];
+        }
+
+    private:
+        T slots[LEN];
+        int head = 0;
+        int count = 0;
+    };
+
+    // 未完成的聚合区间
+    struct Pending
+    {
+        int32_t sum;
+        int16_t min;
+        int16_t max;
+        int16_t n;
+
+        void clear() { n = 0; sum = 0; }
+
+        void add(int16_t lo, int16_t hi, int16_t avg)
+        {
+            if (n == 0 || lo < min)
+                min = lo;
+            if (n == 0 || hi > max)
+                max = hi;
+            sum += avg;
+            n++;
+        }
+
+        Agg take()
+        {
+            Agg a = {min, max, (int16_t)(sum / n)};
+            clear();
+            return a;
+        }
+    };
+
+    // 三级时间序列: 原始值 -> 每 MID_FACTOR 个原始值聚合一次 -> 每 LONG_FACTOR 个中级聚合一次
+    // 每次 add() 只做常数次运算，全部内存静态分配，不使用堆。
+    // 例: Store<4, 120, 10, 360, 30, 288> 以 1 秒采样 = 原始 2 分钟 / 10 秒粒度 1 小时 / 5 分钟粒度 24 小时
+    template <int CH, int RAW_LEN, int MID_FACTOR, int MID_LEN, int LONG_FACTOR, int LONG_LEN>
+    class Store
+    {
+    public:
+        enum Tier
+        {
+            RAW,
+            MID,
+            LONG
+        };
+
+        // 各级数据占用的字节数，在编译期由级别配置算出
+        static constexpr size_t RAW_BYTES = (size_t)CH * RAW_LEN * sizeof(int16_t);
+        static constexpr size_t MID_BYTES = (size_t)CH * MID_LEN * sizeof(Agg);
+        static constexpr size_t LONG_BYTES = (size_t)CH * LONG_LEN * sizeof(Agg);
+        static constexpr size_t DATA_BYTES = RAW_BYTES + MID_BYTES + LONG_BYTES;
+
+        // 每一级单个点代表的采样数
+        static constexpr int span(Tier tier)
+        {
+            return tier == RAW ? 1 : tier == MID ? MID_FACTOR : MID_FACTOR * LONG_FACTOR;
+        }
+
+        Store()
+        {
+            for (int c = 0; c < CH; c++)
+            {
+                midPending[c].clear();
+                longPending[c].clear();
+            }
+        }
+
+        // 写入一组采样 (每个通道一个值)
+        void add(const int16_t *values)
+        {
+            for (int c = 0; c < CH; c++)
+            {
+                int16_t v = values[c];
+                raw[c].push(v);
+                midPending[c].add(v, v, v);
+                if (midPending[c].n == MID_FACTOR)
+                {
+                    Agg a = midPending[c].take();
+                    mid[c].push(a);
+                    longPending[c].add(a.min, a.max, a.avg);
+                    if (longPending[c].n == LONG_FACTOR)
+                        longTier[c].push(longPending[c].take());
+                }
+            }
+            samples++;
+        }
+
+        int size(Tier tier) const
+        {
+            return tier == RAW ? raw[0].size() : tier == MID ? mid[0].size() : longTier[0].size();
+        }
+
+        // 读取某一级的第 i 个点 (0 为最旧)，原始值的 min/max/avg 相同
+        Agg at(int channel, Tier tier, int i) const
+        {
+            if (tier == RAW)
+            {
+                int16_t v = raw[channel].at(i);
+                Agg a = {v, v, v};
+                return a;
+            }
+            return tier == MID ? mid[channel].at(i) : longTier[channel].at(i);
+        }
+
+        uint32_t sampleCount() const { return samples; }
+
+    private:
+        Ring<int16_t, RAW_LEN> raw[CH];
+        Ring<Agg, MID_LEN> mid[CH];
+        Ring<Agg, LONG_LEN> longTier[CH];
+        Pending midPending[CH];
+        Pending longPending[CH];
+        uint32_t samples = 0;
+    };
+} // namespace History
+
+#endif
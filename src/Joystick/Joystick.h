@@ -0,0 +1,288 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include <stdint.h>
+#include <math.h>
+
+namespace Joystick
+{
+    const int ADC_MAX = 4095;
+    const int CAL_SAMPLES = 32;       // 开机静止时用于求中心的采样数
+    const int CAL_SPREAD = 120;       // 校准期间每轴允许的最大波动 (ADC 计数)，超过则重新校准
+    const int CAL_OFFSET = 600;       // 中心偏离 2048 超过该值说明摇杆没有松开，重新校准
+    const int MIN_HALF_RANGE = 1200;  // 初始假定的半量程，推得更远时自动扩展
+    const float DEADZONE = 0.2f;      // 径向死区 (占半量程的比例)，vector() 在此范围内输出 0
+    const float ENTER = 0.6f;         // 推出超过该比例才产生方向事件
+    const float LEAVE = 0.4f;         // 回到该比例以内才算回中 (与 ENTER 构成迟滞)
+    const float SWITCH = 1.3f;        // 推动期间另一轴超过当前轴的该倍数才改变方向
+    const uint32_t DEBOUNCE_US = 20000;      // 按键边沿后的锁定时间
+    const uint32_t LONG_PRESS_US = 600000;   // 长按时间
+    const uint32_t REPEAT_DELAY_US = 400000; // 推住后第一次重复前的等待
+    const uint32_t REPEAT_START_US = 200000; // 第一次重复的间隔
+    const uint32_t REPEAT_MIN_US = 50000;    // 加速后的最短间隔
+    const float REPEAT_ACCEL = 0.8f;         // 每次重复后间隔乘以该系数
+    const int QUEUE_LEN = 16;
+
+    enum Dir
+    {
+        NONE,
+        LEFT,  // X 减小
+        RIGHT,
+        UP,    // Y 减小
+        DOWN
+    };
+
+    enum Type
+    {
+        MOVE,       // 推向 dir (repeat 为 0 表示刚推出，之后为自动重复的序号)
+        PRESS,      // SW 按下
+        RELEASE,    // SW 松开
+        LONG_PRESS  // SW 按住超过 LONG_PRESS_US (之后仍会收到 RELEASE)
+    };
+
+    struct Event
+    {
+        Type type;
+        Dir dir;
+        uint16_t repeat;
+        uint32_t atUs; // 触发该事件的采样时刻; 取出时 micros() - atUs 即为处理延迟
+    };
+
+    // 固定长度的事件队列，满了丢弃新事件并计数; 生产和消费在同一个任务中
+    template <int N>
+    class Queue
+    {
+    public:
+        bool push(const Event &e)
+        {
+            if (count == N)
+            {
+                dropped++;
+                return false;
+            }
+            items[(head + count) % N] = e;
+            count++;
+            return true;
+        }
+
+        bool pop(Event *e)
+        {
+            if (count == 0)
+                return false;
+            *e = items[head];
+            head = (head + 1) % N;
+            count--;
+            return true;
+        }
+
+        int size() const { return count; }
+        uint32_t droppedCount() const { return dropped; }
+
+    private:
+        Event items[N];
+        int head = 0;
+        int count = 0;
+        uint32_t dropped = 0;
+    };
+
+    // 摇杆输入引擎: 自动校准 -> 归一化 -> 径向死区与迟滞 -> 方向事件 (带加速的自动重复)，
+    // SW 按键按时间戳消抖并识别长按。时间和采样都由调用方传入，主机上可以喂录制或合成的数据。
+    class Engine
+    {
+    public:
+        // 重新开始校准; 校准完成前 (摇杆需松开约 CAL_SAMPLES 个采样) 不产生方向事件
+        void begin()
+        {
+            calibrated = false;
+            calCount = 0;
+            dir = NONE;
+            x = y = 0;
+        }
+
+        // 输入一组摇杆采样 (原始 ADC 计数)，atUs 为采样时刻
+        void feedStick(uint32_t atUs, int rawX, int rawY)
+        {
+            if (!calibrated)
+            {
+                calibrate(rawX, rawY);
+                return;
+            }
+            x = normalize(rawX, 0);
+            y = normalize(rawY, 1);
+            float r = sqrtf(x * x + y * y);
+
+            if (dir == NONE)
+            {
+                if (r > ENTER)
+                    startMove(atUs, dominant(NONE));
+            }
+            else if (r < LEAVE)
+                dir = NONE;
+            else
+            {
+                Dir d = dominant(dir);
+                if (d != dir)
+                    startMove(atUs, d);
+                else if ((int32_t)(atUs - nextRepeat) >= 0)
+                {
+                    emit(MOVE, atUs, ++repeats);
+                    nextRepeat = atUs + interval;
+                    interval = (uint32_t)(interval * REPEAT_ACCEL);
+                    if (interval < REPEAT_MIN_US)
+                        interval = REPEAT_MIN_US;
+                }
+            }
+        }
+
+        // 输入一次 SW 电平 (down 为 true 表示按下)，可以和摇杆采样不同频率
+        // 第一个边沿立即生效，之后 DEBOUNCE_US 内的抖动被忽略，按下事件没有消抖延迟
+        void feedButton(uint32_t atUs, bool down)
+        {
+            if (down != pressed && atUs - lastEdge >= DEBOUNCE_US)
+            {
+                pressed = down;
+                lastEdge = atUs;
+                if (down)
+                {
+                    longSent = false;
+                    emit(PRESS, atUs, 0);
+                }
+                else
+                    emit(RELEASE, atUs, 0);
+            }
+            else if (pressed && !longSent && atUs - lastEdge >= LONG_PRESS_US)
+            {
+                longSent = true;
+                emit(LONG_PRESS, atUs, 0);
+            }
+        }
+
+        void feed(uint32_t atUs, int rawX, int rawY, bool swDown)
+        {
+            feedStick(atUs, rawX, rawY);
+            feedButton(atUs, swDown);
+        }
+
+        bool poll(Event *e) { return events.pop(e); }
+
+        bool isCalibrated() const { return calibrated; }
+        int centerX() const { return center[0]; }
+        int centerY() const { return center[1]; }
+        Dir direction() const { return dir; }
+        bool isPressed() const { return pressed; }
+        uint32_t dropped() const { return events.droppedCount(); }
+
+        // 去掉径向死区后重新映射的位置，各轴 -1 - 1
+        void vector(float *outX, float *outY) const
+        {
+            float r = sqrtf(x * x + y * y);
+            if (r <= DEADZONE)
+            {
+                *outX = *outY = 0;
+                return;
+            }
+            float scale = ((r > 1 ? 1 : r) - DEADZONE) / (1 - DEADZONE) / r;
+            *outX = x * scale;
+            *outY = y * scale;
+        }
+
+    private:
+        void calibrate(int rawX, int rawY)
+        {
+            int raw[2] = {rawX, rawY};
+            for (int a = 0; a < 2; a++)
+            {
+                if (calCount == 0 || raw[a] < calMin[a])
+                    calMin[a] = raw[a];
+                if (calCount == 0 || raw[a] > calMax[a])
+                    calMax[a] = raw[a];
+                calSum[a] = calCount == 0 ? raw[a] : calSum[a] + raw[a];
+            }
+            if (calMax[0] - calMin[0] > CAL_SPREAD || calMax[1] - calMin[1] > CAL_SPREAD)
+            {
+                calCount = 0; // 还在动，从这个采样重新开始
+                return;
+            }
+            if (++calCount < CAL_SAMPLES)
+                return;
+
+            for (int a = 0; a < 2; a++)
+            {
+                int c = calSum[a] / CAL_SAMPLES;
+                if (c < (ADC_MAX + 1) / 2 - CAL_OFFSET || c > (ADC_MAX + 1) / 2 + CAL_OFFSET)
+                {
+                    calCount = 0;
+                    return;
+                }
+                center[a] = c;
+                below[a] = c < MIN_HALF_RANGE ? c : MIN_HALF_RANGE;
+                above[a] = ADC_MAX - c < MIN_HALF_RANGE ? ADC_MAX - c : MIN_HALF_RANGE;
+            }
+            calibrated = true;
+        }
+
+        // 映射到 -1 - 1，两侧分别按各自量程 (中心通常不在正中); 推得更远时扩展量程
+        float normalize(int raw, int a)
+        {
+            int d = raw - center[a];
+            if (d < -below[a])
+                below[a] = -d;
+            if (d > above[a])
+                above[a] = d;
+            return d < 0 ? (float)d / below[a] : (float)d / above[a];
+        }
+
+        // 占优的轴决定方向; 推动中 (current 不为 NONE) 需另一轴明显更大才换轴
+        Dir dominant(Dir current) const
+        {
+            float ax = fabsf(x), ay = fabsf(y);
+            bool horizontal;
+            if (current == LEFT || current == RIGHT)
+                horizontal = ay <= ax * SWITCH;
+            else if (current == UP || current == DOWN)
+                horizontal = ax > ay * SWITCH;
+            else
+                horizontal = ax >= ay;
+            if (horizontal)
+                return x < 0 ? LEFT : RIGHT;
+            return y < 0 ? UP : DOWN;
+        }
+
+        void startMove(uint32_t atUs, Dir d)
+        {
+            dir = d;
+            repeats = 0;
+            interval = REPEAT_START_US;
+            nextRepeat = atUs + REPEAT_DELAY_US;
+            emit(MOVE, atUs, 0);
+        }
+
+        void emit(Type type, uint32_t atUs, uint16_t repeat)
+        {
+            Event e = {type, type == MOVE ? dir : NONE, repeat, atUs};
+            events.push(e);
+        }
+
+        bool calibrated = false;
+        int calCount = 0;
+        int calMin[2], calMax[2];
+        int32_t calSum[2];
+        int center[2] = {(ADC_MAX + 1) / 2, (ADC_MAX + 1) / 2};
+        int below[2] = {MIN_HALF_RANGE, MIN_HALF_RANGE};
+        int above[2] = {MIN_HALF_RANGE, MIN_HALF_RANGE};
+
+        float x = 0, y = 0;
+        Dir dir = NONE;
+        uint16_t repeats = 0;
+        uint32_t interval = REPEAT_START_US;
+        uint32_t nextRepeat = 0;
+
+        bool pressed = false;
+        bool longSent = false;
+        uint32_t lastEdge = 0;
+
+        Queue<QUEUE_LEN> events;
+    };
+} // namespace Joystick
+
+#endif
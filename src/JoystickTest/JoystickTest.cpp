@@ -1,5 +1,7 @@
 #include <Arduino.h>
 #include "JoystickTest.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Joystick/Joystick.h"
 
 /*
 电路图 (摇杆测试):
@@ -21,44 +23,79 @@ namespace JoystickTest
     const int JOY_Y_PIN = 32;  // 摇杆 Y 轴
     const int JOY_SW_PIN = 14; // 摇杆按键
 
+    const uint32_t SAMPLE_MS = 10; // 100Hz 采样，方向事件延迟不超过 20ms
+
+    Joystick::Engine joystick;
+    uint32_t lastSample = 0;
+    uint32_t maxLatency = 0; // 采样到事件被取出的最大延迟 (us)
+    bool calibrationShown = false;
+
+    const char *const DIR_NAMES[] = {"-", "左", "右", "上", "下"};
+
     void init()
     {
         Serial.begin(115200);
         pinMode(JOY_X_PIN, INPUT);
         pinMode(JOY_Y_PIN, INPUT);
         pinMode(JOY_SW_PIN, INPUT_PULLUP);
+        joystick.begin();
 
         Serial.println("========================================");
         Serial.println("摇杆测试程序启动");
-        Serial.println("请移动摇杆并按下按键查看输出");
+        Serial.println("请先松开摇杆等待校准，然后移动摇杆并按下按键查看事件");
         Serial.println("========================================");
     }
 
-    void update()
+    void sample()
     {
-        int xVal = analogRead(JOY_X_PIN);
-        int yVal = analogRead(JOY_Y_PIN);
-        int swVal = digitalRead(JOY_SW_PIN);
+        uint32_t now = micros();
+        joystick.feed(now, analogRead(JOY_X_PIN), analogRead(JOY_Y_PIN), digitalRead(JOY_SW_PIN) == LOW);
 
-        // 打印原始值
-        Serial.print("X: ");
-        Serial.print(xVal);
-        Serial.print(" | Y: ");
-        Serial.print(yVal);
-        Serial.print(" | SW: ");
-        Serial.println(swVal == LOW ? "按下" : "松开");
+        if (joystick.isCalibrated() && !calibrationShown)
+        {
+            calibrationShown = true;
+            Serial.printf("校准完成: 中心 X=%d Y=%d\n", joystick.centerX(), joystick.centerY());
+        }
 
-        // 简单的方向判断
-        if (xVal < 500)
-            Serial.println("  [方向: 左]");
-        else if (xVal > 3500)
-            Serial.println("  [方向: 右]");
+        Joystick::Event e;
+        while (joystick.poll(&e))
+        {
+            uint32_t latency = micros() - e.atUs;
+            if (latency > maxLatency)
+                maxLatency = latency;
+            switch (e.type)
+            {
+            case Joystick::MOVE:
+                Serial.printf("[方向: %s] 重复 %u", DIR_NAMES[e.dir], e.repeat);
+                break;
+            case Joystick::PRESS:
+                Serial.print("[按下]");
+                break;
+            case Joystick::RELEASE:
+                Serial.print("[松开]");
+                break;
+            case Joystick::LONG_PRESS:
+                Serial.print("[长按]");
+                break;
+            }
+            // 物理动作到采样最多还有一个采样周期
+            Serial.printf("  延迟 %lu us (最大 %lu us + 采样周期 %lu ms)\n", (unsigned long)latency,
+                          (unsigned long)maxLatency, (unsigned long)SAMPLE_MS);
+        }
+    }
 
-        if (yVal < 500)
-            Serial.println("  [方向: 上]");
-        else if (yVal > 3500)
-            Serial.println("  [方向: 下]");
+    void update()
+    {
+        if (millis() - lastSample >= SAMPLE_MS)
+        {
+            lastSample = millis();
+            sample();
+        }
+    }
 
-        delay(100); // 采样频率
+    void schedule()
+    {
+        init();
+        Scheduler::add("joystick", sample, SAMPLE_MS);
     }
 }
@@ -5,6 +5,9 @@ namespace JoystickTest
 {
     void init();
     void update();
+
+    // 初始化并注册 10ms 周期的采样任务到 Scheduler (替代 update)
+    void schedule();
 }
 
 #endif
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "Ledc.h"
+#include "../Fade/Fade.h"
 
 /*
 电路图:
@@ -13,23 +14,14 @@
 namespace Ledc {
     int LED_PIN = 27;    // PWM 输出引脚
 
-    int FREQ = 2000;     // PWM 频率
-    int RESOLUTION = 8; // PWM 分辨率
+    int FREQ = 5000;     // PWM 频率 (13 位分辨率下 ESP32 最高约 9.7kHz)
 
+    // 呼吸灯由 LEDC 硬件渐变完成，CPU 只在每段渐变结束时设置下一段
     void init() {
-        ledcAttach(LED_PIN, FREQ, RESOLUTION);
+        int channel = Fade::attach(LED_PIN, FREQ);
+        Fade::play(channel, Fade::BREATHE); // 2.56 秒渐亮 + 2.56 秒渐灭，经过伽马校正
     }
 
     void update() {
-        // 渐变亮度
-        for (int duty = 0; duty < pow(2, RESOLUTION); duty++) {
-            ledcWrite(LED_PIN, duty); // 设置 PWM 占空比
-            delay(10);
-        }
-        // 渐变熄灭
-        for (int duty = pow(2, RESOLUTION) - 1; duty >= 0; duty--) {
-            ledcWrite(LED_PIN, duty); // 设置 PWM 占空比
-            delay(10);
-        }
     }
-} // namespace Ledc
\ No newline at end of file
+} // namespace Ledc
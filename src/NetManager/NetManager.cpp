@@ -0,0 +1,130 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include "NetManager.h"
+#include "../BootTrace/BootTrace.h"
+#include "../TimeService/TimeService.h"
+
+/*
+后台 Wi-Fi / NTP 连接管理:
+    OFFLINE --(重试时间到)--> CONNECTING --(连上)--> CONNECTED --> configTime()
+       ^                           |                     |
+       +------(超时, 退避加倍)------+------(断线)---------+
+所有等待都基于 millis() 判断，update() 不会阻塞界面刷新。
+*/
+
+namespace NetManager
+{
+    const unsigned long CONNECT_TIMEOUT = 10000; // 单次连接超时
+    const unsigned long BACKOFF_MIN = 1000;      // 初始重试间隔
+    const unsigned long BACKOFF_MAX = 60000;     // 最大重试间隔
+
+    const char *ssid = NULL;
+    const char *password = NULL;
+    long gmtOffset = 0;
+    int daylightOffset = 0;
+    const char *server = NULL;
+
+    LinkState state = OFFLINE;
+    bool timeConfigured = false;
+    bool timeSynced = false;
+    unsigned long stateSince = 0;
+    unsigned long backoff = BACKOFF_MIN;
+    uint32_t retries = 0;
+
+    void connect()
+    {
+        WiFi.begin(ssid, password);
+        state = CONNECTING;
+        stateSince = millis();
+        Serial.println("Wi-Fi 连接中...");
+    }
+
+    void begin(const char *wifiSsid, const char *wifiPassword,
+               long gmtOffsetSec, int daylightOffsetSec, const char *ntpServer)
+    {
+        ssid = wifiSsid;
+        password = wifiPassword;
+        gmtOffset = gmtOffsetSec;
+        daylightOffset = daylightOffsetSec;
+        server = ntpServer;
+        TimeService::begin(gmtOffsetSec + daylightOffsetSec);
+
+        WiFi.mode(WIFI_STA);
+        WiFi.setAutoReconnect(false); // 由本模块负责退避重连
+        backoff = BACKOFF_MIN;
+        connect();
+    }
+
+    void update()
+    {
+        unsigned long now = millis();
+        bool linked = WiFi.status() == WL_CONNECTED;
+
+        switch (state)
+        {
+        case OFFLINE:
+            if (now - stateSince >= backoff)
+                connect();
+            break;
+
+        case CONNECTING:
+            if (linked)
+            {
+                state = CONNECTED;
+                stateSince = now;
+                backoff = BACKOFF_MIN;
+                BootTrace::mark("wifi");
+                Serial.printf("Wi-Fi 已连接: %s\n", WiFi.localIP().toString().c_str());
+
+                if (!timeConfigured)
+                {
+                    configTime(gmtOffset, daylightOffset, server);
+                    timeConfigured = true;
+                }
+            }
+            else if (now - stateSince >= CONNECT_TIMEOUT)
+            {
+                WiFi.disconnect();
+                state = OFFLINE;
+                stateSince = now;
+                retries++;
+                Serial.printf("Wi-Fi 连接失败，%lu ms 后重试\n", backoff);
+                // 下一次等待时间加倍
+                backoff = backoff * 2 > BACKOFF_MAX ? BACKOFF_MAX : backoff * 2;
+            }
+            break;
+
+        case CONNECTED:
+            if (!linked)
+            {
+                state = OFFLINE;
+                stateSince = now;
+                Serial.println("Wi-Fi 断开");
+            }
+            break;
+        }
+
+        if (!timeSynced && TimeService::isSynced())
+        {
+            timeSynced = true;
+            BootTrace::mark("ntp");
+            Serial.println("时间同步成功!");
+            BootTrace::dump(Serial);
+        }
+    }
+
+    LinkState getLinkState()
+    {
+        return state;
+    }
+
+    bool isTimeSynced()
+    {
+        return timeSynced;
+    }
+
+    uint32_t getRetryCount()
+    {
+        return retries;
+    }
+} // namespace NetManager
@@ -0,0 +1,31 @@
+#ifndef NET_MANAGER_H
+#define NET_MANAGER_H
+
+#include <stdint.h>
+
+namespace NetManager
+{
+    enum LinkState
+    {
+        OFFLINE,    // 未连接，等待下一次重试
+        CONNECTING, // 正在连接
+        CONNECTED   // 已连接
+    };
+
+    // 发起后台连接，立即返回
+    void begin(const char *ssid, const char *password,
+               long gmtOffsetSec, int daylightOffsetSec, const char *ntpServer);
+
+    // 在 loop 中调用，推进连接状态机 (不阻塞)
+    void update();
+
+    LinkState getLinkState();
+
+    // 是否已经完成过一次 NTP 对时 (断网后时间仍然有效)
+    bool isTimeSynced();
+
+    // 累计失败重试次数
+    uint32_t getRetryCount();
+} // namespace NetManager
+
+#endif
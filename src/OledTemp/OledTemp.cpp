@@ -1,8 +1,10 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <U8g2lib.h>
-#include <DHT.h>
 #include "OledTemp.h"
+#include "../Dht11/Dht11.h"
+#include "../Scheduler/Scheduler.h"
+#include "../FontSubset/FontSubset.h"
 
 /*
 电路图:
@@ -27,7 +29,7 @@ namespace OledTemp
     // U8G2_SSD1306_128X64_NONAME_F_HW_I2C: 完整帧缓冲, 硬件 I2C
     U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/U8X8_PIN_NONE, /* clock=*/22, /* data=*/21);
 
-    DHT dht(13, DHT11); // DHT11 传感器连接到 GPIO13
+    Dht11::Sensor dht; // DHT11 传感器连接到 GPIO13，后台读取
 
     unsigned long lastUpdateTime = 0;
 
@@ -36,14 +38,14 @@ namespace OledTemp
         Serial.println("OledTemp 初始化...");
 
         // 初始化 DHT 传感器
-        dht.begin();
+        dht.begin(13, 2000);
 
         // 初始化 U8g2 OLED 显示屏
         u8g2.begin();
         u8g2.enableUTF8Print(); // 启用 UTF-8 支持
 
         // 设置中文字体 (wqy12 是文泉驿 12 像素点阵字体)
-        u8g2.setFont(u8g2_font_wqy12_t_gb2312);
+        u8g2.setFont(FONT_WQY12);
         u8g2.setFontDirection(0);
 
         // 显示启动信息
@@ -54,56 +56,68 @@ namespace OledTemp
         delay(1000);
     }
 
-    void update()
+    // 读取传感器并刷新屏幕
+    void refresh()
     {
-        unsigned long currentTime = millis();
+        Dht11::Reading reading = dht.read(); // 读取缓存结果，不阻塞
+        float h = reading.humidity;
+        float t = reading.temperature;
 
-        // 每 2 秒读取并更新一次
-        if (currentTime - lastUpdateTime >= 2000)
+        if (!reading.valid || reading.status != Dht11::OK)
         {
-            lastUpdateTime = currentTime;
-
-            float h = dht.readHumidity();
-            float t = dht.readTemperature();
-
-            if (isnan(h) || isnan(t))
-            {
-                Serial.println(F("读取 DHT 传感器失败!"));
-                u8g2.clearBuffer();
-                u8g2.setCursor(0, 15);
-                u8g2.print("传感器错误!");
-                u8g2.sendBuffer();
-                return;
-            }
-
-            // 串口输出
-            Serial.print(F("湿度: "));
-            Serial.print(h);
-            Serial.print(F("%  温度: "));
-            Serial.print(t);
-            Serial.println(F("°C"));
-
-            // OLED 显示中文
+            Serial.println(F("读取 DHT 传感器失败!"));
             u8g2.clearBuffer();
+            u8g2.setCursor(0, 15);
+            u8g2.print("传感器错误!");
+            u8g2.sendBuffer();
+            return;
+        }
 
-            // 标题
-            u8g2.setFont(u8g2_font_wqy12_t_gb2312);
-            u8g2.setCursor(0, 12);
-            u8g2.print("温湿度监测");
+        // 串口输出
+        Serial.print(F("湿度: "));
+        Serial.print(h);
+        Serial.print(F("%  温度: "));
+        Serial.print(t);
+        Serial.println(F("°C"));
 
-            // 温度显示
-            u8g2.setCursor(0, 32);
-            u8g2.print("温度: ");
-            u8g2.print(t, 1);
-            u8g2.print(" °C");
+        // OLED 显示中文
+        u8g2.clearBuffer();
 
-            // 湿度显示
-            u8g2.setCursor(0, 52);
-            u8g2.print("湿度: ");
-            u8g2.print(h, 1);
-            u8g2.print(" %");
+        // 标题
+        u8g2.setFont(FONT_WQY12);
+        u8g2.setCursor(0, 12);
+        u8g2.print("温湿度监测");
 
-            u8g2.sendBuffer();
+        // 温度显示
+        u8g2.setCursor(0, 32);
+        u8g2.print("温度: ");
+        u8g2.print(t, 1);
+        u8g2.print(" °C");
+
+        // 湿度显示
+        u8g2.setCursor(0, 52);
+        u8g2.print("湿度: ");
+        u8g2.print(h, 1);
+        u8g2.print(" %");
+
+        u8g2.sendBuffer();
+    }
+
+    void update()
+    {
+        unsigned long currentTime = millis();
+
+        // 每 2 秒读取并更新一次
+        if (currentTime - lastUpdateTime >= 2000)
+        {
+            lastUpdateTime = currentTime;
+            refresh();
         }
     }
+
+    void schedule()
+    {
+        init();
+        Scheduler::add("oled_temp", refresh, 2000);
+    }
 } // namespace OledTemp
@@ -7,6 +7,9 @@ namespace OledTemp {
 
     // 更新 loop 函数
     void update();
+
+    // 初始化并注册 2 秒周期的刷新任务到 Scheduler (替代 update)
+    void schedule();
 } // namespace OledTemp
 
 #endif
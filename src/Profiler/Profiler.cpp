@@ -0,0 +1,75 @@
+#include <Arduino.h>
+#include <esp_cpu.h>
+#include "Profiler.h"
+
+/*
+循环耗时剖析:
+    PROFILE_SCOPE("dht") --> 构造时读 CCOUNT 周期计数器 --> 析构时记录差值
+周期计数器每个核各有一个，同一个作用域不会跨核，差值总是有效的。
+240MHz 下 32 位计数约 17.9 秒回绕，单次测量远小于此。
+*/
+
+namespace Profiler
+{
+    volatile bool enabled = false;
+    Site *sites = nullptr;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    Site::Site(const char *siteName) : name(siteName)
+    {
+        portENTER_CRITICAL(&mux);
+        next = sites;
+        sites = this;
+        portEXIT_CRITICAL(&mux);
+    }
+
+    uint32_t cycles()
+    {
+        return esp_cpu_get_cycle_count();
+    }
+
+    void setEnabled(bool on)
+    {
+        enabled = on;
+    }
+
+    void reset()
+    {
+        for (Site *s = sites; s != nullptr; s = s->next)
+            s->hist.reset();
+    }
+
+    void dump(Print &out)
+    {
+        float mhz = getCpuFrequencyMhz();
+        out.printf("--- 耗时统计 (%s) ---\n", enabled ? "测量中" : "已暂停");
+        out.println("name             count      p50(us)    p99(us)    max(us)");
+        for (Site *s = sites; s != nullptr; s = s->next)
+        {
+            const Histogram &h = s->hist;
+            out.printf("%-14s %8lu %10.1f %10.1f %10.1f\n", s->name, (unsigned long)h.count(),
+                       h.percentile(50) / mhz, h.percentile(99) / mhz, h.max() / mhz);
+        }
+    }
+
+    void pollSerial(Stream &in, Print &out)
+    {
+        while (in.available() > 0)
+        {
+            switch (in.read())
+            {
+            case 'p':
+                dump(out);
+                break;
+            case 'r':
+                reset();
+                out.println("耗时统计已清空");
+                break;
+            case 'e':
+                setEnabled(!enabled);
+                out.println(enabled ? "耗时测量已开启" : "耗时测量已关闭");
+                break;
+            }
+        }
+    }
+} // namespace Profiler
@@ -0,0 +1,150 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <string.h>
+
+class Print;
+class Stream;
+
+namespace Profiler
+{
+    // 对数刻度直方图: 每个 2 的幂区间再均分为 SUB 个桶，相对误差不超过 1/SUB
+    // 不依赖 Arduino，主机上可以直接喂入数值验证分位数计算。
+    class Histogram
+    {
+    public:
+        static const int SUB_BITS = 2;
+        static const int SUB = 1 << SUB_BITS;
+        static const int BUCKETS = (32 - SUB_BITS) * SUB + SUB; // 覆盖整个 uint32 范围
+
+        void reset()
+        {
+            memset(counts, 0, sizeof(counts));
+            total = 0;
+            maxValue = 0;
+        }
+
+        void record(uint32_t v)
+        {
+            counts[bucketOf(v)]++;
+            total++;
+            if (v > maxValue)
+                maxValue = v;
+        }
+
+        uint32_t count() const { return total; }
+        uint32_t max() const { return maxValue; }
+
+        // 第 p (0 - 100) 百分位，返回所在桶的上界 (不超过最大值); 没有数据时返回 0
+        uint32_t percentile(int p) const
+        {
+            if (total == 0)
+                return 0;
+            uint32_t rank = ((uint64_t)total * p + 99) / 100;
+            if (rank == 0)
+                rank = 1;
+            uint32_t seen = 0;
+            for (int i = 0; i < BUCKETS; i++)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                {
+                    uint32_t upper = upperBound(i);
+                    return upper < maxValue ? upper : maxValue;
+                }
+            }
+            return maxValue;
+        }
+
+        static int bucketOf(uint32_t v)
+        {
+            if (v < (uint32_t)SUB)
+                return v;
+            int msb = 31 - __builtin_clz(v);
+            return (msb - SUB_BITS + 1) * SUB + ((v >> (msb - SUB_BITS)) & (SUB - 1));
+        }
+
+        static uint32_t lowerBound(int bucket)
+        {
+            if (bucket < SUB)
+                return bucket;
+            int msb = bucket / SUB + SUB_BITS - 1;
+            return (uint32_t)(SUB + bucket % SUB) << (msb - SUB_BITS);
+        }
+
+        static uint32_t upperBound(int bucket)
+        {
+            return bucket + 1 < BUCKETS ? lowerBound(bucket + 1) - 1 : UINT32_MAX;
+        }
+
+    private:
+        uint32_t counts[BUCKETS] = {0};
+        uint32_t total = 0;
+        uint32_t maxValue = 0;
+    };
+
+    // 一个测量点，第一次执行时注册到全局列表
+    class Site
+    {
+    public:
+        explicit Site(const char *name);
+
+        const char *name;
+        Histogram hist;
+        Site *next = nullptr;
+    };
+
+    extern volatile bool enabled; // 关闭时每个测量点只多一次读和一次分支
+
+    uint32_t cycles(); // CPU 周期计数器
+
+    // 作用域计时: 构造时记录起点，析构时把经过的周期数写入直方图
+    class Scope
+    {
+    public:
+        explicit Scope(Site &s) : site(s), start(0), active(enabled)
+        {
+            if (active)
+                start = cycles();
+        }
+
+        ~Scope()
+        {
+            if (active)
+                site.hist.record(cycles() - start);
+        }
+
+    private:
+        Site &site;
+        uint32_t start;
+        bool active;
+    };
+
+    void setEnabled(bool on);
+
+    // 清空所有直方图
+    void reset();
+
+    // 打印每个测量点的次数与 p50 / p99 / max (us)
+    void dump(Print &out);
+
+    // 在 loop 中调用，处理串口命令: 'p' 打印，'r' 清空，'e' 开关测量
+    // 串口同时输出二进制遥测时，把 out 设为 Telemetry::Writer::lines()，统计以文本帧发送
+    void pollSerial(Stream &in, Print &out);
+    inline void pollSerial(Stream &in) { pollSerial(in, in); }
+} // namespace Profiler
+
+#define PROFILER_CAT2(a, b) a##b
+#define PROFILER_CAT(a, b) PROFILER_CAT2(a, b)
+
+// 测量当前作用域的耗时，name 需为字符串常量
+#ifndef PROFILER_DISABLE
+#define PROFILE_SCOPE(name)                                                      \
+    static Profiler::Site PROFILER_CAT(profilerSite_, __LINE__)(name);           \
+    Profiler::Scope PROFILER_CAT(profilerScope_, __LINE__)(PROFILER_CAT(profilerSite_, __LINE__))
+#else
+#define PROFILE_SCOPE(name)
+#endif
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef PULSE_H
+#define PULSE_H
+
+#include <stdint.h>
+#include <math.h>
+#include "../Dsp/Dsp.h"
+#include "../GpioEvent/GpioEvent.h"
+
+namespace Pulse
+{
+    const int IBI_LEN = 8;          // 参与平均的心跳间隔数量
+    const int MIN_IBI_MS = 300;     // 200 BPM
+    const int MAX_IBI_MS = 1500;    // 40 BPM
+    const float OUTLIER = 0.3f;     // 与当前平均值相差超过 30% 的间隔视为误检
+    const int MAX_REJECTS = 3;      // 连续误检达到该次数时认为节律变化，重新开始平均
+    const float THRESHOLD = 0.6f;   // 检测阈值占斜率包络的比例 (高于重搏波)
+    const float DECAY_S = 3;        // 斜率包络衰减到 1/e 的时间 (秒)，需长于 40 BPM 的间隔
+
+    // 心跳检测: 带通滤波 -> 自适应阈值找峰 (带不应期) -> 心跳间隔 (IBI) 平均
+    // 每个采样调用一次 feed()，采样率固定; 不依赖 Arduino，主机上可以喂录制或合成的 PPG 波形。
+    // 已经按块做过同样的带通 (bandLow() / bandHigh()) 时改用 feedFiltered()。
+    class Detector
+    {
+    public:
+        // sampleHz: 采样率; minAmplitude: 带通后每个采样的最小上升量 (ADC 计数)，低于它视为没有信号
+        void begin(float sampleHz, float minAmplitude = 1)
+        {
+            fs = sampleHz;
+            minAmp = minAmplitude;
+            highPass = Dsp::Biquad(bandLow(fs));
+            lowPass = Dsp::Biquad(bandHigh(fs));
+            decay = 1.0f / (DECAY_S * fs);
+            refractory = (uint32_t)(fs * MIN_IBI_MS / 1000);
+            timeout = (uint32_t)(fs * 2 * MAX_IBI_MS / 1000);
+            n = 0;
+            previous = 0;
+            envelope = 0;
+            inPeak = false;
+            hasLast = false;
+            beats = 0;
+            reset();
+            first = true;
+        }
+
+        // feed() 内部使用的带通: 0.5Hz 高通去掉基线漂移和直流，5Hz 低通去掉工频和高频噪声
+        static Dsp::Coeffs bandLow(float fs) { return Dsp::highPass(fs, 0.5f); }
+        static Dsp::Coeffs bandHigh(float fs) { return Dsp::lowPass(fs, 5.0f); }
+
+        // 输入一个原始采样，返回 true 表示刚确认了一次心跳
+        bool feed(float raw)
+        {
+            if (first)
+            {
+                lowPass.settle(highPass.settle(raw));
+                first = false;
+            }
+            return feedFiltered(lowPass.step(highPass.step(raw)));
+        }
+
+        // 输入一个已经带通滤波的采样
+        bool feedFiltered(float y)
+        {
+            n++;
+
+            // 在斜率上找峰 (脉搏波上升最陡处): 进一步压低呼吸引起的基线漂移，
+            // 重搏波的上升沿也比主波平缓得多
+            float slope = y - previous;
+            previous = y;
+
+            // 包络: 快速跟上峰值，慢速衰减
+            if (slope > envelope)
+                envelope = slope;
+            else
+                envelope -= envelope * decay;
+            float threshold = envelope * THRESHOLD;
+
+            bool beat = false;
+            if (!inPeak)
+            {
+                // 不应期: 至少 MIN_IBI_MS，有平均间隔后取其 60%
+                uint32_t wait = refractory;
+                if (count >= 2 && meanIbi() * 0.6f * fs / 1000 > wait)
+                    wait = (uint32_t)(meanIbi() * 0.6f * fs / 1000);
+                bool ready = !hasLast || n - lastBeat >= wait;
+                if (ready && slope > threshold && slope > minAmp)
+                {
+                    inPeak = true;
+                    peakValue = slope;
+                    peakAt = n;
+                }
+            }
+            else if (slope > peakValue)
+            {
+                peakValue = slope;
+                peakAt = n;
+            }
+            else if (slope < threshold)
+            {
+                // 回落到阈值以下，峰值位置即为这次心跳
+                inPeak = false;
+                onBeat(peakAt);
+                beat = true;
+            }
+
+            // 太久没有心跳 (手指移开)，清空历史
+            if (hasLast && n - lastBeat > timeout && count > 0)
+                reset();
+            return beat;
+        }
+
+        // 平均心率，数据不足时为 0
+        int bpm() const
+        {
+            if (count < 2)
+                return 0;
+            return (int)(60000.0f / meanIbi() + 0.5f);
+        }
+
+        // 置信度 0 - 100: 间隔越稳定、参与平均的间隔越多越高
+        int confidence() const
+        {
+            if (count < 2)
+                return 0;
+            float mean = meanIbi();
+            float var = 0;
+            for (int i = 0; i < count; i++)
+                var += (ibis[i] - mean) * (ibis[i] - mean);
+            float cv = sqrtf(var / count) / mean;
+            float regularity = 1 - cv / 0.15f;
+            if (regularity < 0)
+                regularity = 0;
+            return (int)(100 * regularity * count / IBI_LEN + 0.5f);
+        }
+
+        uint32_t beatCount() const { return beats; }
+        uint32_t samples() const { return n; }
+
+    private:
+        void reset()
+        {
+            count = 0;
+            head = 0;
+            rejects = 0;
+        }
+
+        float meanIbi() const
+        {
+            float sum = 0;
+            for (int i = 0; i < count; i++)
+                sum += ibis[i];
+            return sum / count;
+        }
+
+        void onBeat(uint32_t at)
+        {
+            beats++;
+            if (hasLast)
+            {
+                float ibi = (at - lastBeat) * 1000.0f / fs;
+                if (ibi < MIN_IBI_MS || ibi > MAX_IBI_MS)
+                    reset();
+                else if (count >= 3 && fabsf(ibi - meanIbi()) > OUTLIER * meanIbi())
+                {
+                    if (++rejects >= MAX_REJECTS)
+                        reset();
+                }
+                else
+                {
+                    rejects = 0;
+                    ibis[head] = ibi;
+                    head = (head + 1) % IBI_LEN;
+                    if (count < IBI_LEN)
+                        count++;
+                }
+            }
+            lastBeat = at;
+            hasLast = true;
+        }
+
+        Dsp::Biquad highPass{bandLow(100)};
+        Dsp::Biquad lowPass{bandHigh(100)};
+        float fs = 100;
+        float minAmp = 1;
+        float decay = 0;
+        uint32_t refractory = 0;
+        uint32_t timeout = 0;
+        bool first = true;
+
+        uint32_t n = 0; // 采样序号
+        float previous = 0;
+        float envelope = 0;
+        bool inPeak = false;
+        float peakValue = 0;
+        uint32_t peakAt = 0;
+        bool hasLast = false;
+        uint32_t lastBeat = 0;
+        uint32_t beats = 0;
+
+        float ibis[IBI_LEN] = {};
+        int head = 0;
+        int count = 0;
+        int rejects = 0;
+    };
+
+    // 定时器回调写入采样，loop() 读出
+    template <int N>
+    using SampleRing = GpioEvent::Ring<uint16_t, N>;
+
+    // 合成 PPG 波形 (ADC 计数): 主峰 + 重搏波 + 呼吸引起的基线漂移 + 均匀噪声
+    // 用于主机测试 (test_pulse) 和板上的吞吐量测试
+    class Synth
+    {
+    public:
+        Synth(float sampleHz, float bpm, float amplitude = 60, float noise = 8)
+            : fs(sampleHz), rate(bpm), amp(amplitude), noiseAmp(noise) {}
+
+        void setBpm(float bpm) { rate = bpm; }
+
+        float next()
+        {
+            const float PI_F = 3.14159265f;
+            float t = n++ / fs;
+            phase += rate / 60.0f / fs;
+            if (phase >= 1)
+                phase -= 1;
+            float main = (phase - 0.2f) / 0.05f;
+            float notch = (phase - 0.45f) / 0.08f;
+            float pulse = expf(-main * main) + 0.4f * expf(-notch * notch);
+            float baseline = 2000 + 100 * sinf(2 * PI_F * 0.25f * t);
+            seed = seed * 1664525u + 1013904223u;
+            float noise = ((seed >> 8) / 16777216.0f - 0.5f) * 2 * noiseAmp;
+            return baseline + amp * pulse + noise;
+        }
+
+    private:
+        float fs, rate, amp, noiseAmp;
+        float phase = 0;
+        uint32_t n = 0;
+        uint32_t seed = 12345;
+    };
+} // namespace Pulse
+
+#endif
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "Pwm.h"
+#include "../Fade/Fade.h"
 
 /*
 电路图:
@@ -13,19 +14,21 @@
 namespace Pwm {
     int LED_PIN = 27;
 
+    // 关键帧串联: 1 秒渐亮 -> 保持 0.5 秒 -> 闪两下 -> 2 秒渐灭 -> 熄灭 1 秒，循环
+    const Fade::Key SHOW_KEYS[] = {
+        {255, 1000}, {255, 500},
+        {0, 0}, {0, 150}, {255, 0}, {255, 150},
+        {0, 0}, {0, 150}, {255, 0}, {255, 150},
+        {0, 2000}, {0, 1000},
+    };
+    const Fade::Animation SHOW = {SHOW_KEYS, sizeof(SHOW_KEYS) / sizeof(SHOW_KEYS[0]), true};
+
     void init() {
-        // 设定引脚为输出模式
-        pinMode(LED_PIN, OUTPUT);
+        int channel = Fade::attach(LED_PIN);
+        Fade::play(channel, SHOW);
     }
 
+    // 动画由 LEDC 硬件渐变和结束中断驱动，loop 不再阻塞
     void update() {
-        for (int duty = 0; duty <= 255; duty++) {
-            analogWrite(LED_PIN, duty); // 设置 PWM 占空比
-            delay(10);
-        }
-        for (int duty = 255; duty >= 0; duty--) {
-            analogWrite(LED_PIN, duty); // 设置 PWM 占空比
-            delay(10);
-        }
     }
-} // namespace Pwm
\ No newline at end of file
+} // namespace Pwm
@@ -0,0 +1,73 @@
+#include <Arduino.h>
+#include "Rgb.h"
+#include "../TimerWheel/TimerWheel.h"
+
+namespace Rgb
+{
+    const uint32_t PWM_FREQ = 5000; // 13 位分辨率下 ESP32 最高约 9.7kHz
+
+    int pins[3] = {-1, -1, -1};
+    Mixer mixer;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+    Stats stats = {};
+    bool started = false;
+
+    // "timers" 任务中每 FRAME_MS 执行一次，只写入占空比变化的通道
+    void frame(void *)
+    {
+        uint16_t duty[3];
+        portENTER_CRITICAL(&mux);
+        uint8_t changed = mixer.render(millis(), duty);
+        portEXIT_CRITICAL(&mux);
+
+        stats.frames++;
+        for (int i = 0; i < 3; i++)
+        {
+            if (changed & (1 << i))
+            {
+                ledcWrite(pins[i], duty[i]);
+                stats.writes++;
+            }
+            else
+                stats.skips++;
+        }
+    }
+
+    bool begin(int rPin, int gPin, int bPin)
+    {
+        if (started)
+            return true;
+        pins[0] = rPin;
+        pins[1] = gPin;
+        pins[2] = bPin;
+        for (int i = 0; i < 3; i++)
+        {
+            if (!ledcAttach(pins[i], PWM_FREQ, DUTY_BITS))
+                return false;
+            ledcWrite(pins[i], 0);
+        }
+        if (!TimerWheel::begin() || TimerWheel::start(FRAME_MS, frame, nullptr, FRAME_MS) == 0)
+            return false;
+        started = true;
+        return true;
+    }
+
+    void fadeTo(Color c, uint32_t ms)
+    {
+        portENTER_CRITICAL(&mux);
+        mixer.fadeTo(c, ms, millis());
+        portEXIT_CRITICAL(&mux);
+    }
+
+    void strobe(Color c, uint16_t onMs, uint16_t offMs)
+    {
+        portENTER_CRITICAL(&mux);
+        mixer.strobe(c, onMs, offMs, millis());
+        portEXIT_CRITICAL(&mux);
+    }
+
+    const Stats &getStats()
+    {
+        return stats;
+    }
+} // namespace Rgb
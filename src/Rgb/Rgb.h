@@ -0,0 +1,201 @@
+#ifndef RGB_H
+#define RGB_H
+
+#include <stdint.h>
+#include "../Fade/Fade.h"
+
+namespace Rgb
+{
+    const int DUTY_BITS = Fade::DUTY_BITS; // 13 位，与伽马表一致
+    const uint32_t FRAME_MS = 20;          // 定时器推进渐变的间隔 (50Hz)
+    const uint32_t FADE_MS = 800;          // 默认的颜色过渡时间
+    const uint16_t STROBE_ON_MS = 80;      // 报警频闪
+    const uint16_t STROBE_OFF_MS = 170;
+
+    struct Color
+    {
+        uint8_t r, g, b;
+
+        constexpr bool operator==(const Color &o) const { return r == o.r && g == o.g && b == o.b; }
+        constexpr bool operator!=(const Color &o) const { return !(*this == o); }
+    };
+
+    // 色相 0 - 255 (满饱和度、满亮度) 到感知亮度 RGB 的表，编译期生成
+    struct HueTable
+    {
+        Color color[256];
+
+        constexpr HueTable() : color()
+        {
+            for (int h = 0; h < 256; h++)
+            {
+                int sector = h * 6 / 256;     // 0 - 5
+                int x = h * 6 - sector * 256; // 扇区内 0 - 255
+                int fall = 255 - x;
+                Color c = {0, 0, 0};
+                switch (sector)
+                {
+                case 0: c = {255, (uint8_t)x, 0}; break;
+                case 1: c = {(uint8_t)fall, 255, 0}; break;
+                case 2: c = {0, 255, (uint8_t)x}; break;
+                case 3: c = {0, (uint8_t)fall, 255}; break;
+                case 4: c = {(uint8_t)x, 0, 255}; break;
+                default: c = {255, 0, (uint8_t)fall}; break;
+                }
+                color[h] = c;
+            }
+        }
+    };
+
+    constexpr HueTable HUE_TABLE{};
+
+    // h: 色相 0 - 255 (0 红，85 绿，170 蓝); s: 饱和度; v: 亮度
+    constexpr Color hsv(uint8_t h, uint8_t s, uint8_t v)
+    {
+        return {(uint8_t)((HUE_TABLE.color[h].r * s + 255 * (255 - s)) / 255 * v / 255),
+                (uint8_t)((HUE_TABLE.color[h].g * s + 255 * (255 - s)) / 255 * v / 255),
+                (uint8_t)((HUE_TABLE.color[h].b * s + 255 * (255 - s)) / 255 * v / 255)};
+    }
+
+    constexpr Color OFF = {0, 0, 0};
+    constexpr Color RED = hsv(0, 255, 255);
+    constexpr Color ORANGE = hsv(27, 255, 255);
+    constexpr Color GREEN = hsv(85, 255, 255);
+    constexpr Color BLUE = hsv(170, 255, 255);
+
+    // 三个 Hub 模块共用的状态颜色
+    constexpr Color COLD = BLUE;
+    constexpr Color COMFORT = GREEN;
+    constexpr Color HOT = ORANGE;
+    constexpr Color ALARM = RED;
+
+    // 按温度选状态颜色: 20 度以下冷，28 度以下舒适
+    inline Color climate(float temperature)
+    {
+        return temperature < 20 ? COLD : temperature < 28 ? COMFORT : HOT;
+    }
+
+    // 感知亮度 (8.8 定点) 到占空比: 在伽马表相邻两项之间线性插值，13 位输出没有台阶
+    inline uint16_t toDuty(uint16_t level)
+    {
+        int i = level >> 8;
+        if (i >= 255)
+            return Fade::GAMMA_TABLE[255];
+        int a = Fade::GAMMA_TABLE[i], b = Fade::GAMMA_TABLE[i + 1];
+        return (uint16_t)(a + (b - a) * (level & 0xFF) / 256);
+    }
+
+    // 颜色过渡与频闪: 目标和时间由调用方给出，render() 按时间算出三路占空比
+    // 不依赖 Arduino，主机上可以用虚拟时间检查过渡曲线和跳过的重复写入
+    class Mixer
+    {
+    public:
+        // 从当前显示的颜色过渡到 c; 目标不变时不重新开始
+        void fadeTo(Color c, uint32_t ms, uint32_t nowMs)
+        {
+            if (mode == FADE && c == target)
+                return;
+            capture(nowMs);
+            target = c;
+            mode = FADE;
+            start = nowMs;
+            duration = ms;
+        }
+
+        // 以 c 频闪 (亮 onMs，灭 offMs); 参数相同时保持相位
+        void strobe(Color c, uint16_t onMs, uint16_t offMs, uint32_t nowMs)
+        {
+            if (mode == STROBE && c == target && onMs == on && offMs == off)
+                return;
+            target = c;
+            mode = STROBE;
+            start = nowMs;
+            on = onMs;
+            off = offMs;
+        }
+
+        // 计算 nowMs 时三路 (R G B) 的占空比，返回与上次相比变化的通道位掩码 (bit0 = R)
+        uint8_t render(uint32_t nowMs, uint16_t duty[3])
+        {
+            uint16_t level[3];
+            levels(nowMs, level);
+            uint8_t changed = 0;
+            for (int i = 0; i < 3; i++)
+            {
+                duty[i] = toDuty(level[i]);
+                if (!rendered || duty[i] != last[i])
+                    changed |= 1 << i;
+                last[i] = duty[i];
+            }
+            rendered = true;
+            return changed;
+        }
+
+        // 过渡已结束 (频闪一直算作活动)
+        bool isSettled(uint32_t nowMs) const { return mode == FADE && nowMs - start >= duration; }
+
+    private:
+        enum Mode
+        {
+            FADE,
+            STROBE
+        };
+
+        static uint16_t fixed(uint8_t v) { return (uint16_t)v << 8; }
+
+        void levels(uint32_t nowMs, uint16_t out[3]) const
+        {
+            const uint8_t to[3] = {target.r, target.g, target.b};
+            if (mode == STROBE)
+            {
+                uint32_t period = (uint32_t)on + off;
+                bool lit = period == 0 || (nowMs - start) % period < on;
+                for (int i = 0; i < 3; i++)
+                    out[i] = lit ? fixed(to[i]) : 0;
+                return;
+            }
+            uint32_t elapsed = nowMs - start;
+            for (int i = 0; i < 3; i++)
+            {
+                if (elapsed >= duration)
+                    out[i] = fixed(to[i]);
+                else
+                    out[i] = (uint16_t)(from[i] + ((int32_t)fixed(to[i]) - from[i]) * (int32_t)elapsed / (int32_t)duration);
+            }
+        }
+
+        // 以当前显示的亮度作为新过渡的起点，中途改变目标也不跳变
+        void capture(uint32_t nowMs)
+        {
+            levels(nowMs, from);
+        }
+
+        Mode mode = FADE;
+        Color target = OFF;
+        uint16_t from[3] = {0, 0, 0};
+        uint32_t start = 0;
+        uint32_t duration = 0;
+        uint16_t on = 0, off = 0;
+        uint16_t last[3] = {0, 0, 0};
+        bool rendered = false;
+    };
+
+    // ---- 板上驱动 (Rgb.cpp): 三路 LEDC，TimerWheel 每 FRAME_MS 推进一次 ----
+
+    struct Stats
+    {
+        uint32_t frames; // 定时器推进次数
+        uint32_t writes; // 实际写入 LEDC 的次数
+        uint32_t skips;  // 占空比未变而跳过的写入
+    };
+
+    // 挂接三路引脚 (共阴 RGB LED) 并启动定时器; 重复调用无副作用
+    bool begin(int rPin, int gPin, int bPin);
+
+    void fadeTo(Color c, uint32_t ms = FADE_MS);
+    void strobe(Color c, uint16_t onMs = STROBE_ON_MS, uint16_t offMs = STROBE_OFF_MS);
+
+    const Stats &getStats();
+} // namespace Rgb
+
+#endif
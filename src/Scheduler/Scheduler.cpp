@@ -0,0 +1,55 @@
+#include <Arduino.h>
+#include "Scheduler.h"
+
+/*
+协作式调度:
+    loop() --> run() --> 执行所有已释放的任务 (截止时间早的先执行)
+                     --> vTaskDelay() 睡到下一次释放
+loop 任务阻塞期间 IDLE 任务执行 waiti 指令，CPU 进入等待中断状态，
+不再在 millis() 判断上空转。
+*/
+
+namespace Scheduler
+{
+    Core core;
+
+    uint32_t clock()
+    {
+        return micros();
+    }
+
+    int add(const char *name, TaskFn fn, uint32_t periodMs, uint32_t deadlineMs, uint8_t priority)
+    {
+        return core.add(name, fn, periodMs * 1000, deadlineMs * 1000, priority, micros());
+    }
+
+    void run()
+    {
+        while (core.runOnce(clock) >= 0)
+        {
+        }
+
+        // 不足一个 tick 的等待留给下一次 loop()，避免睡过头
+        uint32_t wait = core.untilNext(micros());
+        if (wait == UINT32_MAX)
+            wait = 1000000;
+        TickType_t ticks = pdMS_TO_TICKS(wait / 1000);
+        if (ticks > 0)
+            vTaskDelay(ticks);
+    }
+
+    void dump(Print &out)
+    {
+        out.println("--- 任务统计 ---");
+        out.println("name          period   runs  overrun  skip  jitter(max)  run(max)");
+        for (int i = 0; i < core.size(); i++)
+        {
+            const Task &t = core.task(i);
+            out.printf("%-12s %6lums %6lu %8lu %5lu %6luus %8luus\n",
+                       t.name, (unsigned long)(t.period / 1000),
+                       (unsigned long)t.stats.runs, (unsigned long)t.stats.overruns,
+                       (unsigned long)t.stats.skipped, (unsigned long)t.stats.maxJitter,
+                       (unsigned long)t.stats.maxRun);
+        }
+    }
+} // namespace Scheduler
@@ -0,0 +1,162 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+class Print;
+
+namespace Scheduler
+{
+    const int MAX_TASKS = 12;
+
+    typedef void (*TaskFn)();
+    typedef uint32_t (*ClockFn)(); // 返回当前时间 (us)
+
+    // 单个任务的运行统计
+    struct TaskStats
+    {
+        uint32_t runs;        // 执行次数
+        uint32_t overruns;    // 结束时间超过截止时间的次数
+        uint32_t skipped;     // 落后超过一个周期而被跳过的周期数
+        uint32_t lastJitter;  // 最近一次开始时间与释放时间之差 (us)
+        uint32_t maxJitter;   // 最大抖动 (us)
+        uint32_t maxRun;      // 最长单次执行时间 (us)
+    };
+
+    struct Task
+    {
+        const char *name;    // 任务名称 (需为字符串常量)
+        TaskFn fn;
+        uint32_t period;     // 周期 (us)
+        uint32_t deadline;   // 相对截止时间 (us)，从释放时刻算起
+        uint8_t priority;    // 截止时间相同时，数值大的先执行
+        uint32_t releaseAt;  // 下一次释放时刻 (us)
+        TaskStats stats;
+    };
+
+    // 最早截止时间优先 (EDF) 调度核心
+    // 时间全部由调用方传入，不依赖 Arduino，主机上可以用虚拟时钟驱动并验证调度行为。
+    // 时间戳为 32 位 us，比较时按差值处理，约 71 分钟回绕一次也不影响。
+    class Core
+    {
+    public:
+        void reset() { count = 0; }
+
+        // 注册任务，第一次释放在 nowUs; deadlineUs 为 0 时等于周期
+        // 返回任务编号，任务表已满时返回 -1
+        int add(const char *name, TaskFn fn, uint32_t periodUs, uint32_t deadlineUs,
+                uint8_t priority, uint32_t nowUs)
+        {
+            if (count >= MAX_TASKS || fn == nullptr || periodUs == 0)
+                return -1;
+            Task &t = tasks[count];
+            t.name = name;
+            t.fn = fn;
+            t.period = periodUs;
+            t.deadline = deadlineUs == 0 ? periodUs : deadlineUs;
+            t.priority = priority;
+            t.releaseAt = nowUs;
+            t.stats = TaskStats();
+            return count++;
+        }
+
+        // 已释放的任务中选出绝对截止时间最早的一个，没有就绪任务时返回 -1
+        int pick(uint32_t nowUs) const
+        {
+            int best = -1;
+            for (int i = 0; i < count; i++)
+            {
+                const Task &t = tasks[i];
+                if (before(nowUs, t.releaseAt))
+                    continue;
+                if (best < 0)
+                {
+                    best = i;
+                    continue;
+                }
+                const Task &b = tasks[best];
+                uint32_t d = t.releaseAt + t.deadline;
+                uint32_t bd = b.releaseAt + b.deadline;
+                if (before(d, bd) || (d == bd && t.priority > b.priority))
+                    best = i;
+            }
+            return best;
+        }
+
+        // 任务执行完毕后调用，更新统计并计算下一次释放时刻
+        void complete(int id, uint32_t startUs, uint32_t endUs)
+        {
+            Task &t = tasks[id];
+            TaskStats &s = t.stats;
+            s.runs++;
+            s.lastJitter = startUs - t.releaseAt;
+            if (s.lastJitter > s.maxJitter)
+                s.maxJitter = s.lastJitter;
+            if (endUs - startUs > s.maxRun)
+                s.maxRun = endUs - startUs;
+            if (endUs - t.releaseAt > t.deadline)
+                s.overruns++;
+
+            // 按固定节拍释放; 落后整周期时跳过这些周期，不做补偿性的连续执行。
+            // 落后不足一个周期时照常释放 (稍后立即执行)，只记为抖动
+            t.releaseAt += t.period;
+            if (!before(endUs, t.releaseAt) && endUs - t.releaseAt >= t.period)
+            {
+                uint32_t behind = (endUs - t.releaseAt) / t.period;
+                s.skipped += behind;
+                t.releaseAt += behind * t.period;
+            }
+        }
+
+        // 执行一个就绪任务，返回任务编号; 没有就绪任务时返回 -1
+        int runOnce(ClockFn clock)
+        {
+            uint32_t start = clock();
+            int id = pick(start);
+            if (id < 0)
+                return -1;
+            tasks[id].fn();
+            complete(id, start, clock());
+            return id;
+        }
+
+        // 距下一次释放还有多久 (us)，已有就绪任务时返回 0，没有任务时返回 UINT32_MAX
+        uint32_t untilNext(uint32_t nowUs) const
+        {
+            uint32_t wait = UINT32_MAX;
+            for (int i = 0; i < count; i++)
+            {
+                if (!before(nowUs, tasks[i].releaseAt))
+                    return 0;
+                uint32_t w = tasks[i].releaseAt - nowUs;
+                if (w < wait)
+                    wait = w;
+            }
+            return wait;
+        }
+
+        int size() const { return count; }
+        const Task &task(int id) const { return tasks[id]; }
+
+        // a 是否早于 b (考虑回绕)
+        static bool before(uint32_t a, uint32_t b)
+        {
+            return (int32_t)(a - b) < 0;
+        }
+
+    private:
+        Task tasks[MAX_TASKS];
+        int count = 0;
+    };
+
+    // 注册周期任务 (ms)，deadlineMs 为 0 时等于周期; 返回任务编号，失败返回 -1
+    int add(const char *name, TaskFn fn, uint32_t periodMs, uint32_t deadlineMs = 0, uint8_t priority = 0);
+
+    // 在 loop() 中调用: 按 EDF 执行所有就绪任务，然后让出 CPU 睡到下一次释放
+    void run();
+
+    // 打印每个任务的统计
+    void dump(Print &out);
+} // namespace Scheduler
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+namespace Seqlock
+{
+    // 单写者多读者的顺序锁，用于跨核发布小块数据 (快照)
+    // 写者: 序号变奇数 -> 写数据 -> 序号变偶数，永不阻塞
+    // 读者: 读序号 -> 读数据 -> 再读序号，两次相同且为偶数才算读到完整数据，否则重读
+    // 数据按 32 位字存放在原子变量中，读写交错时不会产生数据竞争，
+    // 只依赖 <atomic>，ESP32 上和主机 std::thread 下行为一致。
+    template <typename T>
+    class Cell
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Seqlock::Cell 只能保存可平凡拷贝的类型");
+
+    public:
+        // 只允许一个写者调用
+        void write(const T &value)
+        {
+            uint32_t words[WORDS] = {0};
+            memcpy(words, &value, sizeof(T));
+
+            uint32_t s = seq.load(std::memory_order_relaxed);
+            seq.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (int i = 0; i < WORDS; i++)
+                data[i].store(words[i], std::memory_order_relaxed);
+            seq.store(s + 2, std::memory_order_release);
+        }
+
+        // 尝试读取一次，与写者交错时返回 false
+        bool tryRead(T &out) const
+        {
+            uint32_t s1 = seq.load(std::memory_order_acquire);
+            if (s1 & 1)
+                return false;
+            uint32_t words[WORDS];
+            for (int i = 0; i < WORDS; i++)
+                words[i] = data[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) != s1)
+                return false;
+            memcpy(&out, words, sizeof(T));
+            return true;
+        }
+
+        // 读取最新的完整数据; 写一次只需几十个周期，重试次数很少
+        T read() const
+        {
+            T out;
+            while (!tryRead(out))
+            {
+            }
+            return out;
+        }
+
+        // 已发布的次数，可用来判断是否有新数据
+        uint32_t version() const
+        {
+            return seq.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        static const int WORDS = (sizeof(T) + 3) / 4;
+        std::atomic<uint32_t> data[WORDS] = {};
+        std::atomic<uint32_t> seq{0};
+    };
+} // namespace Seqlock
+
+#endif
@@ -1,11 +1,22 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <U8g2lib.h>
-#include <DHT.h>
-#include <WiFi.h>
-#include "time.h"
 #include "secrets.h"
 #include "SmartHub.h"
+#include "../Ultrasonic/Ultrasonic.h"
+#include "../TileFlush/TileFlush.h"
+#include "../Dht11/Dht11.h"
+#include "../NetManager/NetManager.h"
+#include "../BootTrace/BootTrace.h"
+#include "../TimeService/TimeService.h"
+#include "../Scheduler/Scheduler.h"
+#include "../Seqlock/Seqlock.h"
+#include "../History/History.h"
+#include "../Profiler/Profiler.h"
+#include "../FontSubset/FontSubset.h"
+#include "../AdcStream/AdcStream.h"
+#include "../Joystick/Joystick.h"
+#include "../Rgb/Rgb.h"
 
 /*
 电路图 (SmartHub 交互终端):
@@ -75,165 +86,291 @@ namespace SmartHub
     const int RGB_G_PIN = 16;
     const int RGB_B_PIN = 17;
 
+    // 四路模拟量由连续模式 ADC 后台采样，每个通道 200Hz (过采样平均后)
+    const int ADC_PINS[] = {JOY_X_PIN, JOY_Y_PIN, LDR_PIN, POT_PIN};
+    const int ADC_RATE_HZ = 200;
+    AdcStream::Subscriber *joyX = nullptr; // 100Hz，送入摇杆输入引擎
+    AdcStream::Subscriber *joyY = nullptr;
+    AdcStream::Subscriber *ldr = nullptr;  // 10Hz，每次采样取平均
+    AdcStream::Subscriber *pot = nullptr;
+    int joyXVal = 2048, joyYVal = 2048; // 摇杆居中
+    Joystick::Engine joystick;          // 校准、死区、按键消抖与自动重复
+    int ldrVal = 0, potVal = 0;
+
     // NTP 服务器设置
     const char *ntpServer = "pool.ntp.org";
     const long gmtOffset_sec = 8 * 3600; // 中国时区 (UTC+8)
     const int daylightOffset_sec = 0;
 
     U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/U8X8_PIN_NONE, /* clock=*/22, /* data=*/21);
-    DHT dht(DHT_PIN, DHT11);
+    Dht11::Sensor dht; // 后台读取，不关中断
+    TileFlush::Flusher oledFlusher; // 只发送变化的 8x8 tile
+
+    // 一次采样的结果，由采集方发布、渲染方读取
+    struct Snapshot
+    {
+        float temp;
+        float hum;
+        int light;
+        int dist;
+        int alarmThreshold;
+        bool alarmActive;
+    };
+    Seqlock::Cell<Snapshot> latest; // 跨核发布，渲染方永不等待采集
+
+    // 历史数据: 1 秒原始值 2 分钟 / 10 秒聚合 1 小时 / 5 分钟聚合 24 小时
+    enum HistoryChannel
+    {
+        CH_TEMP, // 温度 x10
+        CH_HUM,  // 湿度 x10
+        CH_LIGHT,
+        CH_DIST,
+        CH_COUNT
+    };
+    typedef History::Store<CH_COUNT, 120, 10, 360, 30, 288> HubHistory;
+    static_assert(HubHistory::DATA_BYTES <= 20 * 1024, "历史数据超出内存预算");
+    HubHistory history; // 只在渲染侧写入和读取
+    HubHistory::Tier trendTier = HubHistory::MID;
+    unsigned long lastHistoryTime = 0;
+
+    const int MENU_COUNT = 5;
 
     // 状态变量
     int currentMenu = 0;
-    float temp = 0, hum = 0;
+    float temp = 0, hum = 0; // 以下为渲染使用的快照副本
     int light = 0, dist = 0;
     int alarmThreshold = 20; // 报警距离阈值
     bool alarmActive = false;
+    bool dualCore = false;   // 采集是否运行在 core 0 的独立任务中
     unsigned long lastSenseTime = 0;
-    unsigned long lastMenuMoveTime = 0; // 记录上次摇杆移动时间，防止切换过快
-
-    // 获取超声波距离
-    int getDistance()
-    {
-        digitalWrite(TRIG_PIN, LOW);
-        delayMicroseconds(2);
-        digitalWrite(TRIG_PIN, HIGH);
-        delayMicroseconds(10);
-        digitalWrite(TRIG_PIN, LOW);
-        long duration = pulseIn(ECHO_PIN, HIGH, 30000); // 30ms 超时
-        return duration * 0.034 / 2;
-    }
-
-    void setRGB(int r, int g, int b)
-    {
-        analogWrite(RGB_R_PIN, r);
-        analogWrite(RGB_G_PIN, g);
-        analogWrite(RGB_B_PIN, b);
-    }
+    bool firstFrameDone = false;        // 是否已经显示过第一帧
 
     void init()
     {
-        pinMode(TRIG_PIN, OUTPUT);
-        pinMode(ECHO_PIN, INPUT);
+        BootTrace::mark("init");
         pinMode(LDR_PIN, INPUT);
         pinMode(JOY_X_PIN, INPUT);
         pinMode(JOY_Y_PIN, INPUT);
         pinMode(JOY_SW_PIN, INPUT_PULLUP);
         pinMode(POT_PIN, INPUT);
+        joystick.begin(); // 开机时摇杆松开，前 32 个采样用于校准中心
         pinMode(BUZZER_PIN, OUTPUT);
-        pinMode(RGB_R_PIN, OUTPUT);
-        pinMode(RGB_G_PIN, OUTPUT);
-        pinMode(RGB_B_PIN, OUTPUT);
+        Rgb::begin(RGB_R_PIN, RGB_G_PIN, RGB_B_PIN); // 颜色过渡由定时器推进
 
-        dht.begin();
+        dht.begin(DHT_PIN, 1000);
+        if (AdcStream::begin(ADC_PINS, 4, ADC_RATE_HZ))
+        {
+            joyX = AdcStream::subscribe(JOY_X_PIN, 2);
+            joyY = AdcStream::subscribe(JOY_Y_PIN, 2);
+            ldr = AdcStream::subscribe(LDR_PIN, 20);
+            pot = AdcStream::subscribe(POT_PIN, 20);
+        }
+        else
+            Serial.println("连续 ADC 启动失败");
+        Ultrasonic::begin(TRIG_PIN, ECHO_PIN, 20, 5); // 后台 20Hz 测距，5 点中值滤波
         u8g2.begin();
         u8g2.enableUTF8Print();
 
-        // 1. 连接 Wi-Fi 并同步时间
-        u8g2.clearBuffer();
-        u8g2.setFont(u8g2_font_wqy12_t_gb2312);
-        u8g2.setCursor(10, 30);
-        u8g2.print("正在连接 Wi-Fi...");
-        u8g2.sendBuffer();
-
-        WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-        int retry = 0;
-        while (WiFi.status() != WL_CONNECTED && retry < 20)
+        BootTrace::mark("display");
+
+        // Wi-Fi 与 NTP 在后台连接，界面不再等待
+        NetManager::begin(WIFI_SSID, WIFI_PASSWORD, gmtOffset_sec, daylightOffset_sec, ntpServer);
+    }
+
+    void drawHeader(const char *title)
+    {
+        u8g2.setFont(FONT_WQY12);
+        u8g2.setCursor(0, 12);
+        u8g2.print(title);
+        u8g2.drawLine(0, 15, 128, 15);
+    }
+
+    // 右上角网络状态图标: 信号格表示 Wi-Fi，右上角小方块表示已对时
+    void drawStatusIcon()
+    {
+        NetManager::LinkState link = NetManager::getLinkState();
+        if (link == NetManager::OFFLINE)
         {
-            delay(500);
-            Serial.print(".");
-            retry++;
+            // 未连接: 画一个小叉
+            u8g2.drawLine(117, 3, 123, 9);
+            u8g2.drawLine(117, 9, 123, 3);
         }
+        else if (link == NetManager::CONNECTED || (millis() / 500) % 2 == 0)
+        {
+            // 已连接常亮，连接中闪烁
+            u8g2.drawBox(117, 9, 2, 3);
+            u8g2.drawBox(120, 6, 2, 6);
+            u8g2.drawBox(123, 3, 2, 9);
+        }
+
+        if (NetManager::isTimeSynced())
+            u8g2.drawBox(126, 0, 2, 2);
+    }
+
+    // 1. 菜单选择 (摇杆左/上为上一页，右/下为下一页，推住时自动加速翻页)
+    void pollInput()
+    {
+        Profiler::pollSerial(Serial);
+
+        if (joyX != nullptr)
+        {
+            joyXVal = joyX->latest(joyXVal);
+            joyYVal = joyY->latest(joyYVal);
+        }
+        joystick.feed(micros(), joyXVal, joyYVal, digitalRead(JOY_SW_PIN) == LOW);
 
-        if (WiFi.status() == WL_CONNECTED)
+        Joystick::Event e;
+        while (joystick.poll(&e))
         {
-            configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
-            u8g2.setCursor(10, 50);
-            u8g2.print("时间同步成功!");
+            if (e.type == Joystick::MOVE)
+            {
+                bool back = e.dir == Joystick::LEFT || e.dir == Joystick::UP;
+                currentMenu = (currentMenu + (back ? MENU_COUNT - 1 : 1)) % MENU_COUNT;
+            }
+            else if (e.type == Joystick::PRESS && currentMenu == 4)
+            {
+                // 趋势页中按下摇杆切换 1 小时 / 24 小时
+                trendTier = trendTier == HubHistory::MID ? HubHistory::LONG : HubHistory::MID;
+            }
+        }
+    }
+
+    // 2. 传感器采样与报警逻辑，结果发布到 latest
+    void sense()
+    {
+        Snapshot snap;
+        {
+            PROFILE_SCOPE("hub.dht");
+            Dht11::Reading reading = dht.read(); // 读取缓存结果，不阻塞
+            // 还没有成功读取过时为 NAN，界面显示 "--"，不把 0 当作读数
+            snap.temp = reading.valid ? reading.temperature : NAN;
+            snap.hum = reading.valid ? reading.humidity : NAN;
+        }
+        {
+            PROFILE_SCOPE("hub.ultrasonic");
+            snap.dist = Ultrasonic::getDistance(); // 读取后台测距结果，不阻塞
+        }
+
+        if (ldr != nullptr)
+        {
+            PROFILE_SCOPE("hub.adc");
+            ldrVal = ldr->latest(ldrVal, true); // 上次采样以来的平均值
+            potVal = pot->latest(potVal, true);
+        }
+        snap.light = ldrVal;
+        // 电位器映射为报警距离 (5cm - 100cm)
+        snap.alarmThreshold = map(potVal, 0, 4095, 5, 100);
+
+        // 自动安防逻辑
+        if (snap.dist > 0 && snap.dist < snap.alarmThreshold)
+        { // 距离小于阈值报警
+            snap.alarmActive = true;
+            digitalWrite(BUZZER_PIN, HIGH);
+            Rgb::strobe(Rgb::ALARM);
         }
         else
         {
-            u8g2.setCursor(10, 50);
-            u8g2.print("Wi-Fi 连接失败");
+            snap.alarmActive = false;
+            digitalWrite(BUZZER_PIN, LOW);
+            Rgb::fadeTo(snap.light < 1000 ? Rgb::GREEN : Rgb::BLUE); // 根据光照变色
         }
-        u8g2.sendBuffer();
-        delay(1000);
 
-        // 2. 启动动画
-        for (int i = 0; i <= 100; i += 10)
+        latest.write(snap);
+    }
+
+    // 采集任务 (core 0): 每 500ms 采样一次并发布快照
+    void acquireTask(void *)
+    {
+        TickType_t wake = xTaskGetTickCount();
+        for (;;)
         {
-            u8g2.clearBuffer();
-            u8g2.setFont(u8g2_font_wqy12_t_gb2312);
-            u8g2.setCursor(30, 30);
-            u8g2.print("X-Center 系统");
-            u8g2.drawFrame(20, 45, 88, 8);
-            u8g2.drawBox(22, 47, i * 0.84, 4);
-            u8g2.sendBuffer();
-            delay(50);
+            sense();
+            vTaskDelayUntil(&wake, pdMS_TO_TICKS(500));
         }
     }
 
-    void drawHeader(const char *title)
+    // 取出最新快照，渲染期间使用同一份数据
+    void loadSnapshot()
     {
-        u8g2.setFont(u8g2_font_wqy12_t_gb2312);
-        u8g2.setCursor(0, 12);
-        u8g2.print(title);
-        u8g2.drawLine(0, 15, 128, 15);
+        Snapshot snap = latest.read();
+        temp = snap.temp;
+        hum = snap.hum;
+        light = snap.light;
+        dist = snap.dist;
+        alarmThreshold = snap.alarmThreshold;
+        alarmActive = snap.alarmActive;
     }
 
-    void update()
+    // 每秒把当前快照写入历史 (落后时按秒补齐，保证时间轴准确)
+    void recordHistory()
+    {
+        if (latest.version() == 0 || isnan(temp) || millis() - lastHistoryTime < 1000)
+            return;
+        lastHistoryTime = millis() - lastHistoryTime > 5000 ? millis() : lastHistoryTime + 1000;
+
+        int16_t values[CH_COUNT];
+        values[CH_TEMP] = (int16_t)(temp * 10);
+        values[CH_HUM] = (int16_t)(hum * 10);
+        values[CH_LIGHT] = (int16_t)light;
+        values[CH_DIST] = (int16_t)dist;
+        history.add(values);
+    }
+
+    // 在 (x, y, w, h) 区域画出一个通道的走势: 每列一条从最小值到最大值的竖线
+    void drawSparkline(int channel, int x, int y, int w, int h)
     {
+        int n = history.size(trendTier);
+        if (n == 0)
+            return;
+        int per = (n + w - 1) / w; // 每列合并的点数
+        int cols = (n + per - 1) / per;
+        int first = n - cols * per; // 最旧的一列可能不满
 
-        // 1. 菜单选择 (通过摇杆 X 轴)
-        int xVal = analogRead(JOY_X_PIN);
-        int yVal = analogRead(JOY_Y_PIN);
-        if (millis() - lastMenuMoveTime > 300) // 300ms 冷却时间，防止菜单飞速切换
+        int lo = INT16_MAX, hi = INT16_MIN;
+        for (int i = 0; i < n; i++)
         {
-            if (xVal < 1000 || yVal < 1000) // 摇杆向左推或上推
-            {
-                currentMenu--;
-                if (currentMenu < 0)
-                    currentMenu = 3;
-                lastMenuMoveTime = millis();
-            }
-            else if (xVal > 3000 || yVal > 3000) // 摇杆向右推或下推
-            {
-                currentMenu++;
-                if (currentMenu > 3)
-                    currentMenu = 0;
-                lastMenuMoveTime = millis();
-            }
+            History::Agg a = history.at(channel, trendTier, i);
+            lo = min(lo, (int)a.min);
+            hi = max(hi, (int)a.max);
         }
+        int range = max(hi - lo, 1);
 
-        // 2. 传感器采样 (每 500ms)
-        if (millis() - lastSenseTime > 500)
+        for (int col = 0; col < cols; col++)
         {
-            lastSenseTime = millis();
-            temp = dht.readTemperature();
-            hum = dht.readHumidity();
-            light = analogRead(LDR_PIN);
-            dist = getDistance();
-
-            // 读取电位器并映射为报警距离 (5cm - 100cm)
-            int potVal = analogRead(POT_PIN);
-            alarmThreshold = map(potVal, 0, 4095, 5, 100);
-
-            // 自动安防逻辑
-            if (dist > 0 && dist < alarmThreshold)
-            { // 距离小于阈值报警
-                alarmActive = true;
-                digitalWrite(BUZZER_PIN, HIGH);
-                setRGB(255, 0, 0);
-            }
-            else
+            int colLo = INT16_MAX, colHi = INT16_MIN;
+            for (int i = max(first + col * per, 0); i < first + (col + 1) * per; i++)
             {
-                alarmActive = false;
-                digitalWrite(BUZZER_PIN, LOW);
-                setRGB(0, 255 * (light < 1000), 255 * (light >= 1000)); // 根据光照变色
+                History::Agg a = history.at(channel, trendTier, i);
+                colLo = min(colLo, (int)a.min);
+                colHi = max(colHi, (int)a.max);
             }
+            int px = x + w - cols + col; // 最新的数据靠右
+            int yTop = y + (h - 1) - (colHi - lo) * (h - 1) / range;
+            int yBottom = y + (h - 1) - (colLo - lo) * (h - 1) / range;
+            u8g2.drawVLine(px, yTop, yBottom - yTop + 1);
         }
+    }
 
-        // 3. 渲染界面
+    void drawTrends()
+    {
+        static const char *labels[CH_COUNT] = {"T", "H", "L", "D"};
+        u8g2.setFont(u8g2_font_5x7_tf);
+        for (int c = 0; c < CH_COUNT; c++)
+        {
+            int y = 17 + c * 12;
+            u8g2.setCursor(0, y + 8);
+            u8g2.print(labels[c]);
+            drawSparkline(c, 8, y, 120, 11);
+        }
+    }
+
+    // 3. 渲染界面
+    void render()
+    {
+        loadSnapshot();
+        recordHistory();
+
+        PROFILE_SCOPE("hub.render");
         u8g2.clearBuffer();
         switch (currentMenu)
         {
@@ -241,24 +378,21 @@ namespace SmartHub
         {
             drawHeader("1. 环境监测");
             u8g2.setCursor(0, 35);
-            u8g2.printf("温度: %.1f C", temp);
+            if (isnan(temp))
+                u8g2.print("温度: -- C");
+            else
+                u8g2.printf("温度: %.1f C", temp);
             u8g2.setCursor(0, 55);
-            u8g2.printf("湿度: %.1f %%", hum);
+            if (isnan(hum))
+                u8g2.print("湿度: -- %");
+            else
+                u8g2.printf("湿度: %.1f %%", hum);
 
-            // 获取并显示当前时间
-            struct tm timeinfo;
+            // 显示当前时间 (缓存的时钟，未对时显示 --:--)
             u8g2.drawCircle(105, 45, 18, U8G2_DRAW_ALL);
             u8g2.setFont(u8g2_font_6x10_tf);
-            if (getLocalTime(&timeinfo))
-            {
-                u8g2.setCursor(92, 48);
-                u8g2.printf("%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-            }
-            else
-            {
-                u8g2.setCursor(92, 48);
-                u8g2.print("--:--");
-            }
+            u8g2.setCursor(92, 48);
+            u8g2.print(TimeService::hhmm());
             break;
         }
 
@@ -297,16 +431,67 @@ namespace SmartHub
             u8g2.setCursor(0, 55);
             u8g2.printf("运行时间: %lu s", millis() / 1000);
             break;
+
+        case 4: // 历史趋势 (按下摇杆切换时间跨度)
+            drawHeader(trendTier == HubHistory::MID ? "5. 趋势 1h" : "5. 趋势 24h");
+            drawTrends();
+            break;
         }
 
+        drawStatusIcon();
+
         // 报警提示
         if (alarmActive)
         {
-            u8g2.setFont(u8g2_font_wqy12_t_gb2312);
-            u8g2.setCursor(80, 12);
+            u8g2.setFont(FONT_WQY12);
+            u8g2.setCursor(72, 12);
             u8g2.print("![警告]");
         }
 
-        u8g2.sendBuffer();
+        {
+            PROFILE_SCOPE("hub.flush");
+            oledFlusher.flush(u8g2);
+        }
+
+        if (!firstFrameDone)
+        {
+            firstFrameDone = true;
+            BootTrace::mark("first_frame");
+            BootTrace::dump(Serial);
+        }
+    }
+
+    void update()
+    {
+        NetManager::update();
+        pollInput();
+
+        // 每 500ms 采样一次，第一帧立即采样; 双核模式下由采集任务负责
+        if (!dualCore && (!firstFrameDone || millis() - lastSenseTime > 500))
+        {
+            lastSenseTime = millis();
+            sense();
+        }
+
+        render();
+    }
+
+    void initDualCore()
+    {
+        init();
+        sense(); // 第一帧就有数据
+        dualCore = true;
+        // loop() 运行在 core 1，采集任务固定在 core 0 (与 Wi-Fi 协议栈同核，优先级低于它)
+        xTaskCreatePinnedToCore(acquireTask, "acquire", 4096, NULL, 1, NULL, 0);
+    }
+
+    void schedule()
+    {
+        init();
+        // 采样截止时间比刷新短，保证第一帧就有数据
+        Scheduler::add("sense", sense, 500, 20, 2);
+        Scheduler::add("input", pollInput, 10, 10, 3); // 摇杆 100Hz 采样，输入延迟不超过 20ms
+        Scheduler::add("frame", render, 33, 33, 1);
+        Scheduler::add("net", NetManager::update, 100, 0, 0);
     }
 }
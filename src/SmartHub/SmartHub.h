@@ -5,6 +5,12 @@ namespace SmartHub
 {
     void init();
     void update();
+
+    // 初始化并在 core 0 启动采集任务，update() 只负责输入和渲染
+    void initDualCore();
+
+    // 初始化并把采样、刷新、联网注册为 Scheduler 任务 (替代 update)
+    void schedule();
 }
 
 #endif
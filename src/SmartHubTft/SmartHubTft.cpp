@@ -3,8 +3,15 @@
 #include <Adafruit_ST7789.h> // Hardware-specific library for ST7789
 #include <U8g2_for_Adafruit_GFX.h>
 #include <SPI.h>
-#include <DHT.h>
 #include "SmartHubTft.h"
+#include "../Dht11/Dht11.h"
+#include "../Profiler/Profiler.h"
+#include "../Telemetry/Telemetry.h"
+#include "../TftField/TftField.h"
+#include "../GlyphCache/GlyphCache.h"
+#include "../FontSubset/FontSubset.h"
+#include "../Gesture/Gesture.h"
+#include "../Rgb/Rgb.h"
 
 /*
 电路图 (TFT 版本):
@@ -77,7 +84,15 @@ namespace SmartHubTft
     // 实例化对象
     Adafruit_ST7789 tft = Adafruit_ST7789(TFT_CS, TFT_DC, TFT_RST);
     U8G2_FOR_ADAFRUIT_GFX u8g2_gfx;
-    DHT dht(DHT_PIN, DHT11);
+    Dht11::Sensor dht; // 后台读取，不关中断
+
+    // 界面字段: 两种模式共用同一组位置，只重画内容变化的部分
+    TftField::Painter painter;
+    GlyphCache::Cache glyphCache; // 已光栅化的 wqy16 字形
+    TftField::Field titleField(40, 30);
+    TftField::Field line1Field(10, 70);
+    TftField::Field line2Field(10, 110);
+    TftField::Field line3Field(10, 150);
 
     // 变量
     float temperature = 0;
@@ -85,35 +100,40 @@ namespace SmartHubTft
     int lightLevel = 0;
     int threshold = 0;
     bool displayMode = 0;        // 0: 环境数据, 1: 系统状态
-    bool needsFullRedraw = true; // 标记是否需要全屏刷新
+    bool needsFullRedraw = true; // 标记是否需要全屏刷新 (只在清除欢迎界面时使用)
+    bool needsRefresh = true;    // 标记是否需要立即刷新 (切换模式时)
     unsigned long lastUpdateTime = 0;
-    unsigned long lastBtnPress = 0;
+    int button = -1; // 手势引擎中的按键编号
+
+    // 二进制遥测: 100ms 一帧 (19 字节)，温湿度沿用最近一次读数，光照和阈值每帧重新采样
+    const unsigned long TELEMETRY_INTERVAL = 100;
+    Telemetry::Writer telemetry;
+    const Telemetry::Format TELEMETRY_FORMAT = Telemetry::BINARY; // 改为 TEXT 输出原来的文本行，便于对比字节数和周期数
+    unsigned long lastTelemetryTime = 0;
 
-    void setRGB(int r, int g, int b)
+    void sendTelemetry()
     {
-        analogWrite(RGB_R_PIN, r);
-        analogWrite(RGB_G_PIN, g);
-        analogWrite(RGB_B_PIN, b);
+        PROFILE_SCOPE("tft.telemetry");
+        telemetry.send(temperature, humidity, analogRead(LDR_PIN), analogRead(POT_PIN), millis());
     }
 
     void init()
     {
-        Serial.println("SmartHubTft 初始化开始...");
+        telemetry.begin(Serial, TELEMETRY_FORMAT);
+        telemetry.printf("SmartHubTft 初始化开始...");
 
         // 引脚模式
         pinMode(LDR_PIN, INPUT);
         pinMode(POT_PIN, INPUT);
-        pinMode(BTN_PIN, INPUT_PULLUP);
+        button = Gesture::attach(BTN_PIN, true, false); // 只用单击，松开即切换
         pinMode(BUZZER_PIN, OUTPUT);
-        pinMode(RGB_R_PIN, OUTPUT);
-        pinMode(RGB_G_PIN, OUTPUT);
-        pinMode(RGB_B_PIN, OUTPUT);
+        Rgb::begin(RGB_R_PIN, RGB_G_PIN, RGB_B_PIN); // 颜色过渡由定时器推进
 
         // 初始化传感器
-        dht.begin();
+        dht.begin(DHT_PIN, 1000);
 
         // 初始化 TFT
-        Serial.println("正在初始化 ST7789 (同步 TftTest 配置)...");
+        telemetry.printf("正在初始化 ST7789 (同步 TftTest 配置)...");
         tft.init(240, 240);      // 使用 TftTest 的默认初始化
         tft.invertDisplay(true); // 使用 TftTest 的反转设置
 
@@ -122,13 +142,17 @@ namespace SmartHubTft
         u8g2_gfx.setFontMode(0);                    // 设置为不透明模式 (0)，避免闪烁
         u8g2_gfx.setBackgroundColor(ST77XX_BLACK);  // 设置字体背景为黑色
         u8g2_gfx.setFontDirection(0);               // 水平
-        u8g2_gfx.setFont(u8g2_font_wqy16_t_gb2312); // 使用 16 像素中文字体
+        u8g2_gfx.setFont(FONT_WQY16); // 使用 16 像素中文字体
+        painter.begin(tft, u8g2_gfx, ST77XX_BLACK);
+        glyphCache.begin(tft);
+        glyphCache.setFont(FONT_WQY16);
+        painter.setGlyphCache(&glyphCache);
 
         delay(200);
         tft.setRotation(0);
 
         // 闪烁测试：确认通信是否正常
-        Serial.println("执行颜色填充测试...");
+        telemetry.printf("执行颜色填充测试...");
         tft.fillScreen(ST77XX_RED);
         delay(500);
         tft.fillScreen(ST77XX_BLACK);
@@ -139,105 +163,104 @@ namespace SmartHubTft
         u8g2_gfx.print("智能管家启动中...");
         u8g2_gfx.setCursor(60, 130);
         u8g2_gfx.print("请稍候...");
-        Serial.println("SmartHubTft 初始化完成");
+        telemetry.printf("SmartHubTft 初始化完成");
         delay(1500);
     }
 
     void update()
     {
-        // 1. 处理按键 (切换显示模式)
-        if (digitalRead(BTN_PIN) == LOW)
+        Profiler::pollSerial(Serial, telemetry.lines()); // 统计以文本帧发送，不破坏遥测流
+
+        // 1. 处理按键 (单击切换显示模式，边沿由中断记录，不会漏掉快速连按)
+        Gesture::Event e;
+        while (Gesture::poll(button, &e))
         {
-            if (millis() - lastBtnPress > 300)
-            { // 消抖
+            if (e.type == Gesture::CLICK)
+            {
                 displayMode = !displayMode;
-                lastBtnPress = millis();
-                needsFullRedraw = true; // 切换模式时标记需要全屏刷新
-                Serial.println("切换显示模式");
+                needsRefresh = true; // 切换模式时立即刷新，不再整屏清除
+                telemetry.printf("切换显示模式");
+                const GlyphCache::Stats &gs = glyphCache.getStats();
+                telemetry.printf("字形缓存: 命中率 %.1f%%, 淘汰 %lu, %.0f us/字符串",
+                              gs.hitRate(), (unsigned long)gs.evictions, gs.usPerString());
             }
         }
 
         // 2. 定时读取传感器 (每 1 秒)
         unsigned long currentTime = millis();
-        if (currentTime - lastUpdateTime >= 1000 || needsFullRedraw)
+        if (currentTime - lastUpdateTime >= 1000 || needsRefresh)
         {
-            if (!needsFullRedraw)
+            if (!needsRefresh)
                 lastUpdateTime = currentTime;
+            needsRefresh = false;
 
-            temperature = dht.readTemperature();
-            humidity = dht.readHumidity();
-            lightLevel = analogRead(LDR_PIN);
-            threshold = analogRead(POT_PIN);
+            {
+                PROFILE_SCOPE("tft.dht");
+                Dht11::Reading reading = dht.read(); // 读取缓存结果，不阻塞
+                if (reading.valid)                   // 第一次读取成功之前保持初始值
+                {
+                    temperature = reading.temperature;
+                    humidity = reading.humidity;
+                }
+            }
+            {
+                PROFILE_SCOPE("tft.adc");
+                lightLevel = analogRead(LDR_PIN);
+                threshold = analogRead(POT_PIN);
+            }
 
             // 3. 逻辑处理：报警与 LED 颜色
             if (lightLevel > threshold)
             {
                 digitalWrite(BUZZER_PIN, HIGH);
-                setRGB(255, 0, 0); // 红色警告
+                Rgb::strobe(Rgb::ALARM); // 红色频闪警告
             }
             else
             {
                 digitalWrite(BUZZER_PIN, LOW);
-                if (temperature < 20)
-                    setRGB(0, 0, 255); // 蓝色 (冷)
-                else if (temperature < 28)
-                    setRGB(0, 255, 0); // 绿色 (舒适)
-                else
-                    setRGB(255, 165, 0); // 橙色 (热)
+                Rgb::fadeTo(Rgb::climate(temperature)); // 冷蓝 / 舒适绿 / 热橙，状态间渐变过渡
             }
 
-            // 4. 刷新 TFT
-            if (needsFullRedraw)
+            // 4. 刷新 TFT (只重画文本变化的字段)
             {
-                tft.fillScreen(ST77XX_BLACK);
-                needsFullRedraw = false;
-            }
-
-            if (displayMode == 0)
-            {
-                // 模式 0: 环境数据
-                u8g2_gfx.setForegroundColor(ST77XX_CYAN);
-                u8g2_gfx.setCursor(40, 30);
-                u8g2_gfx.print("--- 环境监测 ---");
-
-                u8g2_gfx.setForegroundColor(ST77XX_WHITE);
-                u8g2_gfx.setCursor(10, 70);
-                u8g2_gfx.printf("温度: %.1f °C  ", temperature); // 末尾加空格防止残影
-                u8g2_gfx.setCursor(10, 110);
-                u8g2_gfx.printf("湿度: %.1f %%  ", humidity);
-                u8g2_gfx.setCursor(10, 150);
-                u8g2_gfx.printf("光照: %d    ", lightLevel);
-            }
-            else
-            {
-                // 模式 1: 系统状态
-                u8g2_gfx.setForegroundColor(ST77XX_YELLOW);
-                u8g2_gfx.setCursor(40, 30);
-                u8g2_gfx.print("--- 系统状态 ---");
-
-                u8g2_gfx.setForegroundColor(ST77XX_WHITE);
-                u8g2_gfx.setCursor(10, 70);
-                u8g2_gfx.printf("报警阈值: %d    ", threshold);
+                PROFILE_SCOPE("tft.draw");
+                if (needsFullRedraw)
+                {
+                    tft.fillScreen(ST77XX_BLACK);
+                    titleField.invalidate();
+                    line1Field.invalidate();
+                    line2Field.invalidate();
+                    line3Field.invalidate();
+                    needsFullRedraw = false;
+                }
 
-                u8g2_gfx.setCursor(10, 110);
-                if (lightLevel > threshold)
+                if (displayMode == 0)
                 {
-                    u8g2_gfx.setForegroundColor(ST77XX_RED);
-                    u8g2_gfx.print("状态: 警告!  ");
+                    // 模式 0: 环境数据
+                    painter.draw(titleField, ST77XX_CYAN, "--- 环境监测 ---");
+                    painter.draw(line1Field, ST77XX_WHITE, "温度: %.1f °C", temperature);
+                    painter.draw(line2Field, ST77XX_WHITE, "湿度: %.1f %%", humidity);
+                    painter.draw(line3Field, ST77XX_WHITE, "光照: %d", lightLevel);
                 }
                 else
                 {
-                    u8g2_gfx.setForegroundColor(ST77XX_GREEN);
-                    u8g2_gfx.print("状态: 正常  ");
+                    // 模式 1: 系统状态
+                    painter.draw(titleField, ST77XX_YELLOW, "--- 系统状态 ---");
+                    painter.draw(line1Field, ST77XX_WHITE, "报警阈值: %d", threshold);
+                    if (lightLevel > threshold)
+                        painter.draw(line2Field, ST77XX_RED, "状态: 警告!");
+                    else
+                        painter.draw(line2Field, ST77XX_GREEN, "状态: 正常");
+                    painter.draw(line3Field, ST77XX_WHITE, "运行时间: %lu s", millis() / 1000);
                 }
-
-                u8g2_gfx.setForegroundColor(ST77XX_WHITE);
-                u8g2_gfx.setCursor(10, 150);
-                u8g2_gfx.printf("运行时间: %lu s  ", millis() / 1000);
             }
+        }
 
-            // 串口调试
-            Serial.printf("T:%.1f H:%.1f L:%d Th:%d\n", temperature, humidity, lightLevel, threshold);
+        // 5. 遥测 (取代每秒一行的 Serial.printf，用 tools/telemetry2csv.py 转换为 CSV)
+        if (currentTime - lastTelemetryTime >= TELEMETRY_INTERVAL)
+        {
+            lastTelemetryTime = currentTime;
+            sendTelemetry();
         }
     }
 } // namespace SmartHubTft
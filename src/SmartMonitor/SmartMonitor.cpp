@@ -1,8 +1,13 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <U8g2lib.h>
-#include <DHT.h>
 #include "SmartMonitor.h"
+#include "../Dht11/Dht11.h"
+#include "../Profiler/Profiler.h"
+#include "../Telemetry/Telemetry.h"
+#include "../FontSubset/FontSubset.h"
+#include "../Gesture/Gesture.h"
+#include "../Rgb/Rgb.h"
 
 /*
 电路图:
@@ -65,7 +70,7 @@ namespace SmartMonitor
 
     // 实例化对象
     U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/U8X8_PIN_NONE, /* clock=*/22, /* data=*/21);
-    DHT dht(DHT_PIN, DHT11);
+    Dht11::Sensor dht; // 后台读取，不关中断
 
     // 变量
     float temperature = 0;
@@ -74,33 +79,37 @@ namespace SmartMonitor
     int threshold = 0;
     bool displayMode = 0; // 0: 环境数据, 1: 系统状态
     unsigned long lastUpdateTime = 0;
-    unsigned long lastBtnPress = 0;
+    int button = -1; // 手势引擎中的按键编号
 
-    void setRGB(int r, int g, int b)
+    // 二进制遥测: 100ms 一帧 (19 字节)，温湿度沿用最近一次读数，光照和阈值每帧重新采样
+    const unsigned long TELEMETRY_INTERVAL = 100;
+    Telemetry::Writer telemetry;
+    const Telemetry::Format TELEMETRY_FORMAT = Telemetry::BINARY; // 改为 TEXT 输出原来的文本行，便于对比字节数和周期数
+    unsigned long lastTelemetryTime = 0;
+
+    void sendTelemetry()
     {
-        analogWrite(RGB_R_PIN, r);
-        analogWrite(RGB_G_PIN, g);
-        analogWrite(RGB_B_PIN, b);
+        PROFILE_SCOPE("mon.telemetry");
+        telemetry.send(temperature, humidity, analogRead(LDR_PIN), analogRead(POT_PIN), millis());
     }
 
     void init()
     {
-        Serial.println("SmartMonitor 初始化...");
+        telemetry.begin(Serial, TELEMETRY_FORMAT);
+        telemetry.printf("SmartMonitor 初始化...");
 
         // 引脚模式
         pinMode(LDR_PIN, INPUT);
         pinMode(POT_PIN, INPUT);
-        pinMode(BTN_PIN, INPUT_PULLUP);
+        button = Gesture::attach(BTN_PIN, true, false); // 只用单击，松开即切换
         pinMode(BUZZER_PIN, OUTPUT);
-        pinMode(RGB_R_PIN, OUTPUT);
-        pinMode(RGB_G_PIN, OUTPUT);
-        pinMode(RGB_B_PIN, OUTPUT);
+        Rgb::begin(RGB_R_PIN, RGB_G_PIN, RGB_B_PIN); // 颜色过渡由定时器推进
 
         // 初始化传感器
-        dht.begin();
+        dht.begin(DHT_PIN, 1000);
         u8g2.begin();
         u8g2.enableUTF8Print();
-        u8g2.setFont(u8g2_font_wqy12_t_gb2312);
+        u8g2.setFont(FONT_WQY12);
 
         // 欢迎界面
         u8g2.clearBuffer();
@@ -112,14 +121,16 @@ namespace SmartMonitor
 
     void update()
     {
-        // 1. 处理按键 (切换显示模式)
-        if (digitalRead(BTN_PIN) == LOW)
+        Profiler::pollSerial(Serial, telemetry.lines()); // 统计以文本帧发送，不破坏遥测流
+
+        // 1. 处理按键 (单击切换显示模式，边沿由中断记录，不会漏掉快速连按)
+        Gesture::Event e;
+        while (Gesture::poll(button, &e))
         {
-            if (millis() - lastBtnPress > 300)
-            { // 消抖
+            if (e.type == Gesture::CLICK)
+            {
                 displayMode = !displayMode;
-                lastBtnPress = millis();
-                Serial.println("切换显示模式");
+                telemetry.printf("切换显示模式");
             }
         }
 
@@ -129,60 +140,75 @@ namespace SmartMonitor
         {
             lastUpdateTime = currentTime;
 
-            temperature = dht.readTemperature();
-            humidity = dht.readHumidity();
-            lightLevel = analogRead(LDR_PIN);
-            threshold = analogRead(POT_PIN);
+            {
+                PROFILE_SCOPE("mon.dht");
+                Dht11::Reading reading = dht.read(); // 读取缓存结果，不阻塞
+                if (reading.valid)                   // 第一次读取成功之前保持初始值
+                {
+                    temperature = reading.temperature;
+                    humidity = reading.humidity;
+                }
+            }
+            {
+                PROFILE_SCOPE("mon.adc");
+                lightLevel = analogRead(LDR_PIN);
+                threshold = analogRead(POT_PIN);
+            }
 
             // 3. 逻辑处理：报警与 LED 颜色
             // 报警逻辑：如果光线太暗 (LDR 值大) 且超过电位器设定的阈值
             if (lightLevel > threshold)
             {
                 digitalWrite(BUZZER_PIN, HIGH);
-                setRGB(255, 0, 0); // 红色警告
+                Rgb::strobe(Rgb::ALARM); // 红色频闪警告
             }
             else
             {
                 digitalWrite(BUZZER_PIN, LOW);
                 // 根据温度显示颜色
-                if (temperature < 20)
-                    setRGB(0, 0, 255); // 蓝色 (冷)
-                else if (temperature < 28)
-                    setRGB(0, 255, 0); // 绿色 (舒适)
-                else
-                    setRGB(255, 165, 0); // 橙色 (热)
+                Rgb::fadeTo(Rgb::climate(temperature)); // 冷蓝 / 舒适绿 / 热橙，状态间渐变过渡
             }
 
             // 4. 刷新 OLED
-            u8g2.clearBuffer();
-            if (displayMode == 0)
             {
-                // 模式 0: 环境数据
-                u8g2.setCursor(0, 12);
-                u8g2.print("--- 环境监测 ---");
-                u8g2.setCursor(0, 30);
-                u8g2.printf("温度: %.1f °C", temperature);
-                u8g2.setCursor(0, 45);
-                u8g2.printf("湿度: %.1f %%", humidity);
-                u8g2.setCursor(0, 60);
-                u8g2.printf("光照: %d", lightLevel);
+                PROFILE_SCOPE("mon.render");
+                u8g2.clearBuffer();
+                if (displayMode == 0)
+                {
+                    // 模式 0: 环境数据
+                    u8g2.setCursor(0, 12);
+                    u8g2.print("--- 环境监测 ---");
+                    u8g2.setCursor(0, 30);
+                    u8g2.printf("温度: %.1f °C", temperature);
+                    u8g2.setCursor(0, 45);
+                    u8g2.printf("湿度: %.1f %%", humidity);
+                    u8g2.setCursor(0, 60);
+                    u8g2.printf("光照: %d", lightLevel);
+                }
+                else
+                {
+                    // 模式 1: 系统状态
+                    u8g2.setCursor(0, 12);
+                    u8g2.print("--- 系统状态 ---");
+                    u8g2.setCursor(0, 30);
+                    u8g2.printf("报警阈值: %d", threshold);
+                    u8g2.setCursor(0, 45);
+                    u8g2.print(lightLevel > threshold ? "状态: 警告!" : "状态: 正常");
+                    u8g2.setCursor(0, 60);
+                    u8g2.printf("运行时间: %lu s", millis() / 1000);
+                }
             }
-            else
             {
-                // 模式 1: 系统状态
-                u8g2.setCursor(0, 12);
-                u8g2.print("--- 系统状态 ---");
-                u8g2.setCursor(0, 30);
-                u8g2.printf("报警阈值: %d", threshold);
-                u8g2.setCursor(0, 45);
-                u8g2.print(lightLevel > threshold ? "状态: 警告!" : "状态: 正常");
-                u8g2.setCursor(0, 60);
-                u8g2.printf("运行时间: %lu s", millis() / 1000);
+                PROFILE_SCOPE("mon.send");
+                u8g2.sendBuffer();
             }
-            u8g2.sendBuffer();
+        }
 
-            // 串口调试
-            Serial.printf("T:%.1f H:%.1f L:%d Th:%d\n", temperature, humidity, lightLevel, threshold);
+        // 5. 遥测 (取代每秒一行的 Serial.printf，用 tools/telemetry2csv.py 转换为 CSV)
+        if (currentTime - lastTelemetryTime >= TELEMETRY_INTERVAL)
+        {
+            lastTelemetryTime = currentTime;
+            sendTelemetry();
         }
     }
 } // namespace SmartMonitor
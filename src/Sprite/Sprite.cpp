@@ -0,0 +1,81 @@
+#include <Arduino.h>
+#include "Sprite.h"
+#include "../TftDma/TftDma.h"
+
+namespace Sprite
+{
+    // 场景函数没有上下文参数，合成时通过这两个变量找到当前精灵
+    Stage *composing = nullptr;
+    int composingItem = 0;
+
+    void Stage::begin(TftDma::Renderer &r, TftDma::SceneFn bg)
+    {
+        renderer = &r;
+        background = bg;
+        renderer->render(background);
+        renderer->flush();
+    }
+
+    int Stage::add(int x, int y, int w, int h, DrawFn draw, int frame)
+    {
+        if (renderer == nullptr || count >= MAX_SPRITES)
+            return -1;
+        uint16_t *pixels = (uint16_t *)malloc(w * h * 2);
+        if (pixels == nullptr)
+            return -1;
+        renderer->capture(background, x, y, w, h, pixels);
+
+        Item &item = items[count];
+        item.x = x;
+        item.y = y;
+        item.w = w;
+        item.h = h;
+        item.draw = draw;
+        item.frame = frame;
+        item.shown = -1;
+        item.background = pixels;
+        return count++;
+    }
+
+    void Stage::setFrame(int id, int frame)
+    {
+        if (id >= 0 && id < count)
+            items[id].frame = frame;
+    }
+
+    void Stage::compose(Adafruit_GFX &gfx)
+    {
+        Item &item = composing->items[composingItem];
+        composing->renderer->blit(item.x, item.y, item.w, item.h, item.background);
+        item.draw(gfx, item.x, item.y, item.frame);
+    }
+
+    bool Stage::update()
+    {
+        uint32_t start = micros();
+        uint32_t bytesBefore = renderer->getStats().bytes;
+        bool sent = false;
+
+        composing = this;
+        for (int i = 0; i < count; i++)
+        {
+            Item &item = items[i];
+            if (item.frame == item.shown)
+                continue;
+            composingItem = i;
+            renderer->render(compose, item.x, item.y, item.w, item.h);
+            item.shown = item.frame;
+            sent = true;
+        }
+        composing = nullptr;
+
+        if (sent)
+        {
+            renderer->flush();
+            stats.frames++;
+            stats.lastBytes = renderer->getStats().bytes - bytesBefore;
+            stats.lastUs = micros() - start;
+        }
+        return sent;
+    }
+} // namespace Sprite
@@ -0,0 +1,126 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdint.h>
+#include <string.h>
+
+class Adafruit_GFX;
+
+namespace TftDma
+{
+    class Renderer;
+    typedef void (*SceneFn)(Adafruit_GFX &gfx);
+}
+
+namespace Sprite
+{
+    const int MAX_SPRITES = 8;
+
+    // 时间轴上的一个关键帧: 显示 frame 持续 durationMs
+    struct Key
+    {
+        uint16_t durationMs;
+        uint8_t frame;
+    };
+
+    // 循环播放的一条轨道，由 loop() 里的 millis() 推进，不阻塞
+    // 不依赖 Arduino，主机上可以用假的时间验证切换时刻。
+    class Track
+    {
+    public:
+        Track(const Key *keys, int count) : keys(keys), count(count)
+        {
+            for (int i = 0; i < count; i++)
+                cycleMs += keys[i].durationMs;
+        }
+
+        void start(uint32_t nowMs)
+        {
+            index = 0;
+            since = nowMs;
+        }
+
+        // 推进到 nowMs，返回 true 表示切换过关键帧
+        bool advance(uint32_t nowMs)
+        {
+            if (cycleMs == 0)
+                return false;
+            // 停顿太久时直接跳过整圈，避免逐帧追赶
+            uint32_t elapsed = nowMs - since;
+            if (elapsed >= cycleMs)
+                since += elapsed - elapsed % cycleMs;
+
+            bool changed = false;
+            while (nowMs - since >= keys[index].durationMs)
+            {
+                since += keys[index].durationMs;
+                index = (index + 1) % count;
+                changed = true;
+            }
+            return changed;
+        }
+
+        int frame() const { return keys[index].frame; }
+
+    private:
+        const Key *keys;
+        int count;
+        uint32_t cycleMs = 0;
+        int index = 0;
+        uint32_t since = 0;
+    };
+
+    // 精灵绘制函数: (x, y) 为精灵区域左上角，只能画在 add() 声明的区域内
+    typedef void (*DrawFn)(Adafruit_GFX &gfx, int x, int y, int frame);
+
+    struct Stats
+    {
+        uint32_t frames;    // 实际发送过像素的 update 次数
+        uint32_t lastBytes; // 最近一帧发送的像素字节数 (整屏为 115200)
+        uint32_t lastUs;    // 最近一帧从合成到 DMA 发送完毕的时间
+
+        // 按最近一帧的耗时估算可达到的帧率
+        float maxFps() const { return lastUs ? 1000000.0f / lastUs : 0; }
+    };
+
+    // 精灵层: 静态背景整屏渲染一次，每个精灵区域下的背景缓存在内存中，
+    // 帧变化时只把该区域 (缓存背景 + 精灵) 合成后通过 DMA 发送。
+    // 精灵区域之间不能重叠。
+    class Stage
+    {
+    public:
+        // 渲染整屏背景
+        void begin(TftDma::Renderer &renderer, TftDma::SceneFn background);
+
+        // 添加精灵并缓存其区域下的背景，返回编号; 数量已满或内存不足时返回 -1
+        int add(int x, int y, int w, int h, DrawFn draw, int frame = 0);
+
+        // 切换精灵的帧，与当前显示的不同时该区域变脏
+        void setFrame(int id, int frame);
+
+        // 发送所有脏区域，返回是否发送过像素
+        bool update();
+
+        const Stats &getStats() const { return stats; }
+
+    private:
+        struct Item
+        {
+            int16_t x, y, w, h;
+            DrawFn draw;
+            int frame;
+            int shown; // 屏幕上当前的帧，-1 表示还没画过
+            uint16_t *background;
+        };
+
+        static void compose(Adafruit_GFX &gfx);
+
+        TftDma::Renderer *renderer = nullptr;
+        TftDma::SceneFn background = nullptr;
+        Item items[MAX_SPRITES] = {};
+        int count = 0;
+        Stats stats = {};
+    };
+} // namespace Sprite
+
+#endif
@@ -0,0 +1,115 @@
+#include <Arduino.h>
+#include "Telemetry.h"
+
+namespace Telemetry
+{
+    // Writer::lines() 返回的适配器: 收集一行文本，遇到换行时发送 (去掉 \r，空行不发送)
+    class LinePrint : public Print
+    {
+    public:
+        using Print::write;
+
+        size_t write(uint8_t c) override
+        {
+            if (c == '\n')
+            {
+                if (len > 0 && writer != nullptr)
+                {
+                    line[len] = 0;
+                    writer->printf("%s", line);
+                }
+                len = 0;
+            }
+            else if (c != '\r' && len < MAX_TEXT)
+                line[len++] = c;
+            return 1;
+        }
+
+        Writer *writer = nullptr;
+        char line[MAX_TEXT + 1];
+        int len = 0;
+    };
+
+    LinePrint linePrint;
+
+    void Writer::begin(Print &port, Format f)
+    {
+        out = &port;
+        format = f;
+    }
+
+    bool Writer::write(const uint8_t *data, int len)
+    {
+        if (out == nullptr || out->availableForWrite() < len)
+            return false;
+        out->write(data, len);
+        return true;
+    }
+
+    bool Writer::send(float temp, float hum, int light, int threshold, uint32_t timestamp)
+    {
+        uint32_t start = ESP.getCycleCount();
+        uint16_t n = seq++; // 丢弃的帧也占用序号，接收端据此统计丢帧
+
+        uint8_t frame[MAX_FRAME_SIZE];
+        int len;
+        if (format == TEXT)
+        {
+            len = snprintf((char *)frame, sizeof(frame), "T:%.1f H:%.1f L:%d Th:%d\n", temp, hum, light, threshold);
+            if (len >= (int)sizeof(frame))
+                len = sizeof(frame) - 1;
+        }
+        else
+        {
+            EnvRecord r;
+            r.seq = n;
+            r.timestamp = timestamp;
+            r.temp10 = (int16_t)lroundf(temp * 10);
+            r.hum10 = (uint16_t)lroundf(hum * 10);
+            r.light = light;
+            r.threshold = threshold;
+            len = encode(r, frame);
+        }
+
+        if (!write(frame, len))
+        {
+            stats.dropped++;
+            return false;
+        }
+        stats.sent++;
+        stats.bytes += len;
+        stats.cycles += ESP.getCycleCount() - start;
+        return true;
+    }
+
+    bool Writer::printf(const char *fmt, ...)
+    {
+        char text[MAX_TEXT + 2];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(text, MAX_TEXT + 1, fmt, args);
+        va_end(args);
+        if (n < 0)
+            return false;
+        if (n > MAX_TEXT)
+            n = MAX_TEXT;
+
+        if (format == TEXT)
+        {
+            text[n++] = '\n';
+            return write((const uint8_t *)text, n);
+        }
+        uint8_t frame[MAX_FRAME_SIZE];
+        return write(frame, encodeText(text, frame));
+    }
+
+    Print &Writer::lines()
+    {
+        if (linePrint.writer != this)
+        {
+            linePrint.writer = this;
+            linePrint.len = 0;
+        }
+        return linePrint;
+    }
+} // namespace Telemetry
@@ -0,0 +1,282 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <string.h>
+
+class Print;
+
+namespace Telemetry
+{
+    /*
+    帧格式: COBS(负载 + CRC16) + 0x00 分隔符
+    COBS 编码后数据中不会出现 0x00，接收方丢字节后遇到下一个 0x00 即可重新同步。
+
+    RECORD_ENV 负载 (小端，固定 15 字节):
+        0  uint8   类型 (RECORD_ENV)
+        1  uint16  序号 (每帧加 1，用来发现丢帧)
+        3  uint32  时间戳 (millis)
+        7  int16   温度 x10
+        9  uint16  湿度 x10
+        11 uint16  光照 ADC
+        13 uint16  阈值 ADC
+
+    RECORD_TEXT 负载 (1 - 1 + MAX_TEXT 字节):
+        0  uint8   类型 (RECORD_TEXT)
+        1  char[]  UTF-8 文本，不含结尾的 0
+    模块的状态提示走同一个串口时以文本帧发送，不会破坏记录流。
+    */
+    const uint8_t RECORD_ENV = 1;
+    const uint8_t RECORD_TEXT = 2;
+    const int PAYLOAD_SIZE = 15;
+    const int RAW_SIZE = PAYLOAD_SIZE + 2;  // 负载 + CRC16
+    const int FRAME_SIZE = RAW_SIZE + 2;    // COBS 开销 1 字节 + 分隔符 1 字节
+    const int MAX_TEXT = 64;                // 文本帧最多携带的字节数，超出部分截断
+    const int MAX_FRAME_SIZE = 1 + MAX_TEXT + 2 + 2;
+
+    struct EnvRecord
+    {
+        uint16_t seq;
+        uint32_t timestamp;
+        int16_t temp10;
+        uint16_t hum10;
+        uint16_t light;
+        uint16_t threshold;
+    };
+
+    // CRC-16/CCITT-FALSE (多项式 0x1021，初值 0xFFFF)
+    inline uint16_t crc16(const uint8_t *data, int len)
+    {
+        uint16_t crc = 0xFFFF;
+        for (int i = 0; i < len; i++)
+        {
+            crc ^= (uint16_t)data[i] << 8;
+            for (int b = 0; b < 8; b++)
+                crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+        return crc;
+    }
+
+    // COBS 编码 (len < 254)，out 至少 len + 1 字节，返回编码后的长度 (不含分隔符)
+    inline int cobsEncode(const uint8_t *in, int len, uint8_t *out)
+    {
+        int code = 0; // 当前块长度字节的位置
+        int o = 1;
+        for (int i = 0; i < len; i++)
+        {
+            if (in[i] == 0)
+            {
+                out[code] = o - code;
+                code = o++;
+            }
+            else
+            {
+                out[o++] = in[i];
+            }
+        }
+        out[code] = o - code;
+        return o;
+    }
+
+    // COBS 解码，返回解码后的长度; 数据不合法时返回 -1
+    inline int cobsDecode(const uint8_t *in, int len, uint8_t *out)
+    {
+        int o = 0;
+        int i = 0;
+        while (i < len)
+        {
+            int code = in[i++];
+            if (code == 0 || i + code - 1 > len)
+                return -1;
+            for (int k = 1; k < code; k++)
+                out[o++] = in[i++];
+            if (i < len)
+                out[o++] = 0;
+        }
+        return o;
+    }
+
+    inline void put16(uint8_t *p, uint16_t v)
+    {
+        p[0] = v;
+        p[1] = v >> 8;
+    }
+
+    inline void put32(uint8_t *p, uint32_t v)
+    {
+        put16(p, v);
+        put16(p + 2, v >> 16);
+    }
+
+    inline uint16_t get16(const uint8_t *p)
+    {
+        return p[0] | (uint16_t)p[1] << 8;
+    }
+
+    inline uint32_t get32(const uint8_t *p)
+    {
+        return get16(p) | (uint32_t)get16(p + 2) << 16;
+    }
+
+    // raw 前 len 字节为负载，追加 CRC16 后编码为完整帧 (含末尾 0x00)，返回帧长度
+    // raw 需要多留 2 字节放 CRC
+    inline int seal(uint8_t *raw, int len, uint8_t *frame)
+    {
+        put16(raw + len, crc16(raw, len));
+        int n = cobsEncode(raw, len + 2, frame);
+        frame[n++] = 0;
+        return n;
+    }
+
+    // 编码一条记录为完整帧，返回帧长度 (FRAME_SIZE)
+    inline int encode(const EnvRecord &r, uint8_t *frame)
+    {
+        uint8_t raw[RAW_SIZE];
+        raw[0] = RECORD_ENV;
+        put16(raw + 1, r.seq);
+        put32(raw + 3, r.timestamp);
+        put16(raw + 7, (uint16_t)r.temp10);
+        put16(raw + 9, r.hum10);
+        put16(raw + 11, r.light);
+        put16(raw + 13, r.threshold);
+        return seal(raw, PAYLOAD_SIZE, frame);
+    }
+
+    // 编码文本帧，frame 至少 MAX_FRAME_SIZE 字节; 返回帧长度
+    inline int encodeText(const char *text, uint8_t *frame)
+    {
+        uint8_t raw[1 + MAX_TEXT + 2];
+        raw[0] = RECORD_TEXT;
+        int len = 0;
+        while (len < MAX_TEXT && text[len] != 0)
+        {
+            raw[1 + len] = text[len];
+            len++;
+        }
+        return seal(raw, 1 + len, frame);
+    }
+
+    // 流式解码器: 逐字节喂入，遇到分隔符时校验并解出一条记录
+    // 不依赖 Arduino，主机端转换工具可以直接使用。
+    class Decoder
+    {
+    public:
+        enum Result
+        {
+            NONE,   // 帧未结束
+            RECORD, // 解出一条记录
+            TEXT,   // 解出一条文本，用 text() 取出
+            ERROR   // 帧长度、COBS 或 CRC 错误，已丢弃
+        };
+
+        Result feed(uint8_t b, EnvRecord &out)
+        {
+            if (b != 0)
+            {
+                if (len < (int)sizeof(buf))
+                    buf[len] = b;
+                len++;
+                return NONE;
+            }
+
+            int n = len;
+            len = 0;
+            if (n == 0)
+                return NONE;
+            if (n > MAX_FRAME_SIZE - 1)
+                return fail();
+
+            uint8_t raw[MAX_FRAME_SIZE];
+            int m = cobsDecode(buf, n, raw);
+            if (m < 3 || get16(raw + m - 2) != crc16(raw, m - 2))
+                return fail();
+            if (raw[0] == RECORD_TEXT)
+            {
+                memcpy(textBuf, raw + 1, m - 3);
+                textBuf[m - 3] = 0;
+                texts++;
+                return TEXT;
+            }
+            if (raw[0] != RECORD_ENV || m != RAW_SIZE)
+                return fail();
+
+            out.seq = get16(raw + 1);
+            out.timestamp = get32(raw + 3);
+            out.temp10 = (int16_t)get16(raw + 7);
+            out.hum10 = get16(raw + 9);
+            out.light = get16(raw + 11);
+            out.threshold = get16(raw + 13);
+            if (frames > 0)
+                lost += (uint16_t)(out.seq - lastSeq - 1);
+            lastSeq = out.seq;
+            frames++;
+            return RECORD;
+        }
+
+        uint32_t frameCount() const { return frames; }
+        uint32_t textCount() const { return texts; }
+        uint32_t errorCount() const { return errors; }
+        uint32_t lostCount() const { return lost; } // 根据序号推算的丢帧数
+        const char *text() const { return textBuf; } // 最近一条文本
+
+    private:
+        Result fail()
+        {
+            errors++;
+            return ERROR;
+        }
+
+        uint8_t buf[MAX_FRAME_SIZE];
+        int len = 0;
+        uint16_t lastSeq = 0;
+        uint32_t frames = 0;
+        uint32_t texts = 0;
+        uint32_t errors = 0;
+        uint32_t lost = 0;
+        char textBuf[MAX_TEXT + 1] = {0};
+    };
+
+    // 输出格式: TEXT 为原来每行一条的 printf 文本，可以直接在串口监视器中查看
+    enum Format
+    {
+        BINARY,
+        TEXT
+    };
+
+    struct Stats
+    {
+        uint32_t sent;    // 已写入的记录数
+        uint32_t dropped; // 发送缓冲放不下而丢弃的记录数
+        uint32_t bytes;   // 记录占用的串口字节数
+        uint32_t cycles;  // 记录的格式化与写入串口的累计 CPU 周期
+    };
+
+    // 发送端: 串口发送缓冲放不下整帧时直接丢弃并计数，永不阻塞
+    class Writer
+    {
+    public:
+        void begin(Print &port, Format format = BINARY);
+
+        // 返回是否已写入
+        bool send(float temp, float hum, int light, int threshold, uint32_t timestamp);
+
+        // 状态提示: BINARY 格式下以文本帧发送，TEXT 格式下输出一行文本
+        bool printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+        // 按行转发给 printf() 的 Print，给 Profiler::dump() 这类只接受 Print 的输出使用;
+        // BINARY 格式下每行成为一个文本帧，不会把纯文本混进记录流。每行最多 MAX_TEXT 字节
+        Print &lines();
+
+        const Stats &getStats() const { return stats; }
+
+    private:
+        bool write(const uint8_t *data, int len);
+
+        Print *out = nullptr;
+        Format format = BINARY;
+        uint16_t seq = 0;
+        Stats stats = {};
+    };
+} // namespace Telemetry
+
+#endif
@@ -0,0 +1,352 @@
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "TftDma.h"
+
+/*
+双缓冲条带渲染:
+    CPU:  [光栅化条带 0] [光栅化条带 1] [等待缓冲 0] [光栅化条带 2] ...
+    DMA:                 [发送条带 0  ] [发送条带 1             ] ...
+整屏 240x240 分成 12 个 240x20 条带，每个条带光栅化时完整执行一次场景函数，
+超出条带的像素直接裁剪。所有事务 (命令 + 像素) 都走同一个 SPI 队列，按顺序执行。
+*/
+
+namespace TftDma
+{
+    const uint8_t CMD_SWRESET = 0x01;
+    const uint8_t CMD_SLPOUT = 0x11;
+    const uint8_t CMD_NORON = 0x13;
+    const uint8_t CMD_INVON = 0x21;
+    const uint8_t CMD_DISPON = 0x29;
+    const uint8_t CMD_CASET = 0x2A;
+    const uint8_t CMD_RASET = 0x2B;
+    const uint8_t CMD_RAMWR = 0x2C;
+    const uint8_t CMD_MADCTL = 0x36;
+    const uint8_t CMD_COLMOD = 0x3A;
+
+    // 与 Adafruit_ST7789::setRotation(0) 在 240x240 屏上的设置相同:
+    // MX | MY | RGB，控制器显存为 240x320，可见区域从第 80 行开始
+    const uint8_t MADCTL_ROTATION_0 = 0xC0;
+    const int COL_OFFSET = 0;
+    const int ROW_OFFSET = 80;
+
+    // user 字段: bit0 为 DC 电平 (0 命令 / 1 数据)
+    const uintptr_t USER_DATA = 1;
+
+    int dcPin = -1;
+
+    // 每个事务开始前设置 DC 引脚 (在 SPI 中断中执行)
+    void IRAM_ATTR handle_pre_transfer(spi_transaction_t *t)
+    {
+        gpio_set_level((gpio_num_t)dcPin, (uintptr_t)t->user & USER_DATA);
+    }
+
+    // ST7789 需要高字节在前
+    inline uint16_t swap16(uint16_t c)
+    {
+        return (c >> 8) | (c << 8);
+    }
+
+    bool Renderer::begin(int sclk, int mosi, int cs, int dc, int rst, bool invert)
+    {
+        dcPin = dc;
+        pinMode(dc, OUTPUT);
+        if (rst >= 0)
+        {
+            pinMode(rst, OUTPUT);
+            digitalWrite(rst, LOW);
+            delay(10);
+            digitalWrite(rst, HIGH);
+            delay(120);
+        }
+
+        spi_bus_config_t bus = {};
+        bus.sclk_io_num = sclk;
+        bus.mosi_io_num = mosi;
+        bus.miso_io_num = -1;
+        bus.quadwp_io_num = -1;
+        bus.quadhd_io_num = -1;
+        bus.max_transfer_sz = BUFFER_PIXELS * 2;
+        if (spi_bus_initialize(SPI3_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK)
+            return false;
+
+        spi_device_interface_config_t cfg = {};
+        cfg.clock_speed_hz = 40 * 1000 * 1000;
+        cfg.mode = 0; // 与 Adafruit_ST7789 默认的 SPI_MODE0 一致
+        cfg.spics_io_num = cs;
+        cfg.queue_size = 2 * TRANS_PER_BAND;
+        cfg.pre_cb = handle_pre_transfer;
+        if (spi_bus_add_device(SPI3_HOST, &cfg, &dev) != ESP_OK)
+            return false;
+
+        for (int i = 0; i < 2; i++)
+        {
+            buffers[i] = (uint16_t *)heap_caps_malloc(BUFFER_PIXELS * 2, MALLOC_CAP_DMA);
+            if (buffers[i] == nullptr)
+                return false;
+        }
+
+        command(CMD_SWRESET, nullptr, 0);
+        delay(150);
+        command(CMD_SLPOUT, nullptr, 0);
+        delay(10);
+        uint8_t colmod = 0x55; // 16 位 RGB565
+        command(CMD_COLMOD, &colmod, 1);
+        uint8_t madctl = MADCTL_ROTATION_0;
+        command(CMD_MADCTL, &madctl, 1);
+        if (invert)
+            command(CMD_INVON, nullptr, 0);
+        command(CMD_NORON, nullptr, 0);
+        command(CMD_DISPON, nullptr, 0);
+        delay(10);
+
+        windowStart = micros();
+        return true;
+    }
+
+    // 初始化阶段使用的阻塞命令
+    void Renderer::command(uint8_t cmd, const uint8_t *data, int len)
+    {
+        spi_transaction_t t = {};
+        t.length = 8;
+        t.flags = SPI_TRANS_USE_TXDATA;
+        t.tx_data[0] = cmd;
+        t.user = (void *)0;
+        spi_device_transmit(dev, &t);
+
+        if (len > 0)
+        {
+            spi_transaction_t d = {};
+            d.length = len * 8;
+            d.tx_buffer = data;
+            d.user = (void *)USER_DATA;
+            spi_device_transmit(dev, &d);
+        }
+    }
+
+    void Renderer::waitBuffer(int index)
+    {
+        if (!pending[index])
+            return;
+        uint32_t start = micros();
+        while (pending[index])
+        {
+            spi_transaction_t *done;
+            spi_device_get_trans_result(dev, &done, portMAX_DELAY);
+            for (int i = 0; i < 2; i++)
+            {
+                if (done == &trans[i][TRANS_PER_BAND - 1])
+                    pending[i] = false;
+            }
+        }
+        waitUs += micros() - start;
+    }
+
+    void Renderer::flush()
+    {
+        waitBuffer(0);
+        waitBuffer(1);
+    }
+
+    void Renderer::queueBand(int index, int x, int y, int w, int h)
+    {
+        spi_transaction_t *t = trans[index];
+        memset(t, 0, sizeof(trans[index]));
+
+        // 列地址、行地址、写显存命令，小数据直接放在事务结构里; 地址加上显存偏移
+        const uint8_t cmds[3] = {CMD_CASET, CMD_RASET, CMD_RAMWR};
+        x += COL_OFFSET;
+        y += ROW_OFFSET;
+        uint16_t ranges[2][2] = {{(uint16_t)x, (uint16_t)(x + w - 1)}, {(uint16_t)y, (uint16_t)(y + h - 1)}};
+        for (int i = 0; i < 3; i++)
+        {
+            spi_transaction_t &c = t[i * 2];
+            c.length = 8;
+            c.flags = SPI_TRANS_USE_TXDATA;
+            c.tx_data[0] = cmds[i];
+            c.user = (void *)0;
+            if (i < 2)
+            {
+                spi_transaction_t &d = t[i * 2 + 1];
+                d.length = 32;
+                d.flags = SPI_TRANS_USE_TXDATA;
+                d.tx_data[0] = ranges[i][0] >> 8;
+                d.tx_data[1] = ranges[i][0] & 0xFF;
+                d.tx_data[2] = ranges[i][1] >> 8;
+                d.tx_data[3] = ranges[i][1] & 0xFF;
+                d.user = (void *)USER_DATA;
+            }
+        }
+
+        spi_transaction_t &px = t[TRANS_PER_BAND - 1];
+        px.length = w * h * 16;
+        px.tx_buffer = buffers[index];
+        px.user = (void *)USER_DATA;
+
+        for (int i = 0; i < TRANS_PER_BAND; i++)
+            spi_device_queue_trans(dev, &t[i], portMAX_DELAY);
+        pending[index] = true;
+        stats.bytes += w * h * 2;
+    }
+
+    void Renderer::render(SceneFn scene)
+    {
+        render(scene, 0, 0, WIDTH, HEIGHT);
+    }
+
+    void Renderer::render(SceneFn scene, int x, int y, int w, int h)
+    {
+        // 窗口裁剪到屏幕范围
+        if (x < 0)
+        {
+            w += x;
+            x = 0;
+        }
+        if (y < 0)
+        {
+            h += y;
+            y = 0;
+        }
+        if (x + w > WIDTH)
+            w = WIDTH - x;
+        if (y + h > HEIGHT)
+            h = HEIGHT - y;
+        if (w <= 0 || h <= 0 || dev == nullptr)
+            return;
+
+        uint32_t start = micros();
+        uint32_t waitedBefore = waitUs;
+        int bandH = BUFFER_PIXELS / w;
+        for (int by = y; by < y + h; by += bandH)
+        {
+            int bh = min(bandH, y + h - by);
+            waitBuffer(current);
+
+            target = buffers[current];
+            clipX = x;
+            clipY = by;
+            clipW = w;
+            clipH = bh;
+            scene(*this);
+            target = nullptr;
+
+            queueBand(current, x, by, w, bh);
+            current ^= 1;
+        }
+
+        uint32_t now = micros();
+        stats.frames++;
+        stats.lastFrameUs = (now - start) - (waitUs - waitedBefore);
+        busyUs += stats.lastFrameUs;
+        windowFrames++;
+        if (now - windowStart >= 1000000)
+        {
+            float elapsed = now - windowStart;
+            stats.fps = windowFrames * 1000000.0f / elapsed;
+            stats.idlePercent = 100.0f - busyUs * 100.0f / elapsed;
+            windowStart = now;
+            windowFrames = 0;
+            busyUs = 0;
+        }
+    }
+
+    void Renderer::capture(SceneFn scene, int x, int y, int w, int h, uint16_t *out)
+    {
+        if (out == nullptr || w <= 0 || h <= 0)
+            return;
+        target = out;
+        clipX = x;
+        clipY = y;
+        clipW = w;
+        clipH = h;
+        scene(*this);
+        target = nullptr;
+    }
+
+    void Renderer::blit(int x, int y, int w, int h, const uint16_t *pixels)
+    {
+        if (target == nullptr)
+            return;
+        int x0 = max(x, clipX);
+        int y0 = max(y, clipY);
+        int x1 = min(x + w, clipX + clipW);
+        int y1 = min(y + h, clipY + clipH);
+        if (x0 >= x1 || y0 >= y1)
+            return;
+
+        for (int row = y0; row < y1; row++)
+            memcpy(target + (row - clipY) * clipW + (x0 - clipX), pixels + (row - y) * w + (x0 - x), (x1 - x0) * 2);
+    }
+
+    // 裁剪到当前条带后填充
+    void Renderer::fill(int x, int y, int w, int h, uint16_t color)
+    {
+        if (target == nullptr)
+            return;
+        if (w < 0)
+        {
+            x += w + 1;
+            w = -w;
+        }
+        if (h < 0)
+        {
+            y += h + 1;
+            h = -h;
+        }
+        int x0 = max(x, clipX);
+        int y0 = max(y, clipY);
+        int x1 = min(x + w, clipX + clipW);
+        int y1 = min(y + h, clipY + clipH);
+        if (x0 >= x1 || y0 >= y1)
+            return;
+
+        uint16_t c = swap16(color);
+        for (int row = y0; row < y1; row++)
+        {
+            uint16_t *p = target + (row - clipY) * clipW + (x0 - clipX);
+            for (int col = x0; col < x1; col++)
+                *p++ = c;
+        }
+    }
+
+    void Renderer::drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+        if (target == nullptr || x < clipX || x >= clipX + clipW || y < clipY || y >= clipY + clipH)
+            return;
+        target[(y - clipY) * clipW + (x - clipX)] = swap16(color);
+    }
+
+    void Renderer::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        fill(x, y, w, h, color);
+    }
+
+    void Renderer::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+        fill(x, y, w, 1, color);
+    }
+
+    void Renderer::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+        fill(x, y, 1, h, color);
+    }
+
+    void Renderer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        fill(x, y, w, h, color);
+    }
+
+    void Renderer::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+        fill(x, y, w, 1, color);
+    }
+
+    void Renderer::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+        fill(x, y, 1, h, color);
+    }
+
+    void Renderer::fillScreen(uint16_t color)
+    {
+        fill(0, 0, WIDTH, HEIGHT, color);
+    }
+} // namespace TftDma
@@ -0,0 +1,94 @@
+#ifndef TFT_DMA_H
+#define TFT_DMA_H
+
+#include <stdint.h>
+#include <Adafruit_GFX.h>
+#include <driver/spi_master.h>
+
+namespace TftDma
+{
+    const int WIDTH = 240;
+    const int HEIGHT = 240;
+    const int BAND_LINES = 20;                     // 整屏宽度时每个缓冲的行数
+    const int BUFFER_PIXELS = WIDTH * BAND_LINES;  // 每个缓冲 9600 字节
+
+    // 场景绘制函数: 每个条带都会完整调用一次，超出当前条带的像素被裁剪掉
+    typedef void (*SceneFn)(Adafruit_GFX &gfx);
+
+    struct Stats
+    {
+        uint32_t frames;      // 累计渲染次数 (整屏或局部)
+        uint32_t bytes;       // 累计发送的像素字节数
+        uint32_t lastFrameUs; // 最近一次 render 的 CPU 时间 (不含等待 DMA)
+        float fps;            // 最近 1 秒的渲染次数
+        float idlePercent;    // 最近 1 秒内 CPU 没有在光栅化的时间占比 (含等待 DMA)
+    };
+
+    // ST7789 双缓冲 DMA 渲染器
+    // 画面按条带光栅化到两个小缓冲中: 一个缓冲由 SPI DMA 发送时，CPU 光栅化下一个条带。
+    // 继承 Adafruit_GFX，现有的 fillCircle / fillRoundRect / print 等代码放进场景函数即可使用。
+    // 只支持 rotation 0。
+    class Renderer : public Adafruit_GFX
+    {
+    public:
+        Renderer() : Adafruit_GFX(WIDTH, HEIGHT) {}
+
+        // 初始化 SPI 总线 (VSPI) 和屏幕; invert: 与 tft.invertDisplay(true) 相同
+        bool begin(int sclk, int mosi, int cs, int dc, int rst, bool invert = true);
+
+        // 渲染整屏
+        void render(SceneFn scene);
+
+        // 只渲染 (x, y, w, h) 窗口，窗口外的屏幕内容保持不变
+        void render(SceneFn scene, int x, int y, int w, int h);
+
+        // 等待所有 DMA 传输结束
+        void flush();
+
+        // 把场景的 (x, y, w, h) 窗口光栅化到 out (w * h 个像素，已是发送字节序)，不发送
+        // 用于缓存静态背景，之后在场景函数中用 blit 贴回
+        void capture(SceneFn scene, int x, int y, int w, int h, uint16_t *out);
+
+        // 在场景函数中使用: 把 capture 得到的像素块按行复制到当前条带
+        void blit(int x, int y, int w, int h, const uint16_t *pixels);
+
+        const Stats &getStats() const { return stats; }
+
+        // Adafruit_GFX 绘制原语，写入当前条带缓冲
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+        void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+        void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+        void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+        void fillScreen(uint16_t color) override;
+
+    private:
+        // 每个缓冲对应的事务: CASET 命令/数据、RASET 命令/数据、RAMWR 命令、像素数据
+        static const int TRANS_PER_BAND = 6;
+
+        void command(uint8_t cmd, const uint8_t *data, int len);
+        void fill(int x, int y, int w, int h, uint16_t color);
+        void waitBuffer(int index);
+        void queueBand(int index, int x, int y, int w, int h);
+
+        spi_device_handle_t dev = nullptr;
+        uint16_t *buffers[2] = {nullptr, nullptr};
+        spi_transaction_t trans[2][TRANS_PER_BAND];
+        bool pending[2] = {false, false};
+        int current = 0;
+
+        // 当前条带 (屏幕坐标)
+        uint16_t *target = nullptr;
+        int clipX = 0, clipY = 0, clipW = 0, clipH = 0;
+
+        Stats stats = {};
+        uint32_t waitUs = 0;       // 累计等待 DMA 的时间
+        uint32_t busyUs = 0;       // 本统计窗口内光栅化的 CPU 时间
+        uint32_t windowStart = 0;  // 统计窗口起点 (micros)
+        uint32_t windowFrames = 0;
+    };
+} // namespace TftDma
+
+#endif
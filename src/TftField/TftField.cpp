@@ -0,0 +1,111 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <U8g2_for_Adafruit_GFX.h>
+#include <stdarg.h>
+#include <string.h>
+#include "TftField.h"
+#include "../GlyphCache/GlyphCache.h"
+
+/*
+字段级增量刷新:
+    "温度: 23.4 °C" --> "温度: 23.5 °C"
+                  只清除并重画 "5 °C" 这一段，标题和没变的字段完全不发送。
+新文本比旧文本短时，清除区间覆盖到旧文本末尾，不再靠末尾补空格消除残影。
+*/
+
+namespace TftField
+{
+    // getUTF8Width() 把最后一个字形截断为位图宽度 + x 偏移，不是前进宽度 (dx)，不能用来定位后面的文本。
+    // 末尾补一个参考字符后最后一个字形变成它: W(s + "0") = 前进宽度之和(s) + W("0")
+    int measure(void *ctx, const char *utf8)
+    {
+        U8G2_FOR_ADAFRUIT_GFX *fonts = static_cast<U8G2_FOR_ADAFRUIT_GFX *>(ctx);
+        char probe[MAX_TEXT + 1];
+        size_t n = strnlen(utf8, MAX_TEXT - 1);
+        memcpy(probe, utf8, n);
+        probe[n] = '0';
+        probe[n + 1] = 0;
+        return fonts->getUTF8Width(probe) - fonts->getUTF8Width("0");
+    }
+
+    // 字形缓存里存的就是每个字形的前进宽度，与 drawString 移动的距离一致
+    int measureCached(void *ctx, const char *utf8)
+    {
+        return static_cast<GlyphCache::Cache *>(ctx)->width(utf8);
+    }
+
+    void Painter::begin(Adafruit_GFX &display, U8G2_FOR_ADAFRUIT_GFX &fonts, uint16_t background)
+    {
+        gfx = &display;
+        u8g2 = &fonts;
+        bg = background;
+    }
+
+    Plan Painter::plan(Field &field, const char *text, uint16_t color)
+    {
+        if (glyphs != nullptr)
+            return field.plan(text, color, measureCached, glyphs);
+        return field.plan(text, color, measure, u8g2);
+    }
+
+    void Painter::draw(Field &field, uint16_t color, const char *fmt, ...)
+    {
+        char text[MAX_TEXT];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(text, sizeof(text), fmt, args);
+        va_end(args);
+
+        stats.updates++;
+        Plan p = plan(field, text, color);
+        if (!p.dirty)
+        {
+            stats.skipped++;
+            return;
+        }
+
+        // 行高取字体的上升 + 下降部分，覆盖所有字形
+        int top = field.baseline - u8g2->getFontAscent();
+        int height = u8g2->getFontAscent() - u8g2->getFontDescent();
+        const char *rest = text + p.prefixBytes;
+
+        if (glyphs != nullptr)
+        {
+            // 字形单元格自带背景，只清除新文本没有覆盖到的尾部
+            int drawn = glyphs->drawString(p.drawX, field.baseline, rest, color, bg);
+            int tail = p.clearX + p.clearW - (p.drawX + drawn);
+            if (tail > 0)
+                gfx->fillRect(p.drawX + drawn, top, tail, height, bg);
+            stats.pixels += (drawn + (tail > 0 ? tail : 0)) * height;
+            return;
+        }
+
+        if (p.clearW > 0)
+        {
+            gfx->fillRect(p.clearX, top, p.clearW, height, bg);
+            stats.pixels += p.clearW * height;
+        }
+
+        if (*rest != 0)
+        {
+            u8g2->setFontMode(1); // 透明模式: 背景已清除，只写前景像素
+            u8g2->setForegroundColor(color);
+            u8g2->setCursor(p.drawX, field.baseline);
+            u8g2->print(rest);
+            u8g2->setFontMode(0);
+            stats.pixels += measure(u8g2, rest) * height;
+        }
+    }
+
+    void Painter::clear(Field &field)
+    {
+        stats.updates++;
+        Plan p = plan(field, "", bg);
+        if (!p.dirty || p.clearW == 0)
+            return;
+        int top = field.baseline - u8g2->getFontAscent();
+        int height = u8g2->getFontAscent() - u8g2->getFontDescent();
+        gfx->fillRect(p.clearX, top, p.clearW, height, bg);
+        stats.pixels += p.clearW * height;
+    }
+} // namespace TftField
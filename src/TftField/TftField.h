@@ -0,0 +1,133 @@
+#ifndef TFT_FIELD_H
+#define TFT_FIELD_H
+
+#include <stdint.h>
+#include <string.h>
+
+class Adafruit_GFX;
+class U8G2_FOR_ADAFRUIT_GFX;
+
+namespace GlyphCache
+{
+    class Cache;
+}
+
+namespace TftField
+{
+    const int MAX_TEXT = 48; // 单个字段格式化后的最大字节数 (UTF-8)
+
+    // 返回 UTF-8 文本在当前字体下的前进宽度之和，即从 x 画完这段文本后光标停在 x + 返回值
+    // 前缀宽度用来定位剩余文本，必须与逐字形绘制时的光标移动一致
+    typedef int (*MeasureFn)(void *ctx, const char *utf8);
+
+    // 一次更新需要执行的绘制操作
+    struct Plan
+    {
+        bool dirty;      // false 表示文本和颜色都没变，什么也不用画
+        int prefixBytes; // 与上次相同、无需重画的前缀字节数
+        int drawX;       // 从这里开始画剩余文本
+        int clearX;      // 先清除 [clearX, clearX + clearW) 这一段
+        int clearW;
+    };
+
+    // 一个文本字段: 记住上次绘制的文本、颜色和宽度
+    // 只比较字节和计算区间，不依赖 Arduino，主机上可以用假的测宽函数统计像素数。
+    class Field
+    {
+    public:
+        Field(int x, int baseline) : x(x), baseline(baseline) {}
+
+        // 屏幕被整体清除后调用，下一次更新视为全新绘制
+        void invalidate() { valid = false; }
+
+        // 计算从上次的内容变为 text/color 需要重画的区间，并更新缓存
+        // 字体没有字距调整，相同前缀的像素位置不变，只需重画第一个不同字符之后的部分。
+        Plan plan(const char *next, uint16_t nextColor, MeasureFn measure, void *ctx)
+        {
+            Plan p = {false, 0, x, x, 0};
+            if (valid && nextColor == color && strcmp(next, text) == 0)
+                return p;
+
+            int prefix = 0;
+            if (valid && nextColor == color)
+            {
+                while (next[prefix] != 0 && next[prefix] == text[prefix])
+                    prefix++;
+                // 退回到 UTF-8 字符边界
+                while (prefix > 0 && (next[prefix] & 0xC0) == 0x80)
+                    prefix--;
+            }
+
+            char head[MAX_TEXT];
+            memcpy(head, next, prefix);
+            head[prefix] = 0;
+            int prefixW = prefix > 0 ? measure(ctx, head) : 0;
+            int nextW = measure(ctx, next);
+            int oldW = valid ? width : 0;
+            int spanW = (nextW > oldW ? nextW : oldW) - prefixW;
+
+            p.dirty = true;
+            p.prefixBytes = prefix;
+            p.drawX = x + prefixW;
+            p.clearX = x + prefixW;
+            p.clearW = spanW > 0 ? spanW : 0;
+
+            size_t n = strnlen(next, MAX_TEXT - 1);
+            memcpy(text, next, n);
+            text[n] = 0;
+            color = nextColor;
+            width = nextW;
+            valid = true;
+            return p;
+        }
+
+        const int x;
+        const int baseline;
+
+    private:
+        char text[MAX_TEXT] = {0};
+        uint16_t color = 0;
+        int width = 0;
+        bool valid = false;
+    };
+
+    // 绘制统计 (像素数按清除区域 + 重画文本的外框估算)
+    struct Stats
+    {
+        uint32_t updates; // 调用 draw 的次数
+        uint32_t skipped; // 内容没变、直接跳过的次数
+        uint32_t pixels;  // 写入 TFT 的像素数
+    };
+
+    // 把字段画到 TFT 上: 先清除变化的区间，再以透明模式画新文本
+    class Painter
+    {
+    public:
+        void begin(Adafruit_GFX &gfx, U8G2_FOR_ADAFRUIT_GFX &u8g2, uint16_t background);
+
+        // 设置后文本经由字形缓存以不透明背景绘制，只需清除新文本之后的残留部分
+        // 缓存的字体必须与 u8g2 当前字体一致
+        void setGlyphCache(GlyphCache::Cache *cache) { glyphs = cache; }
+
+        // printf 风格更新字段
+        void draw(Field &field, uint16_t color, const char *fmt, ...);
+
+        // 清除字段占用的区域 (例如该字段不再显示)
+        void clear(Field &field);
+
+        const Stats &getStats() const { return stats; }
+        void resetStats() { memset(&stats, 0, sizeof(stats)); }
+
+    private:
+        // 有字形缓存时按缓存的字形宽度测量，否则经由 u8g2 测量，两者都是前进宽度之和
+        Plan plan(Field &field, const char *text, uint16_t color);
+
+        Adafruit_GFX *gfx = nullptr;
+        U8G2_FOR_ADAFRUIT_GFX *u8g2 = nullptr;
+        GlyphCache::Cache *glyphs = nullptr;
+        uint16_t bg = 0;
+        Stats stats = {};
+    };
+} // namespace TftField
+
+#endif
@@ -1,8 +1,9 @@
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
-#include <SPI.h>
 #include "TftTest.h"
+#include "../TftDma/TftDma.h"
+#include "../Sprite/Sprite.h"
 
 /*
 电路图:
@@ -25,81 +26,134 @@ namespace TftTest
     const int TFT_CS = 5;
     const int TFT_DC = 2;
     const int TFT_RST = 15;
+    const int TFT_SCLK = 18;
+    const int TFT_MOSI = 23;
 
-    // 实例化对象
-    Adafruit_ST7789 tft = Adafruit_ST7789(TFT_CS, TFT_DC, TFT_RST);
+    // 双缓冲 DMA 渲染器: 每帧在内存中合成后再发送，不会看到清屏的黑帧
+    TftDma::Renderer tft;
 
-    void init()
-    {
-        Serial.begin(115200);
-        Serial.println("--- TFT 硬件测试开始 ---");
+    // 静态的头部作为背景，眼睛、嘴巴和文字是精灵，只重画变化的区域
+    Sprite::Stage stage;
+    int leftEye = -1;
+    int rightEye = -1;
+    int mouth = -1;
+    int caption = -1;
 
-        // 初始化屏幕
-        // 尝试不同的初始化参数，1.54 寸通常是 240x240
-        tft.init(240, 240);
+    enum
+    {
+        EYES_OPEN,
+        EYES_CLOSED
+    };
+    enum
+    {
+        MOUTH_SURPRISED,
+        MOUTH_SMILE,
+        CAPTION_HIDDEN
+    };
 
-        // 某些模块需要反转颜色才能正常显示
-        tft.invertDisplay(true);
+    // 睁眼 1.5 秒、闭眼 0.2 秒; 每次眨眼后切换表情
+    const Sprite::Key BLINK_KEYS[] = {{1500, EYES_OPEN}, {200, EYES_CLOSED}};
+    const Sprite::Key MOOD_KEYS[] = {{1700, MOUTH_SURPRISED}, {1700, MOUTH_SMILE}};
+    Sprite::Track blink(BLINK_KEYS, 2);
+    Sprite::Track mood(MOOD_KEYS, 2);
 
-        tft.setRotation(0);
-        tft.fillScreen(ST77XX_BLACK);
+    const uint32_t REPORT_INTERVAL = 2000; // 统计打印间隔 (毫秒)
+    uint32_t lastReport = 0;
 
-        Serial.println("初始化完成，开始颜色循环...");
+    // 背景: 黑屏和机器人头部
+    void drawBackground(Adafruit_GFX &gfx)
+    {
+        gfx.fillScreen(ST77XX_BLACK);
+        gfx.fillRoundRect(40, 40, 160, 160, 20, ST77XX_CYAN);
+        gfx.drawRoundRect(40, 40, 160, 160, 20, ST77XX_WHITE);
     }
 
-    void drawRobot(bool blink, bool smile)
+    // 眼睛精灵: 31x31，圆心在 (x + 15, y + 15)
+    void drawEye(Adafruit_GFX &gfx, int x, int y, int frame)
     {
-        // 绘制头部
-        tft.fillRoundRect(40, 40, 160, 160, 20, ST77XX_CYAN);
-        tft.drawRoundRect(40, 40, 160, 160, 20, ST77XX_WHITE);
-
-        // 绘制眼睛
-        if (blink)
+        if (frame == EYES_CLOSED)
         {
             // 闭眼 (直线)
-            tft.fillRect(70, 95, 30, 5, ST77XX_BLACK);
-            tft.fillRect(140, 95, 30, 5, ST77XX_BLACK);
+            gfx.fillRect(x, y + 10, 30, 5, ST77XX_BLACK);
         }
         else
         {
             // 开眼 (圆圈)
-            tft.fillCircle(85, 100, 15, ST77XX_WHITE);
-            tft.fillCircle(85, 100, 7, ST77XX_BLUE);
-            tft.fillCircle(155, 100, 15, ST77XX_WHITE);
-            tft.fillCircle(155, 100, 7, ST77XX_BLUE);
+            gfx.fillCircle(x + 15, y + 15, 15, ST77XX_WHITE);
+            gfx.fillCircle(x + 15, y + 15, 7, ST77XX_BLUE);
         }
+    }
 
-        // 绘制嘴巴
-        if (smile)
+    // 嘴巴精灵: 80x21
+    void drawMouth(Adafruit_GFX &gfx, int x, int y, int frame)
+    {
+        if (frame == MOUTH_SMILE)
         {
             // 微笑 (圆弧模拟)
-            tft.fillRoundRect(80, 150, 80, 10, 5, ST77XX_RED);
+            gfx.fillRoundRect(x, y, 80, 10, 5, ST77XX_RED);
         }
         else
         {
             // 惊讶 (圆圈)
-            tft.fillCircle(120, 160, 10, ST77XX_BLACK);
+            gfx.fillCircle(x + 40, y + 10, 10, ST77XX_BLACK);
         }
     }
 
+    // 文字精灵: 120x16，闭眼时隐藏
+    void drawCaption(Adafruit_GFX &gfx, int x, int y, int frame)
+    {
+        if (frame == CAPTION_HIDDEN)
+            return;
+        gfx.setCursor(x, y);
+        gfx.setTextColor(ST77XX_MAGENTA);
+        gfx.setTextSize(2);
+        gfx.print(frame == MOUTH_SMILE ? "I'm Happy!" : "Oh! Hello!");
+    }
+
+    void init()
+    {
+        Serial.begin(115200);
+        Serial.println("--- TFT 硬件测试开始 ---");
+
+        // 初始化屏幕 (1.54 寸 240x240，某些模块需要反转颜色才能正常显示)
+        if (!tft.begin(TFT_SCLK, TFT_MOSI, TFT_CS, TFT_DC, TFT_RST, true))
+            Serial.println("TFT 初始化失败 (SPI 总线或 DMA 内存)");
+
+        stage.begin(tft, drawBackground);
+        leftEye = stage.add(70, 85, 31, 31, drawEye, EYES_OPEN);
+        rightEye = stage.add(140, 85, 31, 31, drawEye, EYES_OPEN);
+        mouth = stage.add(80, 150, 80, 21, drawMouth, MOUTH_SURPRISED);
+        caption = stage.add(60, 220, 120, 16, drawCaption, MOUTH_SURPRISED);
+        if (caption < 0)
+            Serial.println("精灵背景缓存分配失败");
+
+        uint32_t now = millis();
+        blink.start(now);
+        mood.start(now);
+        lastReport = now;
+        Serial.println("初始化完成，开始动画...");
+    }
+
     void update()
     {
-        static bool state = false;
-        tft.fillScreen(ST77XX_BLACK);
-
-        // 绘制卡通机器人
-        drawRobot(false, state);
-        tft.setCursor(60, 220);
-        tft.setTextColor(ST77XX_MAGENTA);
-        tft.setTextSize(2);
-        tft.print(state ? "I'm Happy!" : "Oh! Hello!");
-        delay(1500);
-
-        // 眨眼动画
-        tft.fillScreen(ST77XX_BLACK);
-        drawRobot(true, state);
-        delay(200);
-
-        state = !state;
+        uint32_t now = millis();
+        blink.advance(now);
+        mood.advance(now);
+
+        stage.setFrame(leftEye, blink.frame());
+        stage.setFrame(rightEye, blink.frame());
+        stage.setFrame(mouth, mood.frame());
+        stage.setFrame(caption, blink.frame() == EYES_CLOSED ? CAPTION_HIDDEN : mood.frame());
+        stage.update();
+
+        if (now - lastReport >= REPORT_INTERVAL)
+        {
+            lastReport = now;
+            const Sprite::Stats &stats = stage.getStats();
+            const TftDma::Stats &dma = tft.getStats();
+            Serial.printf("动画 %lu 帧, 最近一帧 %lu 字节 (整屏 %d), %lu us; 渲染 %.1f 次/s, CPU 空闲 %.0f%%\n",
+                          (unsigned long)stats.frames, (unsigned long)stats.lastBytes,
+                          TftDma::WIDTH * TftDma::HEIGHT * 2, (unsigned long)stats.lastUs, dma.fps, dma.idlePercent);
+        }
     }
 }
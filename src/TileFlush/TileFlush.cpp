@@ -0,0 +1,49 @@
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "TileFlush.h"
+
+namespace TileFlush
+{
+    const int MAX_RUNS = 32; // 区间超过此数量时整屏发送更省事
+
+    void Flusher::flush(U8G2 &u8g2)
+    {
+        int cols = u8g2.getBufferTileWidth();
+        int rows = u8g2.getBufferTileHeight();
+        uint32_t fullBytes = cols * rows * TILE_BYTES + rows * AREA_OVERHEAD_BYTES;
+
+        stats.frames++;
+        stats.bytesFullSend += fullBytes;
+
+        // 超出影子缓冲大小的屏幕直接整屏发送
+        if (cols > MAX_TILE_COLS || rows > MAX_TILE_ROWS)
+        {
+            u8g2.sendBuffer();
+            stats.tilesSent += cols * rows;
+            stats.bytesSent += fullBytes;
+            return;
+        }
+
+        Run runs[MAX_RUNS];
+        int n = differ.diff(u8g2.getBufferPtr(), cols, rows, runs, MAX_RUNS);
+        if (n == 0)
+        {
+            stats.skipped++;
+            return;
+        }
+        if (n < 0)
+        {
+            u8g2.sendBuffer();
+            stats.tilesSent += cols * rows;
+            stats.bytesSent += fullBytes;
+            return;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            u8g2.updateDisplayArea(runs[i].x, runs[i].y, runs[i].w, 1);
+            stats.tilesSent += runs[i].w;
+            stats.bytesSent += runs[i].w * TILE_BYTES + AREA_OVERHEAD_BYTES;
+        }
+    }
+} // namespace TileFlush
@@ -0,0 +1,110 @@
+#ifndef TILE_FLUSH_H
+#define TILE_FLUSH_H
+
+#include <stdint.h>
+#include <string.h>
+
+class U8G2;
+
+namespace TileFlush
+{
+    const int MAX_TILE_COLS = 16; // 128 像素 / 8
+    const int MAX_TILE_ROWS = 8;  // 64 像素 / 8
+    const int TILE_BYTES = 8;     // 每个 8x8 tile 占 8 字节 (每字节一列 8 个像素)
+
+    // 每次 updateDisplayArea 的总线开销估算 (I2C 地址 + 控制字节 + 列/页地址命令)
+    const int AREA_OVERHEAD_BYTES = 8;
+
+    // 一段连续的脏 tile (同一 tile 行内)
+    struct Run
+    {
+        uint8_t x; // 起始 tile 列
+        uint8_t y; // tile 行
+        uint8_t w; // tile 数量
+    };
+
+    // tile 比较器: 保存上一次发送的帧，找出变化的 tile
+    // 不依赖 U8g2，帧缓冲布局与 U8g2 全缓冲模式一致:
+    // 第 ty 行 tile 从 buf[ty * cols * 8] 开始，每个 tile 连续 8 字节。
+    class Differ
+    {
+    public:
+        // 下一次 diff 视为全部脏 (例如绕过本模块直接调用了 sendBuffer)
+        void invalidate() { valid = false; }
+
+        // 比较 frame 与上一帧，把脏区间写入 runs，并更新影子缓冲
+        // 返回区间数量; 0 表示画面没有变化; -1 表示区间太多，应整屏发送
+        int diff(const uint8_t *frame, int cols, int rows, Run *runs, int maxRuns)
+        {
+            int n = 0;
+            bool overflow = false;
+            for (int ty = 0; ty < rows; ty++)
+            {
+                int start = -1;
+                for (int tx = 0; tx <= cols; tx++)
+                {
+                    bool dirty = false;
+                    if (tx < cols)
+                    {
+                        int offset = (ty * cols + tx) * TILE_BYTES;
+                        dirty = !valid || memcmp(frame + offset, shadow + offset, TILE_BYTES) != 0;
+                        if (dirty)
+                            memcpy(shadow + offset, frame + offset, TILE_BYTES);
+                    }
+
+                    if (dirty && start < 0)
+                    {
+                        start = tx;
+                    }
+                    else if (!dirty && start >= 0)
+                    {
+                        if (n == maxRuns)
+                        {
+                            overflow = true;
+                        }
+                        else
+                        {
+                            runs[n].x = start;
+                            runs[n].y = ty;
+                            runs[n].w = tx - start;
+                            n++;
+                        }
+                        start = -1;
+                    }
+                }
+            }
+            valid = true;
+            return overflow ? -1 : n;
+        }
+
+    private:
+        uint8_t shadow[MAX_TILE_COLS * MAX_TILE_ROWS * TILE_BYTES];
+        bool valid = false;
+    };
+
+    // 总线流量统计
+    struct Stats
+    {
+        uint32_t frames;        // flush 调用次数
+        uint32_t skipped;       // 画面无变化、完全跳过的次数
+        uint32_t tilesSent;     // 实际发送的 tile 数
+        uint32_t bytesSent;     // 实际发送的字节数 (含命令开销估算)
+        uint32_t bytesFullSend; // 如果每次都 sendBuffer 需要的字节数
+    };
+
+    // 取代 u8g2.sendBuffer(): 只发送变化的 tile
+    class Flusher
+    {
+    public:
+        void flush(U8G2 &u8g2);
+        void invalidate() { differ.invalidate(); }
+        const Stats &getStats() const { return stats; }
+        void resetStats() { memset(&stats, 0, sizeof(stats)); }
+
+    private:
+        Differ differ;
+        Stats stats = {};
+    };
+} // namespace TileFlush
+
+#endif
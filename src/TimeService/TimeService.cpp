@@ -0,0 +1,78 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <esp_sntp.h>
+#include <sys/time.h>
+#include "TimeService.h"
+
+/*
+单调时钟 + 偏移:
+    UTC(us) = esp_timer_get_time() + epochOffset
+SNTP 每次对时只更新 epochOffset，读取时间只需要一次加法，
+不再调用 getLocalTime() (未对时时会轮询等待最多 5 秒)。
+*/
+
+namespace TimeService
+{
+    State state = NOT_SYNCED;
+    int64_t epochOffset = 0;
+    long localOffsetSec = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // 格式化缓存
+    int64_t cachedMinute = -1;
+    char cachedText[6] = "--:--";
+
+    // SNTP 对时完成回调 (运行在 lwIP 任务中)
+    void handle_sync(struct timeval *tv)
+    {
+        int64_t epochUs = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+        int64_t offset = epochUs - esp_timer_get_time();
+        portENTER_CRITICAL(&mux);
+        epochOffset = offset;
+        state = SYNCED;
+        portEXIT_CRITICAL(&mux);
+    }
+
+    void begin(long offsetSec)
+    {
+        localOffsetSec = offsetSec;
+        sntp_set_time_sync_notification_cb(handle_sync);
+    }
+
+    State getState()
+    {
+        return state;
+    }
+
+    bool isSynced()
+    {
+        return state == SYNCED;
+    }
+
+    int64_t nowEpochUs()
+    {
+        portENTER_CRITICAL(&mux);
+        State s = state;
+        int64_t offset = epochOffset;
+        portEXIT_CRITICAL(&mux);
+        if (s == NOT_SYNCED)
+            return 0;
+        return esp_timer_get_time() + offset;
+    }
+
+    const char *hhmm()
+    {
+        int64_t epochUs = nowEpochUs();
+        if (epochUs == 0)
+            return "--:--";
+
+        int64_t minute = (epochUs / 1000000 + localOffsetSec) / 60;
+        if (minute != cachedMinute)
+        {
+            cachedMinute = minute;
+            snprintf(cachedText, sizeof(cachedText), "%02d:%02d",
+                     (int)((minute / 60) % 24), (int)(minute % 60));
+        }
+        return cachedText;
+    }
+} // namespace TimeService
@@ -0,0 +1,28 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <stdint.h>
+
+namespace TimeService
+{
+    enum State
+    {
+        NOT_SYNCED, // 从未对时
+        SYNCED      // 已通过 SNTP 对时
+    };
+
+    // 注册 SNTP 回调
+    // offsetSec: 本地时区偏移 (时区 + 夏令时)
+    void begin(long offsetSec);
+
+    State getState();
+    bool isSynced();
+
+    // 当前 UTC 时间 (us)，未对时返回 0
+    int64_t nowEpochUs();
+
+    // "HH:MM" 本地时间，只在分钟变化时重新格式化; 未对时返回 "--:--"
+    const char *hhmm();
+} // namespace TimeService
+
+#endif
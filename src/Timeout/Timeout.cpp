@@ -1,6 +1,7 @@
 #include <Arduino.h>
-#include <Ticker.h>
+#include <hal/gpio_ll.h>
 #include "Timeout.h"
+#include "../TimerWheel/TimerWheel.h"
 
 /*
 电路图:
@@ -20,22 +21,27 @@ namespace Timeout {
     int LED2_PIN = 4;
     int LED3_PIN = 15;
 
-    hw_timer_t* timer = NULL;
-    hw_timer_t* timer2 = NULL;
+    // 三个 LED 共用一个硬件定时器 (TimerWheel)，原来占用两个 hw_timer 和一个 Ticker
+    bool led = false;
+    bool led2 = false;
+    bool led3 = false;
+    unsigned long lastReport = 0;
 
-    Ticker ticker;
- 
-    // 中断服务函数 (ISR)
-    void handle_interrupt() {
-        digitalWrite(LED_PIN, !digitalRead(LED_PIN)); // 切换 LED 状态
+    // 在定时器中断中执行: 直接写 GPIO 寄存器，不调用 flash 中的 digitalWrite
+    void IRAM_ATTR toggle_led(void *) {
+        led = !led;
+        gpio_ll_set_level(&GPIO, (gpio_num_t)LED_PIN, led);
     }
 
-    void handle_interrupt2() {
-        digitalWrite(LED2_PIN, !digitalRead(LED2_PIN)); // 切换 LED2 状态
+    // 以下两个在 "timers" 任务中执行，可以调用任意函数
+    void toggle_led2(void *) {
+        led2 = !led2;
+        digitalWrite(LED2_PIN, led2);
     }
 
-    void handle_interrupt3() {
-        digitalWrite(LED3_PIN, !digitalRead(LED3_PIN)); // 切换 LED3 状态
+    void toggle_led3(void *) {
+        led3 = !led3;
+        digitalWrite(LED3_PIN, led3);
     }
 
     void init() {
@@ -44,20 +50,22 @@ namespace Timeout {
         pinMode(LED2_PIN, OUTPUT);
         pinMode(LED3_PIN, OUTPUT);
 
-        // 配置定时器 (Arduino ESP32 v3.0+ 新 API)
-        // timerBegin(频率): 1,000,000 Hz = 1us 计数一次
-        timer = timerBegin(1000000); 
-        timerAttachInterrupt(timer, handle_interrupt);
-        // timerAlarm(定时器, 触发值, 是否自动重载, 重载次数)
-        timerAlarm(timer, 1000000, true, 0); // 每 1,000,000us (1秒) 触发一次
-
-        timer2 = timerBegin(1000000);
-        timerAttachInterrupt(timer2, handle_interrupt2);
-        timerAlarm(timer2, 500000, true, 0); // 每 500,000us (0.5秒) 触发一次
-
-        ticker.attach(2, handle_interrupt3); // 每 2 秒触发一次
+#ifdef BOOT_BENCHMARK
+        TimerWheel::benchmark(Serial); // 临时占用约 24KB 堆
+#endif
+        TimerWheel::begin();
+        TimerWheel::start(1000, toggle_led, nullptr, 1000, TimerWheel::IN_ISR); // 每 1 秒
+        TimerWheel::start(500, toggle_led2, nullptr, 500);                      // 每 0.5 秒
+        TimerWheel::start(2000, toggle_led3, nullptr, 2000);                    // 每 2 秒
     }
 
+    // 每 5 秒打印一次定时器统计
     void update() {
+        if (millis() - lastReport >= 5000) {
+            lastReport = millis();
+            const TimerWheel::Stats &s = TimerWheel::getStats();
+            Serial.printf("tick %lu, 触发 %lu, 丢弃 %lu, 最长中断 %lu 周期\n", (unsigned long)s.ticks,
+                          (unsigned long)s.fired, (unsigned long)s.deferDrops, (unsigned long)s.maxTickCycles);
+        }
     }
-} // namespace Timeout
\ No newline at end of file
+} // namespace Timeout
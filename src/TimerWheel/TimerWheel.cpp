@@ -0,0 +1,147 @@
+#include <Arduino.h>
+#include <esp_cpu.h>
+#include "TimerWheel.h"
+
+namespace TimerWheel
+{
+    const uint8_t FLAG_ISR = 1;
+
+    struct Deferred
+    {
+        Callback cb;
+        void *arg;
+    };
+
+    Wheel<MAX_TIMERS> wheel;
+    hw_timer_t *timer = nullptr;
+    QueueHandle_t queue = nullptr;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+    Stats stats = {};
+
+    // 一个 tick 中到期的任务上下文回调，先记下来，离开临界区后再放入队列
+    Deferred pending[DEFER_QUEUE_LEN];
+    int pendingCount = 0;
+
+    // 由 wheel.advance() 在中断中调用，必须放在 IRAM
+    void IRAM_ATTR dispatch(Callback cb, void *arg, uint8_t flags)
+    {
+        if (flags & FLAG_ISR)
+            cb(arg);
+        else if (pendingCount < DEFER_QUEUE_LEN)
+            pending[pendingCount++] = {cb, arg};
+        else
+            stats.deferDrops++;
+    }
+
+    // 中断上下文的回调在临界区内执行，可以再调用 start() / cancel() (同一核上可重入)
+    void IRAM_ATTR onTick()
+    {
+        uint32_t begin = esp_cpu_get_cycle_count();
+        portENTER_CRITICAL_ISR(&mux);
+        pendingCount = 0;
+        stats.fired += wheel.advance(1);
+        stats.ticks++;
+        int count = pendingCount;
+        portEXIT_CRITICAL_ISR(&mux);
+
+        BaseType_t woken = pdFALSE;
+        for (int i = 0; i < count; i++)
+        {
+            if (xQueueSendFromISR(queue, &pending[i], &woken) != pdTRUE)
+                stats.deferDrops++;
+        }
+        uint32_t cycles = esp_cpu_get_cycle_count() - begin;
+        if (cycles > stats.maxTickCycles)
+            stats.maxTickCycles = cycles;
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+
+    void callbackTask(void *)
+    {
+        Deferred d;
+        for (;;)
+        {
+            if (xQueueReceive(queue, &d, portMAX_DELAY) == pdTRUE)
+                d.cb(d.arg);
+        }
+    }
+
+    bool begin()
+    {
+        if (timer != nullptr)
+            return true;
+        queue = xQueueCreate(DEFER_QUEUE_LEN, sizeof(Deferred));
+        if (queue == nullptr)
+            return false;
+        wheel.setDispatcher(dispatch);
+        xTaskCreate(callbackTask, "timers", 4096, NULL, 2, NULL);
+
+        // 1MHz 计数，每 TICK_US 触发一次，自动重载
+        timer = timerBegin(1000000);
+        if (timer == nullptr)
+            return false;
+        timerAttachInterrupt(timer, onTick);
+        timerAlarm(timer, TICK_US, true, 0);
+        return true;
+    }
+
+    Handle IRAM_ATTR start(uint32_t delayMs, Callback cb, void *arg, uint32_t periodMs, Context context)
+    {
+        uint32_t ticksPerMs = 1000 / TICK_US;
+        portENTER_CRITICAL_SAFE(&mux);
+        Handle h = wheel.start(delayMs * ticksPerMs, cb, arg, periodMs * ticksPerMs,
+                               context == IN_ISR ? FLAG_ISR : 0);
+        portEXIT_CRITICAL_SAFE(&mux);
+        return h;
+    }
+
+    bool IRAM_ATTR cancel(Handle h)
+    {
+        portENTER_CRITICAL_SAFE(&mux);
+        bool ok = wheel.cancel(h);
+        portEXIT_CRITICAL_SAFE(&mux);
+        return ok;
+    }
+
+    const Stats &getStats()
+    {
+        return stats;
+    }
+
+    const int BENCH_TIMERS = 1024;
+    const uint32_t BENCH_TICKS = 10000;
+
+    void benchCallback(void *) {}
+
+    void benchmark(Print &out)
+    {
+        Wheel<BENCH_TIMERS> *bench = new Wheel<BENCH_TIMERS>(); // 约 24KB，测完释放
+        Handle *handles = new Handle[BENCH_TIMERS];
+        uint32_t seed = 1;
+
+        uint32_t start = ESP.getCycleCount();
+        for (int i = 0; i < BENCH_TIMERS; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            uint32_t delay = (seed >> 8) % 60000 + 1;
+            handles[i] = bench->start(delay, benchCallback, nullptr, i % 2 ? delay : 0);
+        }
+        uint32_t insert = ESP.getCycleCount() - start;
+
+        start = ESP.getCycleCount();
+        uint32_t fired = bench->advance(BENCH_TICKS);
+        uint32_t tick = ESP.getCycleCount() - start;
+
+        start = ESP.getCycleCount();
+        for (int i = 0; i < BENCH_TIMERS; i++)
+            bench->cancel(handles[i]);
+        uint32_t cancel = ESP.getCycleCount() - start;
+
+        out.printf("时间轮 %d 个定时器，平均周期数: 启动 %.0f, 取消 %.0f, 每 tick %.0f (%lu 次触发)\n",
+                   BENCH_TIMERS, (float)insert / BENCH_TIMERS, (float)cancel / BENCH_TIMERS,
+                   (float)tick / BENCH_TICKS, (unsigned long)fired);
+        delete[] handles;
+        delete bench;
+    }
+} // namespace TimerWheel
@@ -0,0 +1,246 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+
+class Print;
+
+namespace TimerWheel
+{
+    const int LEVEL_BITS = 6;
+    const int SLOTS = 1 << LEVEL_BITS; // 每层 64 个槽
+    const int LEVELS = 4;              // 4 层共 2^24 个 tick (1ms tick 约 4.6 小时)
+    const uint32_t MAX_DELAY = (1u << (LEVEL_BITS * LEVELS)) - 1;
+
+    typedef void (*Callback)(void *arg);
+    typedef uint32_t Handle; // 高 16 位为代数，低 16 位为定时器编号; 0 表示无效
+
+    // 定时器到期时由 Wheel 调用; 不设置时直接调用 cb(arg)。flags 为 start() 时传入的值
+    typedef void (*DispatchFn)(Callback cb, void *arg, uint8_t flags);
+
+    // 分层时间轮: 第 0 层每个槽对应 1 个 tick，第 L 层每个槽对应 64^L 个 tick。
+    // 定时器按剩余时间放入对应层的槽 (双向链表)，启动与取消都是 O(1);
+    // 时间每走完一圈低层，就把上一层的当前槽重新分配 (级联) 到下面各层。
+    // 时间以 tick 计，由调用方 advance() 推进，不依赖 Arduino，主机上可以直接测试和测量开销。
+    // 中断里会用到的成员函数 (启动、取消、推进及其内部函数) 强制内联，展开在板上的 IRAM 函数中，不会跳到 flash
+    template <int N>
+    class Wheel
+    {
+        static_assert(N > 0 && N < 32767, "定时器数量超出编号范围");
+
+    public:
+        Wheel() { clear(); }
+
+        void clear()
+        {
+            for (int l = 0; l < LEVELS; l++)
+                for (int s = 0; s < SLOTS; s++)
+                    slots[l][s] = NIL;
+            for (int i = 0; i < N; i++)
+            {
+                nodes[i].next = i + 1 < N ? i + 1 : NIL;
+                nodes[i].generation = 1;
+                nodes[i].slot = FREE;
+            }
+            freeList = 0;
+            active = 0;
+            current = 0;
+        }
+
+        void setDispatcher(DispatchFn fn) { dispatch = fn; }
+
+        // delayTicks 后第一次到期 (至少 1 个 tick，超过 MAX_DELAY 按 MAX_DELAY 处理);
+        // periodTicks 不为 0 时之后按该周期重复。定时器用完返回 0
+        __attribute__((always_inline)) inline Handle start(uint32_t delayTicks, Callback cb, void *arg, uint32_t periodTicks = 0, uint8_t flags = 0)
+        {
+            if (freeList == NIL || cb == nullptr)
+                return 0;
+            int i = freeList;
+            Node &n = nodes[i];
+            freeList = n.next;
+            n.cb = cb;
+            n.arg = arg;
+            n.period = periodTicks > MAX_DELAY ? MAX_DELAY : periodTicks;
+            n.flags = flags;
+            n.expires = current + clampDelay(delayTicks);
+            insert(i);
+            active++;
+            return ((uint32_t)n.generation << 16) | (uint32_t)i;
+        }
+
+        // 取消尚未到期的定时器 (或停止周期定时器); 句柄已失效时返回 false
+        __attribute__((always_inline)) inline bool cancel(Handle h)
+        {
+            int i = lookup(h);
+            if (i == NIL)
+                return false;
+            unlink(i);
+            release(i);
+            return true;
+        }
+
+        bool isActive(Handle h) const { return lookup(h) != NIL; }
+
+        // 推进 ticks 个 tick，依次触发到期的定时器，返回触发次数
+        // 回调中可以启动和取消定时器 (包括自己)
+        __attribute__((always_inline)) inline uint32_t advance(uint32_t ticks = 1)
+        {
+            uint32_t fired = 0;
+            while (ticks-- > 0)
+            {
+                current++;
+                // 从高层到低层级联: 高层放下来的定时器可能正好落在低层当前要级联的槽
+                int top = 0;
+                while (top + 1 < LEVELS && ((current >> (LEVEL_BITS * (top + 1))) << (LEVEL_BITS * (top + 1))) == current)
+                    top++;
+                for (int l = top; l >= 1; l--)
+                    cascade(l, (current >> (LEVEL_BITS * l)) & (SLOTS - 1));
+
+                int16_t *head = &slots[0][current & (SLOTS - 1)];
+                while (*head != NIL)
+                {
+                    int i = *head;
+                    Node &n = nodes[i];
+                    unlink(i);
+                    Callback cb = n.cb;
+                    void *arg = n.arg;
+                    uint8_t flags = n.flags;
+                    if (n.period > 0)
+                    {
+                        n.expires += n.period;
+                        insert(i);
+                    }
+                    else
+                        release(i); // 先释放，回调中的 isActive() 已为 false
+                    fired++;
+                    if (dispatch != nullptr)
+                        dispatch(cb, arg, flags);
+                    else
+                        cb(arg);
+                }
+            }
+            return fired;
+        }
+
+        uint32_t now() const { return current; }
+        int activeCount() const { return active; }
+
+    private:
+        static const int16_t NIL = -1;
+        static const int16_t FREE = -1; // slot 字段: 不在任何槽中
+
+        struct Node
+        {
+            int16_t next, prev;
+            int16_t slot; // level * SLOTS + 槽号，空闲时为 FREE
+            uint16_t generation;
+            uint32_t expires;
+            uint32_t period;
+            Callback cb;
+            void *arg;
+            uint8_t flags;
+        };
+
+        __attribute__((always_inline)) static inline uint32_t clampDelay(uint32_t d) { return d == 0 ? 1 : d > MAX_DELAY ? MAX_DELAY : d; }
+
+        __attribute__((always_inline)) inline int lookup(Handle h) const
+        {
+            uint32_t i = h & 0xFFFF;
+            if (i >= (uint32_t)N || nodes[i].slot == FREE || nodes[i].generation != (h >> 16))
+                return NIL;
+            return (int)i;
+        }
+
+        // 按剩余时间选层: 剩余不足 64^(L+1) 个 tick 的放在第 L 层
+        __attribute__((always_inline)) inline void insert(int i)
+        {
+            Node &n = nodes[i];
+            uint32_t delta = n.expires - current;
+            int level = 0;
+            while (level + 1 < LEVELS && delta >= (1u << (LEVEL_BITS * (level + 1))))
+                level++;
+            int s = (n.expires >> (LEVEL_BITS * level)) & (SLOTS - 1);
+            int16_t &head = slots[level][s];
+            n.slot = level * SLOTS + s;
+            n.prev = NIL;
+            n.next = head;
+            if (head != NIL)
+                nodes[head].prev = i;
+            head = i;
+        }
+
+        __attribute__((always_inline)) inline void unlink(int i)
+        {
+            Node &n = nodes[i];
+            if (n.prev != NIL)
+                nodes[n.prev].next = n.next;
+            else if (n.slot != FREE) // 空闲节点不在任何槽中; 强制内联后编译器也就不会推出 -1 下标
+                slots[n.slot / SLOTS][n.slot % SLOTS] = n.next;
+            if (n.next != NIL)
+                nodes[n.next].prev = n.prev;
+        }
+
+        __attribute__((always_inline)) inline void release(int i)
+        {
+            Node &n = nodes[i];
+            n.slot = FREE;
+            n.generation = n.generation == 0xFFFF ? 1 : n.generation + 1;
+            n.next = freeList;
+            freeList = i;
+            active--;
+        }
+
+        __attribute__((always_inline)) inline void cascade(int level, int s)
+        {
+            int i = slots[level][s];
+            slots[level][s] = NIL;
+            while (i != NIL)
+            {
+                int next = nodes[i].next;
+                insert(i);
+                i = next;
+            }
+        }
+
+        Node nodes[N];
+        int16_t slots[LEVELS][SLOTS];
+        int16_t freeList = 0;
+        int active = 0;
+        uint32_t current = 0;
+        DispatchFn dispatch = nullptr;
+    };
+
+    // ---- 板上服务 (TimerWheel.cpp): 一个硬件定时器以 1ms tick 驱动时间轮 ----
+
+    const int MAX_TIMERS = 32;
+    const uint32_t TICK_US = 1000;
+    const int DEFER_QUEUE_LEN = 16;
+
+    enum Context
+    {
+        IN_TASK, // 回调放入队列，由 "timers" 任务执行，可以调用任意函数
+        IN_ISR   // 回调直接在定时器中断中执行，必须短小且只调用 IRAM 中的函数
+    };
+
+    struct Stats
+    {
+        uint32_t ticks;         // 中断次数
+        uint32_t fired;         // 触发的定时器次数
+        uint32_t deferDrops;    // 延迟队列已满而丢弃的回调
+        uint32_t maxTickCycles; // 单次中断处理的最长 CPU 周期数
+    };
+
+    // 启动硬件定时器和回调任务; 重复调用无副作用
+    bool begin();
+
+    // 单位 ms; 任务和中断上下文都可以调用 (放在 IRAM 中)
+    Handle start(uint32_t delayMs, Callback cb, void *arg, uint32_t periodMs = 0, Context context = IN_TASK);
+    bool cancel(Handle h);
+
+    const Stats &getStats();
+
+    // 在 1024 个定时器规模下测量启动、取消和推进一个 tick 的平均 CPU 周期数
+    void benchmark(Print &out);
+} // namespace TimerWheel
+
+#endif
@@ -0,0 +1,110 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "Ultrasonic.h"
+
+/*
+HC-SR04 非阻塞测距:
+    esp_timer 周期回调 --> Trig 输出 10us 脉冲 --> Ranger::trigger()
+    Echo 上升/下降沿中断 --> micros() 时间戳 --> Ranger::onEdge()
+    主循环只读取缓存结果，不再调用 pulseIn() 阻塞等待。
+*/
+
+namespace Ultrasonic
+{
+    int trig = -1;
+    int echo = -1;
+    Ranger ranger;
+    esp_timer_handle_t pingTimer = NULL;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // Echo 引脚边沿中断
+    void IRAM_ATTR handle_echo()
+    {
+        uint32_t now = micros();
+        bool level = digitalRead(echo);
+        portENTER_CRITICAL_ISR(&mux);
+        ranger.onEdge(level, now);
+        portEXIT_CRITICAL_ISR(&mux);
+    }
+
+    // 定时发出触发脉冲 (运行在 esp_timer 任务中)
+    void handle_ping(void *)
+    {
+        digitalWrite(trig, HIGH);
+        delayMicroseconds(10);
+        digitalWrite(trig, LOW);
+
+        uint32_t now = micros();
+        portENTER_CRITICAL(&mux);
+        ranger.poll(now);
+        ranger.trigger(now);
+        portEXIT_CRITICAL(&mux);
+    }
+
+    void begin(int trigPin, int echoPin, int rateHz, int filterSize)
+    {
+        end();
+
+        if (rateHz < 1)
+            rateHz = 1;
+        if (rateHz > MAX_RATE_HZ)
+            rateHz = MAX_RATE_HZ;
+        uint32_t periodUs = 1000000UL / rateHz;
+
+        // 超时不超过 30ms (约 5m)，且必须在下一次触发前结束
+        uint32_t timeoutUs = periodUs - 1000;
+        if (timeoutUs > 30000)
+            timeoutUs = 30000;
+
+        trig = trigPin;
+        echo = echoPin;
+        ranger.begin(filterSize, timeoutUs);
+
+        pinMode(trig, OUTPUT);
+        pinMode(echo, INPUT);
+        digitalWrite(trig, LOW);
+        attachInterrupt(echo, handle_echo, CHANGE);
+
+        esp_timer_create_args_t args = {};
+        args.callback = handle_ping;
+        args.name = "ultrasonic";
+        esp_timer_create(&args, &pingTimer);
+        esp_timer_start_periodic(pingTimer, periodUs);
+    }
+
+    void end()
+    {
+        if (pingTimer != NULL)
+        {
+            esp_timer_stop(pingTimer);
+            esp_timer_delete(pingTimer);
+            pingTimer = NULL;
+        }
+        if (echo >= 0)
+            detachInterrupt(echo);
+    }
+
+    int getDistance()
+    {
+        portENTER_CRITICAL(&mux);
+        int cm = ranger.distance();
+        portEXIT_CRITICAL(&mux);
+        return cm;
+    }
+
+    int getRawDistance()
+    {
+        portENTER_CRITICAL(&mux);
+        int cm = ranger.raw();
+        portEXIT_CRITICAL(&mux);
+        return cm;
+    }
+
+    uint32_t getSequence()
+    {
+        portENTER_CRITICAL(&mux);
+        uint32_t seq = ranger.sequence();
+        portEXIT_CRITICAL(&mux);
+        return seq;
+    }
+} // namespace Ultrasonic
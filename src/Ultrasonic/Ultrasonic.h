@@ -0,0 +1,148 @@
+#ifndef ULTRASONIC_H
+#define ULTRASONIC_H
+
+#include <stdint.h>
+
+namespace Ultrasonic
+{
+    const int MAX_FILTER_SIZE = 9; // 中值滤波窗口上限
+    const int MAX_RATE_HZ = 40;    // 最高测距频率
+
+    // HC-SR04 测距状态机
+    // 只处理 "触发 / 回波边沿 / 超时" 三类事件，时间戳 (us) 由调用方传入，
+    // 不依赖 Arduino，可以在主机上直接喂入模拟的边沿时间戳进行验证。
+    class Ranger
+    {
+    public:
+        enum State
+        {
+            IDLE,         // 空闲，等待下一次触发
+            WAIT_RISE,    // 已触发，等待回波上升沿
+            WAIT_FALL     // 收到上升沿，等待下降沿
+        };
+
+        // filterSize: 中值滤波窗口 (1 - MAX_FILTER_SIZE)
+        // timeoutUs:  触发后多长时间没有完整回波就判定为超出量程
+        void begin(int filterSize, uint32_t timeoutUs)
+        {
+            if (filterSize < 1)
+                filterSize = 1;
+            if (filterSize > MAX_FILTER_SIZE)
+                filterSize = MAX_FILTER_SIZE;
+            size = filterSize;
+            timeout = timeoutUs;
+            state = IDLE;
+            count = 0;
+            head = 0;
+            latest = 0;
+            filtered = 0;
+            seq = 0;
+        }
+
+        // 发出 Trig 脉冲后调用，开始一次新的测量
+        void trigger(uint32_t nowUs)
+        {
+            // 上一次测量还没结束 (没有回波)，按超出量程处理
+            if (state != IDLE)
+                publish(0);
+            state = WAIT_RISE;
+            triggerAt = nowUs;
+        }
+
+        // Echo 引脚电平变化时调用 (ISR 中)
+        void onEdge(bool level, uint32_t nowUs)
+        {
+            if (level && state == WAIT_RISE)
+            {
+                riseAt = nowUs;
+                state = WAIT_FALL;
+            }
+            else if (!level && state == WAIT_FALL)
+            {
+                state = IDLE;
+                publish(toCm(nowUs - riseAt));
+            }
+        }
+
+        // 周期性调用，检查是否超时
+        void poll(uint32_t nowUs)
+        {
+            if (state != IDLE && nowUs - triggerAt > timeout)
+            {
+                state = IDLE;
+                publish(0);
+            }
+        }
+
+        State getState() const { return state; }
+        int raw() const { return latest; }        // 最近一次原始结果 (cm)，0 表示无回波
+        int distance() const { return filtered; } // 中值滤波后的结果 (cm)
+        uint32_t sequence() const { return seq; } // 每产生一个结果加 1
+
+        // 回波高电平宽度 (us) 换算为厘米: 声速 0.034 cm/us，往返除以 2
+        static int toCm(uint32_t pulseUs)
+        {
+            return (int)(pulseUs * 17 / 1000);
+        }
+
+    private:
+        void publish(int cm)
+        {
+            latest = cm;
+            window[head] = cm;
+            head = (head + 1) % size;
+            if (count < size)
+                count++;
+            filtered = median();
+            seq++;
+        }
+
+        // 窗口很小 (<= 9)，插入排序足够快
+        int median() const
+        {
+            int sorted[MAX_FILTER_SIZE];
+            for (int i = 0; i < count; i++)
+            {
+                int v = window[i];
+                int j = i;
+                while (j > 0 && sorted[j - 1] > v)
+                {
+                    sorted[j] = sorted[j - 1];
+                    j--;
+                }
+                sorted[j] = v;
+            }
+            return sorted[count / 2];
+        }
+
+        State state = IDLE;
+        uint32_t timeout = 30000;
+        uint32_t triggerAt = 0;
+        uint32_t riseAt = 0;
+        int window[MAX_FILTER_SIZE] = {0};
+        int size = 1;
+        int count = 0;
+        int head = 0;
+        int latest = 0;
+        int filtered = 0;
+        uint32_t seq = 0;
+    };
+
+    // 启动后台测距: 由 esp_timer 定时触发，Echo 边沿在中断中打时间戳
+    // rateHz: 测距频率 (1 - MAX_RATE_HZ)，filterSize: 中值滤波窗口
+    void begin(int trigPin, int echoPin, int rateHz = 20, int filterSize = 5);
+
+    // 停止测距
+    void end();
+
+    // 最近一次滤波后的距离 (cm)，0 表示超出量程，立即返回不阻塞
+    int getDistance();
+
+    // 最近一次未滤波的距离 (cm)
+    int getRawDistance();
+
+    // 结果序号，可用来判断是否有新数据
+    uint32_t getSequence();
+} // namespace Ultrasonic
+
+#endif
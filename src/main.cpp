@@ -15,6 +15,7 @@
 // #include "SmartHubTft/SmartHubTft.h"
 #include "TftTest/TftTest.h"
 #include "JoystickTest/JoystickTest.h"
+#include "Scheduler/Scheduler.h"
 
 void setup()
 {
@@ -22,10 +23,21 @@ void setup()
   Serial.println("ESP32 启动成功！");
   // SmartHub::init();
   JoystickTest::init();
+
+  // SmartHub 的另外两种运行方式 (与 init() 三选一):
+  // SmartHub::initDualCore(); // 采集在 core 0，loop 中的 update() 只负责输入和渲染 (core 1)
+  // SmartHub::schedule();     // 注册为 Scheduler 任务，loop 中只调用 Scheduler::run()
+
+  // 多模块同时运行: 调用各模块的 schedule() 代替 init()，loop 中只调用 Scheduler::run()
+  // 同时运行的模块不能共用外设: SmartHub 与 OledTemp 都使用 I2C OLED 和 DHT11 (GPIO13)，
+  // JoystickTest 与 HeartBratTest 都使用 GPIO34
+  // OledTemp::schedule();
+  // HeartBratTest::schedule();
 }
 
 void loop()
 {
   // SmartHub::update();
   JoystickTest::update();
+  // Scheduler::run();
 }
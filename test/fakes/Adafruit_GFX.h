@@ -0,0 +1,73 @@
+#ifndef FAKE_ADAFRUIT_GFX_H
+#define FAKE_ADAFRUIT_GFX_H
+
+// Adafruit_GFX 替身: 只有被测代码用到的图元，默认实现都落到 drawPixel。
+// 经典字体的文本输出不模拟 (write 不画任何东西)，界面文字都经由 U8g2_for_Adafruit_GFX
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print
+{
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        for (int16_t j = y; j < y + h; j++)
+            for (int16_t i = x; i < x + w; i++)
+                drawPixel(i, j, color);
+    }
+
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+    virtual void setRotation(uint8_t r) { rotation = r & 3; }
+    virtual void invertDisplay(bool) {}
+
+    using Print::write;
+    size_t write(uint8_t) override { return 1; }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    uint8_t getRotation() const { return rotation; }
+
+protected:
+    const int16_t WIDTH, HEIGHT;
+    int16_t _width, _height;
+    uint8_t rotation = 0;
+};
+
+// 1 bpp 画布，布局与 Adafruit_GFX 相同: 每行 (w + 7) / 8 字节，MSB 在左
+class GFXcanvas1 : public Adafruit_GFX
+{
+public:
+    GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buffer(new uint8_t[((w + 7) / 8) * h]())
+    {
+    }
+    ~GFXcanvas1() { delete[] buffer; }
+    GFXcanvas1(const GFXcanvas1 &) = delete;
+    GFXcanvas1 &operator=(const GFXcanvas1 &) = delete;
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override
+    {
+        if (x < 0 || x >= _width || y < 0 || y >= _height)
+            return;
+        uint8_t *p = &buffer[y * ((WIDTH + 7) / 8) + x / 8];
+        if (color)
+            *p |= 0x80 >> (x & 7);
+        else
+            *p &= ~(0x80 >> (x & 7));
+    }
+
+    void fillScreen(uint16_t color) override { memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT); }
+
+    bool getPixel(int16_t x, int16_t y) const { return buffer[y * ((WIDTH + 7) / 8) + x / 8] & (0x80 >> (x & 7)); }
+    uint8_t *getBuffer() const { return buffer; }
+
+private:
+    uint8_t *buffer;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef FAKE_ADAFRUIT_SPITFT_H
+#define FAKE_ADAFRUIT_SPITFT_H
+
+// SPI 彩屏替身: 画面保存在内存中的 RGB565 帧缓冲 (最大 240x320)。
+// 统计写入的像素数 (板上每个像素经 SPI 发送 2 字节) 和事务数 (每次都要设置地址窗口):
+// drawPixel 每个像素一个事务，fillRect / drawRGBBitmap 每次调用一个事务
+
+#include <Adafruit_GFX.h>
+
+class Adafruit_SPITFT : public Adafruit_GFX
+{
+public:
+    static const int MAX_W = 240;
+    static const int MAX_H = 320;
+
+    Adafruit_SPITFT(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override
+    {
+        transactions++;
+        if (x < 0 || x >= _width || y < 0 || y >= _height)
+            return;
+        frame[y * MAX_W + x] = color;
+        pixelsWritten++;
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override
+    {
+        transactions++;
+        clip(&x, &y, &w, &h);
+        for (int16_t j = y; j < y + h; j++)
+            for (int16_t i = x; i < x + w; i++)
+                frame[j * MAX_W + i] = color;
+        pixelsWritten += (uint32_t)w * h;
+    }
+
+    void drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h)
+    {
+        transactions++;
+        for (int16_t j = 0; j < h; j++)
+        {
+            for (int16_t i = 0; i < w; i++)
+            {
+                if (x + i >= 0 && x + i < _width && y + j >= 0 && y + j < _height)
+                {
+                    frame[(y + j) * MAX_W + x + i] = bitmap[j * w + i];
+                    pixelsWritten++;
+                }
+            }
+        }
+    }
+
+    uint16_t getPixel(int16_t x, int16_t y) const { return frame[y * MAX_W + x]; }
+
+    uint64_t pixelsWritten = 0;
+    uint64_t transactions = 0;
+
+protected:
+    void clip(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const
+    {
+        if (*x < 0)
+        {
+            *w += *x;
+            *x = 0;
+        }
+        if (*y < 0)
+        {
+            *h += *y;
+            *y = 0;
+        }
+        if (*x + *w > _width)
+            *w = _width - *x;
+        if (*y + *h > _height)
+            *h = _height - *y;
+        if (*w < 0)
+            *w = 0;
+        if (*h < 0)
+            *h = 0;
+    }
+
+    uint16_t frame[MAX_W * MAX_H] = {};
+};
+
+#endif
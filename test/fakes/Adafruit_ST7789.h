@@ -0,0 +1,28 @@
+#ifndef FAKE_ADAFRUIT_ST7789_H
+#define FAKE_ADAFRUIT_ST7789_H
+
+#include <Adafruit_SPITFT.h>
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+class Adafruit_ST7789 : public Adafruit_SPITFT
+{
+public:
+    Adafruit_ST7789(int8_t /* cs */, int8_t /* dc */, int8_t /* rst */) : Adafruit_SPITFT(MAX_W, MAX_H) {}
+
+    void init(uint16_t w, uint16_t h, uint8_t = 0)
+    {
+        _width = w < MAX_W ? w : MAX_W;
+        _height = h < MAX_H ? h : MAX_H;
+    }
+};
+
+#endif
@@ -0,0 +1,712 @@
+#ifndef FAKE_ARDUINO_H
+#define FAKE_ARDUINO_H
+
+// 主机测试 (pio test -e native) 用的 Arduino / FreeRTOS 替身，只覆盖被测模块用到的部分。
+// 时间是虚拟的: 测试用 Fake::advanceUs 直接拨动时钟，或用 Fake::run 推进时钟并依次处理其间的定时事件
+// (esp_timer、硬件定时器、外设替身的电平变化)，delay / vTaskDelay 在主线程中也会处理事件。
+// 引脚电平、analogRead 和 pulseIn 的返回值由测试设置，串口输出记录在 Serial.text 中。
+// FreeRTOS 任务是真正的线程，但同一时刻只有一个在运行 (主线程或某个任务): 任务在阻塞时交还执行权，
+// 主线程在每个事件之后运行全部就绪的任务，结果与调度顺序无关，可以重复。
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#define IRAM_ATTR
+#define ARDUINO_ISR_ATTR
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define digitalPinToInterrupt(p) (p)
+
+using std::max;
+using std::min;
+
+namespace Fake
+{
+    const int PIN_COUNT = 40;
+
+    inline uint64_t nowUs = 0;
+    inline int levels[PIN_COUNT];
+    inline int modes[PIN_COUNT];
+    inline uint16_t analog[PIN_COUNT];
+    inline uint32_t duty[PIN_COUNT];       // ledcWrite() 最近写入的占空比
+    inline unsigned long pulseWidthUs = 0; // pulseIn() 的返回值，0 表示超时
+    inline uint32_t sleeps = 0;            // vTaskDelay() 调用次数
+    inline uint32_t writes = 0;            // digitalWrite() 调用次数
+    inline uint32_t ledcWrites = 0;        // ledcWrite() 调用次数
+
+    inline void advanceUs(uint64_t us) { nowUs += us; }
+    inline void advanceMs(uint32_t ms) { nowUs += (uint64_t)ms * 1000; }
+
+    // ---- 定时事件: 固定容量，不分配内存 (帧基准统计堆分配时不会算进替身自己的开销) ----
+
+    typedef void (*EventFn)(void *arg);
+
+    struct Event
+    {
+        uint64_t at;
+        uint64_t period; // 0 为单次
+        EventFn fn;
+        void *arg;
+        uint32_t id; // 递增编号，时刻相同的事件按安排的先后处理; 0 表示空位
+    };
+
+    const int MAX_EVENTS = 64;
+    inline Event events[MAX_EVENTS];
+    inline uint32_t nextEventId = 1;
+    inline int depth = 0; // 正在执行事件 (相当于中断或定时器回调) 的嵌套层数
+
+    // 在 at 时刻调用 fn(arg)，period 不为 0 时之后按该周期重复; 返回用于取消的编号
+    inline uint32_t schedule(uint64_t at, EventFn fn, void *arg, uint64_t period = 0)
+    {
+        for (Event &e : events)
+        {
+            if (e.id == 0)
+            {
+                e = {at, period, fn, arg, nextEventId++};
+                return e.id;
+            }
+        }
+        fprintf(stderr, "Fake: 定时事件超过 %d 个\n", MAX_EVENTS);
+        abort();
+    }
+
+    // 单次事件执行后编号即失效，取消失效的编号没有作用
+    inline void cancel(uint32_t id)
+    {
+        for (Event &e : events)
+        {
+            if (id != 0 && e.id == id)
+                e.id = 0;
+        }
+    }
+
+    // ---- 引脚: 中断和外设替身 ----
+
+    struct Isr
+    {
+        void (*fn)();
+        void (*fnArg)(void *);
+        void *arg;
+        int mode;
+    };
+    inline Isr isrs[PIN_COUNT];
+
+    // 外设替身在 pinMode / digitalWrite 之后收到通知，可以据此安排自己的电平变化
+    typedef void (*PinHook)(void *ctx, int pin);
+
+    struct Device
+    {
+        PinHook fn;
+        void *ctx;
+    };
+    inline Device devices[PIN_COUNT];
+
+    inline void attachDevice(int pin, PinHook fn, void *ctx) { devices[pin] = {fn, ctx}; }
+
+    inline void notifyDevice(int pin)
+    {
+        if (devices[pin].fn != nullptr)
+            devices[pin].fn(devices[pin].ctx, pin);
+    }
+
+    // 外部驱动引脚: 电平变化时按触发方式调用中断函数
+    inline void setLevel(int pin, int level)
+    {
+        int old = levels[pin];
+        levels[pin] = level;
+        const Isr &isr = isrs[pin];
+        if (old == level || (isr.fn == nullptr && isr.fnArg == nullptr))
+            return;
+        if (isr.mode == CHANGE || (isr.mode == RISING && level) || (isr.mode == FALLING && !level))
+        {
+            depth++;
+            if (isr.fnArg != nullptr)
+                isr.fnArg(isr.arg);
+            else
+                isr.fn();
+            depth--;
+        }
+    }
+
+    // ---- SNTP 与 configTime() ----
+
+    inline void (*sntpCallback)(struct timeval *tv) = nullptr;
+    inline uint32_t sntpDelayMs = 500;            // configTime() 到对时完成的时间
+    inline int64_t epochAtBootUs = 1760000000LL * 1000000; // 对时得到的 UTC 减去虚拟时钟
+} // namespace Fake
+
+// ---- FreeRTOS 任务和队列 ----
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef int portMUX_TYPE;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define errQUEUE_FULL 0
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+#define portENTER_CRITICAL_SAFE(mux) ((void)(mux))
+#define portEXIT_CRITICAL_SAFE(mux) ((void)(mux))
+#define portYIELD_FROM_ISR(...) ((void)0)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms)) // configTICK_RATE_HZ = 1000
+
+struct QueueDefinition
+{
+    int length;
+    int itemSize;
+    int head;
+    int count;
+    uint8_t *items;
+};
+typedef QueueDefinition *QueueHandle_t;
+
+struct tskTaskControlBlock
+{
+    enum State
+    {
+        RUNNING,
+        READY,
+        WAIT_NOTIFY, // ulTaskNotifyTake
+        WAIT_QUEUE,  // xQueueReceive
+        WAIT_TIME,   // vTaskDelay / vTaskDelayUntil，由定时事件唤醒
+        DELETED
+    };
+
+    TaskFunction_t fn;
+    void *arg;
+    State state;
+    uint32_t notify;
+    QueueHandle_t queue;
+    std::condition_variable wake;
+};
+typedef tskTaskControlBlock *TaskHandle_t;
+
+namespace Fake
+{
+    const int MAX_TASKS = 8;
+    inline TaskHandle_t tasks[MAX_TASKS];
+    inline int taskCount = 0;
+    inline TaskHandle_t running = nullptr;       // 持有执行权的任务，nullptr 表示主线程
+    inline thread_local TaskHandle_t self = nullptr; // 当前线程对应的任务
+
+    // 任务线程在进程退出时仍然阻塞着，同步对象不析构
+    inline std::mutex &baton()
+    {
+        static std::mutex *m = new std::mutex();
+        return *m;
+    }
+
+    inline std::condition_variable &mainWake()
+    {
+        static std::condition_variable *cv = new std::condition_variable();
+        return *cv;
+    }
+
+    // 主线程: 把执行权交给任务 t，直到它再次阻塞
+    inline void resume(TaskHandle_t t)
+    {
+        std::unique_lock<std::mutex> lock(baton());
+        t->state = tskTaskControlBlock::RUNNING;
+        running = t;
+        t->wake.notify_one();
+        mainWake().wait(lock, [] { return running == nullptr; });
+    }
+
+    // 任务线程: 以状态 s 阻塞并交还执行权，直到主线程再次 resume()
+    inline void block(TaskHandle_t t, tskTaskControlBlock::State s)
+    {
+        std::unique_lock<std::mutex> lock(baton());
+        t->state = s;
+        running = nullptr;
+        mainWake().notify_one();
+        t->wake.wait(lock, [t] { return running == t; });
+    }
+
+    inline bool isReady(TaskHandle_t t)
+    {
+        switch (t->state)
+        {
+        case tskTaskControlBlock::READY:
+            return true;
+        case tskTaskControlBlock::WAIT_NOTIFY:
+            return t->notify > 0;
+        case tskTaskControlBlock::WAIT_QUEUE:
+            return t->queue->count > 0;
+        default:
+            return false;
+        }
+    }
+
+    // 运行全部就绪的任务，直到都阻塞; 只在主线程的最外层调用
+    inline void runTasks()
+    {
+        if (self != nullptr || depth > 0)
+            return;
+        bool ran = true;
+        while (ran)
+        {
+            ran = false;
+            for (int i = 0; i < taskCount; i++)
+            {
+                if (isReady(tasks[i]))
+                {
+                    resume(tasks[i]);
+                    ran = true;
+                }
+            }
+        }
+    }
+
+    // 把时钟推进到 until，依次处理其间到期的事件，每个事件之后运行被唤醒的任务。
+    // 在事件或任务中调用 (比如回调里的 delay) 时只拨动时钟，不嵌套处理
+    inline void runUntil(uint64_t until)
+    {
+        if (depth > 0 || self != nullptr)
+        {
+            if (until > nowUs)
+                nowUs = until;
+            return;
+        }
+        runTasks();
+        for (;;)
+        {
+            Event *next = nullptr;
+            for (Event &e : events)
+            {
+                if (e.id != 0 && e.at <= until && (next == nullptr || e.at < next->at || (e.at == next->at && e.id < next->id)))
+                    next = &e;
+            }
+            if (next == nullptr)
+                break;
+            if (next->at > nowUs)
+                nowUs = next->at;
+            EventFn fn = next->fn;
+            void *arg = next->arg;
+            if (next->period > 0)
+                next->at += next->period;
+            else
+                next->id = 0;
+            depth++;
+            fn(arg);
+            depth--;
+            runTasks();
+        }
+        if (until > nowUs)
+            nowUs = until;
+    }
+
+    inline void run(uint64_t us) { runUntil(nowUs + us); }
+
+    inline void wakeTask(void *arg)
+    {
+        TaskHandle_t t = (TaskHandle_t)arg;
+        if (t->state == tskTaskControlBlock::WAIT_TIME)
+            t->state = tskTaskControlBlock::READY;
+    }
+
+    // 睡到 at 时刻: 任务中阻塞等待唤醒事件，主线程中推进时钟并处理事件
+    inline void sleepUntil(uint64_t at)
+    {
+        if (self == nullptr)
+        {
+            runUntil(at);
+            return;
+        }
+        schedule(at, wakeTask, self);
+        block(self, tskTaskControlBlock::WAIT_TIME);
+    }
+
+    inline void reset()
+    {
+        nowUs = 0;
+        memset(levels, 0, sizeof(levels));
+        memset(modes, 0, sizeof(modes));
+        memset(analog, 0, sizeof(analog));
+        memset(duty, 0, sizeof(duty));
+        memset(isrs, 0, sizeof(isrs));
+        memset(devices, 0, sizeof(devices));
+        memset(events, 0, sizeof(events));
+        pulseWidthUs = 0;
+        sleeps = 0;
+        writes = 0;
+        ledcWrites = 0;
+        sntpCallback = nullptr;
+    }
+} // namespace Fake
+
+// 任务先运行到第一次阻塞再返回 (相当于新任务优先级更高); 事件或任务中创建的等到下一次调度
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *, uint32_t, void *arg,
+                                          UBaseType_t, TaskHandle_t *out, BaseType_t)
+{
+    if (Fake::taskCount >= Fake::MAX_TASKS)
+        return pdFALSE;
+    TaskHandle_t t = new tskTaskControlBlock();
+    t->fn = fn;
+    t->arg = arg;
+    t->state = tskTaskControlBlock::READY;
+    Fake::tasks[Fake::taskCount++] = t;
+    std::thread([t] {
+        {
+            std::unique_lock<std::mutex> lock(Fake::baton());
+            t->wake.wait(lock, [t] { return Fake::running == t; });
+        }
+        Fake::self = t;
+        t->fn(t->arg);
+        // FreeRTOS 任务函数不能返回，这里当作删除自己
+        std::unique_lock<std::mutex> lock(Fake::baton());
+        t->state = tskTaskControlBlock::DELETED;
+        Fake::running = nullptr;
+        Fake::mainWake().notify_one();
+    }).detach();
+    if (out != nullptr)
+        *out = t;
+    Fake::runTasks();
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                              UBaseType_t priority, TaskHandle_t *out)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, priority, out, 0);
+}
+
+inline void vTaskDelete(TaskHandle_t t)
+{
+    if (t == nullptr)
+        t = Fake::self;
+    if (t == nullptr)
+        return;
+    if (t == Fake::self)
+        Fake::block(t, tskTaskControlBlock::DELETED); // 不会再被唤醒
+    t->state = tskTaskControlBlock::DELETED;
+}
+
+inline TickType_t xTaskGetTickCount() { return (TickType_t)(Fake::nowUs / 1000); }
+
+inline void vTaskDelay(TickType_t ticks)
+{
+    Fake::sleeps++;
+    Fake::sleepUntil(Fake::nowUs + (uint64_t)ticks * 1000);
+}
+
+inline void vTaskDelayUntil(TickType_t *previous, TickType_t ticks)
+{
+    *previous += ticks;
+    uint64_t at = (uint64_t)*previous * 1000;
+    Fake::sleeps++;
+    if (at > Fake::nowUs)
+        Fake::sleepUntil(at);
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t *woken)
+{
+    t->notify++;
+    if (woken != nullptr)
+        *woken = pdTRUE;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t t)
+{
+    t->notify++;
+    return pdPASS;
+}
+
+// 有限的超时按无限等待处理 (被测代码只用 0 和 portMAX_DELAY)
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks)
+{
+    TaskHandle_t t = Fake::self;
+    if (t == nullptr)
+        return 0;
+    while (t->notify == 0)
+    {
+        if (ticks == 0)
+            return 0;
+        Fake::block(t, tskTaskControlBlock::WAIT_NOTIFY);
+    }
+    uint32_t value = t->notify;
+    t->notify = clear ? 0 : value - 1;
+    return value;
+}
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    QueueHandle_t q = new QueueDefinition();
+    q->length = length;
+    q->itemSize = itemSize;
+    q->items = new uint8_t[length * itemSize];
+    return q;
+}
+
+inline BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken)
+{
+    if (q->count >= q->length)
+        return errQUEUE_FULL;
+    memcpy(q->items + ((q->head + q->count) % q->length) * q->itemSize, item, q->itemSize);
+    q->count++;
+    if (woken != nullptr)
+        *woken = pdTRUE;
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t)
+{
+    return xQueueSendFromISR(q, item, nullptr);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks)
+{
+    while (q->count == 0)
+    {
+        if (Fake::self == nullptr || ticks == 0)
+            return pdFALSE;
+        Fake::self->queue = q;
+        Fake::block(Fake::self, tskTaskControlBlock::WAIT_QUEUE);
+    }
+    memcpy(item, q->items + q->head * q->itemSize, q->itemSize);
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    return pdTRUE;
+}
+
+// ---- Arduino ----
+
+inline unsigned long millis() { return (unsigned long)(Fake::nowUs / 1000); }
+inline unsigned long micros() { return (unsigned long)Fake::nowUs; }
+inline void delay(uint32_t ms) { Fake::sleepUntil(Fake::nowUs + (uint64_t)ms * 1000); }
+inline void delayMicroseconds(uint32_t us) { Fake::advanceUs(us); } // 忙等，期间不处理事件
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// 没有外设替身的引脚: 上拉 / 下拉输入直接得到对应电平
+inline void pinMode(uint8_t pin, uint8_t mode)
+{
+    Fake::modes[pin] = mode;
+    if (Fake::devices[pin].fn == nullptr && (mode == INPUT_PULLUP || mode == INPUT_PULLDOWN))
+        Fake::levels[pin] = mode == INPUT_PULLUP ? HIGH : LOW;
+    Fake::notifyDevice(pin);
+}
+
+inline int digitalRead(uint8_t pin) { return Fake::levels[pin]; }
+inline void digitalWrite(uint8_t pin, uint8_t level)
+{
+    Fake::levels[pin] = level;
+    Fake::writes++;
+    Fake::notifyDevice(pin);
+}
+inline uint16_t analogRead(uint8_t pin) { return Fake::analog[pin]; }
+inline unsigned long pulseIn(uint8_t, uint8_t, unsigned long = 1000000) { return Fake::pulseWidthUs; }
+
+inline void attachInterrupt(uint8_t pin, void (*fn)(), int mode) { Fake::isrs[pin] = {fn, nullptr, nullptr, mode}; }
+inline void attachInterruptArg(uint8_t pin, void (*fn)(void *), void *arg, int mode) { Fake::isrs[pin] = {nullptr, fn, arg, mode}; }
+inline void detachInterrupt(uint8_t pin) { Fake::isrs[pin] = {}; }
+
+inline bool ledcAttach(uint8_t, uint32_t, uint8_t) { return true; }
+inline bool ledcWrite(uint8_t pin, uint32_t duty)
+{
+    Fake::duty[pin] = duty;
+    Fake::ledcWrites++;
+    return true;
+}
+
+class String
+{
+public:
+    String(const char *s = "") : text(s) {}
+    const char *c_str() const { return text.c_str(); }
+    size_t length() const { return text.size(); }
+
+private:
+    std::string text;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual int availableForWrite() { return 0; }
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+            write(buffer[i]);
+        return size;
+    }
+
+    size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t println(const char *s) { return print(s) + println(); }
+    size_t println() { return print("\r\n"); }
+
+    // 与 ESP32 Arduino 相同: 先格式化到 64 字节的栈缓冲，放不下时在堆上分配
+    size_t printf(const char *format, ...)
+    {
+        char loc[64];
+        char *buffer = loc;
+        va_list args, copy;
+        va_start(args, format);
+        va_copy(copy, args);
+        int n = vsnprintf(loc, sizeof(loc), format, copy);
+        va_end(copy);
+        if (n < 0)
+        {
+            va_end(args);
+            return 0;
+        }
+        if (n >= (int)sizeof(loc))
+        {
+            buffer = new char[n + 1];
+            vsnprintf(buffer, n + 1, format, args);
+        }
+        va_end(args);
+        size_t written = write((const uint8_t *)buffer, n);
+        if (buffer != loc)
+            delete[] buffer;
+        return written;
+    }
+};
+
+// 把输出收集到字符串里，测试可以检查格式和字节数; space 模拟发送缓冲的剩余空间
+class StringPrint : public Print
+{
+public:
+    using Print::write;
+    int availableForWrite() override { return space; }
+    size_t write(uint8_t c) override
+    {
+        text += (char)c;
+        return 1;
+    }
+
+    std::string text;
+    int space = 128; // ESP32 UART 发送 FIFO 大小
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+};
+
+// 输入由测试写入 input，输出收集在 text 中
+class StringStream : public Stream
+{
+public:
+    using Print::write;
+    int availableForWrite() override { return space; }
+    size_t write(uint8_t c) override
+    {
+        text += (char)c;
+        return 1;
+    }
+    int available() override { return (int)(input.size() - readPos); }
+    int read() override { return readPos < input.size() ? (uint8_t)input[readPos++] : -1; }
+
+    std::string text;
+    std::string input;
+    size_t readPos = 0;
+    int space = 128;
+};
+
+// bytes 统计全部输出; capture 为 false 时不再记录到 text (长时间运行的基准不让字符串增长)
+class HardwareSerial : public StringStream
+{
+public:
+    void begin(unsigned long) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        bytes += size;
+        if (capture)
+            text.append((const char *)buffer, size);
+        return size;
+    }
+
+    bool capture = true;
+    uint64_t bytes = 0;
+};
+
+inline HardwareSerial Serial;
+
+// CPU 固定 240MHz，周期计数由虚拟时间换算
+inline uint32_t getCpuFrequencyMhz() { return 240; }
+
+class EspClass
+{
+public:
+    uint32_t getCycleCount() { return (uint32_t)(Fake::nowUs * 240); }
+};
+
+inline EspClass ESP;
+
+// ---- 硬件定时器: 报警作为定时事件，中断函数在事件中执行 ----
+
+struct hw_timer_s
+{
+    uint32_t frequency;
+    void (*isr)();
+    uint32_t event;
+};
+typedef struct hw_timer_s hw_timer_t;
+
+inline hw_timer_t *timerBegin(uint32_t frequency) { return new hw_timer_t{frequency, nullptr, 0}; }
+inline void timerAttachInterrupt(hw_timer_t *timer, void (*isr)()) { timer->isr = isr; }
+
+inline void timerAlarm(hw_timer_t *timer, uint64_t alarm, bool autoreload, uint64_t)
+{
+    uint64_t us = alarm * 1000000 / timer->frequency;
+    Fake::cancel(timer->event);
+    timer->event = Fake::schedule(Fake::nowUs + us, [](void *arg) { ((hw_timer_t *)arg)->isr(); },
+                                  timer, autoreload ? us : 0);
+}
+
+// ---- 网络对时: configTime() 之后经过 sntpDelayMs 调用 sntp_set_time_sync_notification_cb 注册的回调 ----
+
+inline void configTime(long, int, const char *, const char * = nullptr, const char * = nullptr)
+{
+    Fake::schedule(Fake::nowUs + (uint64_t)Fake::sntpDelayMs * 1000, [](void *) {
+        if (Fake::sntpCallback == nullptr)
+            return;
+        int64_t epochUs = Fake::epochAtBootUs + (int64_t)Fake::nowUs;
+        struct timeval tv;
+        tv.tv_sec = epochUs / 1000000;
+        tv.tv_usec = epochUs % 1000000;
+        Fake::sntpCallback(&tv);
+    }, nullptr);
+}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef FAKE_SPI_H
+#define FAKE_SPI_H
+
+class SPIClass
+{
+public:
+    void begin() {}
+};
+
+inline SPIClass SPI;
+
+#endif
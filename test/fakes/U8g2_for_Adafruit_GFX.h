@@ -0,0 +1,90 @@
+#ifndef FAKE_U8G2_FOR_ADAFRUIT_GFX_H
+#define FAKE_U8G2_FOR_ADAFRUIT_GFX_H
+
+// U8g2_for_Adafruit_GFX 替身: 用 u8g2_fonts.h 的假字体把字形逐像素画到 Adafruit_GFX 上
+// (与真实库一样每个像素一次 drawPixel)。字形点阵由码位的哈希决定，占满字宽减 1 列、
+// 从上升到下降的全部行; 模式 0 同时画背景像素，模式 1 只画前景
+
+#include <Adafruit_GFX.h>
+#include "u8g2_fonts.h"
+
+class U8G2_FOR_ADAFRUIT_GFX : public Print
+{
+public:
+    void begin(Adafruit_GFX &gfx) { target = &gfx; }
+    void setFont(const uint8_t *f) { font = f; }
+    void setFontMode(uint8_t mode) { transparent = mode != 0; }
+    void setFontDirection(uint8_t) {}
+    void setForegroundColor(uint16_t c) { fg = c; }
+    void setBackgroundColor(uint16_t c) { bg = c; }
+    void setCursor(int16_t x, int16_t y)
+    {
+        cursorX = x;
+        cursorY = y;
+    }
+    int16_t getCursorX() const { return cursorX; }
+    int16_t getCursorY() const { return cursorY; }
+
+    int8_t getFontAscent() const { return font[1]; }
+    int8_t getFontDescent() const { return -font[2]; }
+
+    int16_t getUTF8Width(const char *s) const
+    {
+        int16_t w = 0;
+        while (*s != 0)
+            w += FakeFont::glyphWidth(font, FakeFont::next(&s));
+        return w;
+    }
+
+    // 返回前进宽度
+    int16_t drawGlyph(int16_t x, int16_t y, uint16_t codepoint)
+    {
+        int w = FakeFont::glyphWidth(font, codepoint);
+        uint32_t h = codepoint * 2654435761u;
+        for (int row = -font[1]; row < font[2]; row++)
+        {
+            for (int col = 0; col < w - 1; col++)
+            {
+                h ^= h << 13;
+                h ^= h >> 17;
+                h ^= h << 5;
+                bool on = codepoint != ' ' && (h & 1);
+                if (on)
+                    target->drawPixel(x + col, y + row, fg);
+                else if (!transparent)
+                    target->drawPixel(x + col, y + row, bg);
+            }
+        }
+        return w;
+    }
+
+    using Print::write;
+    size_t write(uint8_t c) override
+    {
+        if (c < 0x80)
+            cursorX += drawGlyph(cursorX, cursorY, c);
+        else if ((c & 0xC0) != 0x80)
+        {
+            pending = c & (c >= 0xF0 ? 0x07 : c >= 0xE0 ? 0x0F : 0x1F);
+            remaining = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+        }
+        else if (remaining > 0)
+        {
+            pending = (pending << 6) | (c & 0x3F);
+            if (--remaining == 0)
+                cursorX += drawGlyph(cursorX, cursorY, pending);
+        }
+        return 1;
+    }
+
+private:
+    Adafruit_GFX *target = nullptr;
+    const uint8_t *font = u8g2_font_wqy16_t_gb2312;
+    bool transparent = false;
+    uint16_t fg = 1, bg = 0;
+    int16_t cursorX = 0, cursorY = 0;
+    uint32_t pending = 0;
+    int remaining = 0;
+};
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef FAKE_U8G2LIB_H
+#define FAKE_U8G2LIB_H
+
+// 主机测试用的 U8G2 替身: 128x64 单色帧缓冲，布局与 U8g2 全缓冲模式一致
+// (第 ty 行 tile 从 buf[ty * 128] 开始，每字节是一列 8 个像素，低位在上)。
+// 字体是假的: 每个字符画成由码位决定的点阵，ASCII 宽 6 像素，其它字符宽 12 像素，
+// 只保证 "文本变化 -> 像素变化" 和宽度与真实字体同一量级。
+// sendBuffer / updateDisplayArea 不输出，只统计发送的 tile 数 (每个 tile 经 I2C 发送 8 字节)。
+
+#include <Arduino.h>
+#include <stdlib.h>
+#include "u8g2_fonts.h"
+
+#define U8G2_DRAW_ALL 0x0F
+#define U8X8_PIN_NONE 255
+
+struct u8g2_cb_t
+{
+};
+inline const u8g2_cb_t u8g2_cb_r0 = {};
+#define U8G2_R0 (&u8g2_cb_r0)
+
+class U8G2 : public Print
+{
+public:
+    static const int WIDTH = 128;
+    static const int HEIGHT = 64;
+    static const int TILE_COLS = WIDTH / 8;
+    static const int TILE_ROWS = HEIGHT / 8;
+
+    void begin() {}
+    void enableUTF8Print() {}
+    void setFont(const uint8_t *) {}
+    void setCursor(int x, int y)
+    {
+        cursorX = x;
+        cursorY = y;
+    }
+
+    void clearBuffer() { memset(buffer, 0, sizeof(buffer)); }
+    void sendBuffer()
+    {
+        sends++;
+        tilesSent += TILE_COLS * TILE_ROWS;
+    }
+    void updateDisplayArea(int tx, int ty, int tw, int th)
+    {
+        (void)tx;
+        (void)ty;
+        areas++;
+        tilesSent += tw * th;
+    }
+
+    uint8_t *getBufferPtr() { return buffer; }
+    int getBufferTileWidth() const { return TILE_COLS; }
+    int getBufferTileHeight() const { return TILE_ROWS; }
+    int getDisplayWidth() const { return WIDTH; }
+    int getDisplayHeight() const { return HEIGHT; }
+
+    void drawPixel(int x, int y)
+    {
+        if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+            return;
+        buffer[(y / 8) * WIDTH + x] |= 1 << (y % 8);
+    }
+
+    bool getPixel(int x, int y) const { return buffer[(y / 8) * WIDTH + x] & (1 << (y % 8)); }
+
+    void drawHLine(int x, int y, int w)
+    {
+        for (int i = 0; i < w; i++)
+            drawPixel(x + i, y);
+    }
+
+    void drawVLine(int x, int y, int h)
+    {
+        for (int i = 0; i < h; i++)
+            drawPixel(x, y + i);
+    }
+
+    void drawLine(int x0, int y0, int x1, int y1)
+    {
+        int dx = abs(x1 - x0), dy = -abs(y1 - y0);
+        int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+        int err = dx + dy;
+        for (;;)
+        {
+            drawPixel(x0, y0);
+            if (x0 == x1 && y0 == y1)
+                return;
+            int e2 = 2 * err;
+            if (e2 >= dy)
+            {
+                err += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx)
+            {
+                err += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    void drawBox(int x, int y, int w, int h)
+    {
+        for (int i = 0; i < h; i++)
+            drawHLine(x, y + i, w);
+    }
+
+    void drawFrame(int x, int y, int w, int h)
+    {
+        drawHLine(x, y, w);
+        drawHLine(x, y + h - 1, w);
+        drawVLine(x, y, h);
+        drawVLine(x + w - 1, y, h);
+    }
+
+    void drawCircle(int x0, int y0, int r, uint8_t = U8G2_DRAW_ALL)
+    {
+        int x = r, y = 0, err = 1 - r;
+        while (x >= y)
+        {
+            const int px[8] = {x, y, -y, -x, -x, -y, y, x};
+            const int py[8] = {y, x, x, y, -y, -x, -x, -y};
+            for (int i = 0; i < 8; i++)
+                drawPixel(x0 + px[i], y0 + py[i]);
+            y++;
+            if (err < 0)
+                err += 2 * y + 1;
+            else
+            {
+                x--;
+                err += 2 * (y - x) + 1;
+            }
+        }
+    }
+
+    static int glyphWidth(uint32_t codepoint) { return codepoint < 0x80 ? 6 : 12; }
+
+    int getUTF8Width(const char *s) const
+    {
+        int w = 0;
+        for (const uint8_t *p = (const uint8_t *)s; *p; p++)
+        {
+            if ((*p & 0xC0) != 0x80)
+                w += glyphWidth(*p < 0x80 ? *p : 0x100);
+        }
+        return w;
+    }
+
+    using Print::write;
+    size_t write(uint8_t c) override
+    {
+        if (c < 0x80)
+            drawGlyph(c);
+        else if ((c & 0xC0) != 0x80)
+        {
+            pending = c & (c >= 0xF0 ? 0x07 : c >= 0xE0 ? 0x0F : 0x1F);
+            remaining = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+        }
+        else if (remaining > 0)
+        {
+            pending = (pending << 6) | (c & 0x3F);
+            if (--remaining == 0)
+                drawGlyph(pending);
+        }
+        return 1;
+    }
+
+    uint32_t sends = 0;     // sendBuffer() 次数
+    uint32_t areas = 0;     // updateDisplayArea() 次数
+    uint32_t tilesSent = 0; // 两种方式发送的 tile 总数
+
+private:
+    // 码位的哈希决定点阵，笔画落在基线以上 10 像素内
+    void drawGlyph(uint32_t codepoint)
+    {
+        int w = glyphWidth(codepoint);
+        if (codepoint != ' ')
+        {
+            uint32_t h = codepoint * 2654435761u;
+            for (int y = 0; y < 10; y++)
+            {
+                for (int x = 0; x < w - 1; x++)
+                {
+                    h ^= h << 13;
+                    h ^= h >> 17;
+                    h ^= h << 5;
+                    if (h & 1)
+                        drawPixel(cursorX + x, cursorY - 10 + y);
+                }
+            }
+        }
+        cursorX += w;
+    }
+
+    uint8_t buffer[WIDTH * HEIGHT / 8] = {};
+    int cursorX = 0, cursorY = 0;
+    uint32_t pending = 0;
+    int remaining = 0;
+};
+
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t *, uint8_t /* reset */, uint8_t /* clock */, uint8_t /* data */) {}
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef FAKE_WIFI_H
+#define FAKE_WIFI_H
+
+// Wi-Fi 替身: begin() 之后经过 Fake::wifiConnectMs 连上; wifiAvailable 为 false 时一直连不上，
+// dropLink() 模拟断线
+
+#include <Arduino.h>
+
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum
+{
+    WIFI_OFF,
+    WIFI_STA,
+    WIFI_AP,
+    WIFI_AP_STA
+} wifi_mode_t;
+
+namespace Fake
+{
+    inline bool wifiAvailable = true;
+    inline uint32_t wifiConnectMs = 1500;
+} // namespace Fake
+
+class IPAddress
+{
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : bytes{a, b, c, d} {}
+
+    String toString() const
+    {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+        return String(text);
+    }
+
+private:
+    uint8_t bytes[4];
+};
+
+class WiFiClass
+{
+public:
+    bool mode(wifi_mode_t) { return true; }
+    bool setAutoReconnect(bool) { return true; }
+
+    wl_status_t begin(const char *, const char *)
+    {
+        Fake::cancel(event);
+        state = WL_DISCONNECTED;
+        if (Fake::wifiAvailable)
+            event = Fake::schedule(Fake::nowUs + (uint64_t)Fake::wifiConnectMs * 1000, onConnected, this);
+        return state;
+    }
+
+    bool disconnect(bool = false, bool = false)
+    {
+        Fake::cancel(event);
+        state = WL_DISCONNECTED;
+        return true;
+    }
+
+    wl_status_t status() const { return state; }
+    IPAddress localIP() const { return state == WL_CONNECTED ? IPAddress(192, 168, 1, 50) : IPAddress(); }
+
+    void dropLink() { disconnect(); }
+
+private:
+    static void onConnected(void *arg) { ((WiFiClass *)arg)->state = WL_CONNECTED; }
+
+    wl_status_t state = WL_DISCONNECTED;
+    uint32_t event = 0;
+};
+
+inline WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef FAKE_WIRE_H
+#define FAKE_WIRE_H
+
+class TwoWire
+{
+public:
+    bool begin() { return true; }
+};
+
+inline TwoWire Wire;
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef FAKE_ADC_CONTINUOUS_H
+#define FAKE_ADC_CONTINUOUS_H
+
+// 连续模式 ADC 替身: 按 pattern 轮流 "转换" 各通道 (值取自 Fake::analog 中对应引脚)，
+// 每凑满一帧放入驱动缓冲并调用转换完成回调; 缓冲满时丢弃新帧并调用溢出回调。
+// 帧按转换频率以定时事件产生，与 DMA 一样不占用主循环
+
+#include <Arduino.h>
+#include <soc/soc_caps.h>
+#include "esp_err.h"
+
+typedef enum
+{
+    ADC_UNIT_1,
+    ADC_UNIT_2
+} adc_unit_t;
+
+typedef enum
+{
+    ADC_CHANNEL_0,
+    ADC_CHANNEL_1,
+    ADC_CHANNEL_2,
+    ADC_CHANNEL_3,
+    ADC_CHANNEL_4,
+    ADC_CHANNEL_5,
+    ADC_CHANNEL_6,
+    ADC_CHANNEL_7,
+    ADC_CHANNEL_8,
+    ADC_CHANNEL_9
+} adc_channel_t;
+
+typedef enum
+{
+    ADC_ATTEN_DB_0,
+    ADC_ATTEN_DB_2_5,
+    ADC_ATTEN_DB_6,
+    ADC_ATTEN_DB_12
+} adc_atten_t;
+
+typedef enum
+{
+    ADC_CONV_SINGLE_UNIT_1 = 1,
+    ADC_CONV_SINGLE_UNIT_2 = 2
+} adc_digi_convert_mode_t;
+
+typedef enum
+{
+    ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+    ADC_DIGI_OUTPUT_FORMAT_TYPE2
+} adc_digi_output_format_t;
+
+typedef struct
+{
+    uint8_t atten;
+    uint8_t channel;
+    uint8_t unit;
+    uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct
+{
+    union
+    {
+        struct
+        {
+            uint16_t data : 12;
+            uint16_t channel : 4;
+        } type1;
+        uint16_t val;
+    };
+} adc_digi_output_data_t;
+
+typedef struct
+{
+    uint32_t max_store_buf_size;
+    uint32_t conv_frame_size;
+} adc_continuous_handle_cfg_t;
+
+typedef struct
+{
+    uint32_t pattern_num;
+    adc_digi_pattern_config_t *adc_pattern;
+    uint32_t sample_freq_hz;
+    adc_digi_convert_mode_t conv_mode;
+    adc_digi_output_format_t format;
+} adc_continuous_config_t;
+
+struct adc_continuous_ctx_t;
+typedef struct adc_continuous_ctx_t *adc_continuous_handle_t;
+
+typedef struct
+{
+    uint8_t *conv_frame_buffer;
+    uint32_t size;
+} adc_continuous_evt_data_t;
+
+typedef bool (*adc_continuous_callback_t)(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data);
+
+typedef struct
+{
+    adc_continuous_callback_t on_conv_done;
+    adc_continuous_callback_t on_pool_ovf;
+} adc_continuous_evt_cbs_t;
+
+struct adc_continuous_ctx_t
+{
+    uint32_t poolSize;
+    uint32_t frameSize;
+    uint8_t *pool; // 驱动缓冲 (环形)
+    uint32_t head, count;
+    uint8_t *frame; // 正在 "转换" 的帧
+    adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX];
+    uint32_t patternNum;
+    uint32_t sampleHz;
+    uint32_t next; // 下一个转换的 pattern 下标
+    adc_continuous_evt_cbs_t cbs;
+    void *userData;
+    uint32_t event;
+};
+
+namespace Fake
+{
+    // ADC1 通道 -> GPIO
+    const int ADC1_PINS[8] = {36, 37, 38, 39, 32, 33, 34, 35};
+
+    inline void adcFrame(void *arg)
+    {
+        adc_continuous_handle_t h = (adc_continuous_handle_t)arg;
+        for (uint32_t i = 0; i < h->frameSize; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            const adc_digi_pattern_config_t &p = h->pattern[h->next];
+            h->next = (h->next + 1) % h->patternNum;
+            adc_digi_output_data_t out;
+            out.type1.data = analog[ADC1_PINS[p.channel]] & 0xFFF;
+            out.type1.channel = p.channel;
+            memcpy(h->frame + i, &out, sizeof(out));
+        }
+        adc_continuous_evt_data_t data = {h->frame, h->frameSize};
+        if (h->count + h->frameSize > h->poolSize)
+        {
+            if (h->cbs.on_pool_ovf != nullptr)
+                h->cbs.on_pool_ovf(h, &data, h->userData);
+            return;
+        }
+        for (uint32_t i = 0; i < h->frameSize; i++)
+            h->pool[(h->head + h->count + i) % h->poolSize] = h->frame[i];
+        h->count += h->frameSize;
+        if (h->cbs.on_conv_done != nullptr)
+            h->cbs.on_conv_done(h, &data, h->userData);
+    }
+} // namespace Fake
+
+inline esp_err_t adc_continuous_io_to_channel(int io, adc_unit_t *unit, adc_channel_t *channel)
+{
+    for (int c = 0; c < 8; c++)
+    {
+        if (Fake::ADC1_PINS[c] == io)
+        {
+            *unit = ADC_UNIT_1;
+            *channel = (adc_channel_t)c;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+inline esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *cfg, adc_continuous_handle_t *out)
+{
+    adc_continuous_handle_t h = new adc_continuous_ctx_t();
+    h->poolSize = cfg->max_store_buf_size;
+    h->frameSize = cfg->conv_frame_size;
+    h->pool = new uint8_t[h->poolSize];
+    h->frame = new uint8_t[h->frameSize];
+    *out = h;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_continuous_config(adc_continuous_handle_t h, const adc_continuous_config_t *cfg)
+{
+    if (cfg->pattern_num == 0 || cfg->pattern_num > SOC_ADC_PATT_LEN_MAX ||
+        cfg->sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW || cfg->sample_freq_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)
+        return ESP_ERR_INVALID_ARG;
+    memcpy(h->pattern, cfg->adc_pattern, cfg->pattern_num * sizeof(adc_digi_pattern_config_t));
+    h->patternNum = cfg->pattern_num;
+    h->sampleHz = cfg->sample_freq_hz;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t h, const adc_continuous_evt_cbs_t *cbs, void *userData)
+{
+    h->cbs = *cbs;
+    h->userData = userData;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_continuous_start(adc_continuous_handle_t h)
+{
+    if (h->patternNum == 0)
+        return ESP_ERR_INVALID_STATE;
+    uint64_t frameUs = (uint64_t)(h->frameSize / SOC_ADC_DIGI_RESULT_BYTES) * 1000000 / h->sampleHz;
+    h->event = Fake::schedule(Fake::nowUs + frameUs, Fake::adcFrame, h, frameUs);
+    return ESP_OK;
+}
+
+inline esp_err_t adc_continuous_stop(adc_continuous_handle_t h)
+{
+    Fake::cancel(h->event);
+    h->event = 0;
+    return ESP_OK;
+}
+
+// 超时参数被忽略: 缓冲为空时立即返回 ESP_ERR_TIMEOUT
+inline esp_err_t adc_continuous_read(adc_continuous_handle_t h, uint8_t *buf, uint32_t length, uint32_t *outLength, uint32_t)
+{
+    if (h->count == 0)
+        return ESP_ERR_TIMEOUT;
+    uint32_t n = length < h->count ? length : h->count;
+    for (uint32_t i = 0; i < n; i++)
+        buf[i] = h->pool[(h->head + i) % h->poolSize];
+    h->head = (h->head + n) % h->poolSize;
+    h->count -= n;
+    *outLength = n;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_continuous_deinit(adc_continuous_handle_t h)
+{
+    adc_continuous_stop(h);
+    delete[] h->pool;
+    delete[] h->frame;
+    delete h;
+    return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef FAKE_ESP_CPU_H
+#define FAKE_ESP_CPU_H
+
+#include <Arduino.h>
+
+inline uint32_t esp_cpu_get_cycle_count() { return ESP.getCycleCount(); }
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef FAKE_ESP_SNTP_H
+#define FAKE_ESP_SNTP_H
+
+#include <Arduino.h>
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+
+inline void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) { Fake::sntpCallback = callback; }
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef FAKE_ESP_TIMER_H
+#define FAKE_ESP_TIMER_H
+
+// esp_timer 替身: 每个定时器对应一个 Fake 定时事件，回调在 Fake::run 推进时钟时执行
+
+#include <Arduino.h>
+#include "esp_err.h"
+
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum
+{
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR
+} esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+struct esp_timer
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    uint32_t event;
+};
+typedef struct esp_timer *esp_timer_handle_t;
+
+inline void esp_timer_fire(void *arg)
+{
+    esp_timer_handle_t timer = (esp_timer_handle_t)arg;
+    timer->callback(timer->arg);
+}
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out)
+{
+    *out = new esp_timer{args->callback, args->arg, 0};
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t us)
+{
+    Fake::cancel(timer->event);
+    timer->event = Fake::schedule(Fake::nowUs + us, esp_timer_fire, timer);
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t us)
+{
+    Fake::cancel(timer->event);
+    timer->event = Fake::schedule(Fake::nowUs + us, esp_timer_fire, timer, us);
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    Fake::cancel(timer->event);
+    timer->event = 0;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    esp_timer_stop(timer);
+    delete timer;
+    return ESP_OK;
+}
+
+inline int64_t esp_timer_get_time() { return (int64_t)Fake::nowUs; }
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef FAKE_GPIO_LL_H
+#define FAKE_GPIO_LL_H
+
+#include <Arduino.h>
+
+typedef int gpio_num_t;
+
+struct gpio_dev_t
+{
+};
+inline gpio_dev_t GPIO;
+
+inline int gpio_ll_get_level(gpio_dev_t *, gpio_num_t pin) { return Fake::levels[pin]; }
+inline void gpio_ll_set_level(gpio_dev_t *, gpio_num_t pin, uint32_t level) { Fake::levels[pin] = level; }
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef FAKE_SECRETS_H
+#define FAKE_SECRETS_H
+
+// src/secrets.h 不在仓库中; 主机测试连接的是 WiFi.h 替身，账号内容无关紧要
+#define WIFI_SSID "native"
+#define WIFI_PASSWORD "native"
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef FAKE_SOC_CAPS_H
+#define FAKE_SOC_CAPS_H
+
+// ESP32 (经典款) 的 ADC 能力
+#define SOC_ADC_DIGI_RESULT_BYTES 2
+#define SOC_ADC_MAX_CHANNEL_NUM 10
+#define SOC_ADC_PATT_LEN_MAX 16
+#define SOC_ADC_DIGI_MAX_BITWIDTH 12
+#define SOC_ADC_SAMPLE_FREQ_THRES_LOW 20000
+#define SOC_ADC_SAMPLE_FREQ_THRES_HIGH 2000000
+
+#endif
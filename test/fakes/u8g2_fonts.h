@@ -0,0 +1,36 @@
+#ifndef FAKE_U8G2_FONTS_H
+#define FAKE_U8G2_FONTS_H
+
+// U8g2lib.h 与 U8g2_for_Adafruit_GFX.h 替身共用的假字体: 只记录 {字高, 上升, 下降}，
+// 字形由码位生成 (见各自的 drawGlyph)。ASCII 宽为字高的一半，其它字符与字高相同
+
+#include <stdint.h>
+
+inline const uint8_t u8g2_font_wqy12_t_gb2312[] = {12, 10, 2};
+inline const uint8_t u8g2_font_wqy16_t_gb2312[] = {16, 13, 3};
+inline const uint8_t u8g2_font_5x7_tf[] = {7, 6, 1};
+inline const uint8_t u8g2_font_6x10_tf[] = {10, 7, 2};
+
+namespace FakeFont
+{
+    inline int glyphWidth(const uint8_t *font, uint32_t codepoint)
+    {
+        return codepoint < 0x80 ? font[0] / 2 : font[0];
+    }
+
+    // 解析一个 UTF-8 字符 (只处理合法输入)
+    inline uint32_t next(const char **s)
+    {
+        const uint8_t *p = (const uint8_t *)*s;
+        uint32_t c = *p++;
+        int more = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+        if (more > 0)
+            c &= 0x3F >> more;
+        while (more-- > 0 && (*p & 0xC0) == 0x80)
+            c = (c << 6) | (*p++ & 0x3F);
+        *s = (const char *)p;
+        return c;
+    }
+} // namespace FakeFont
+
+#endif
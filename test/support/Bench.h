@@ -0,0 +1,42 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// 主机基准测试的小工具: 计时与通过 Unity 输出结果
+// 数字只用于对比同一台机器上的两次提交，断言只检查与机器无关的量 (字节数、次数等)
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include <unity.h>
+
+namespace Bench
+{
+    inline uint64_t nowNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // 执行 fn() 并返回每次操作的平均耗时 (ns)
+    template <typename Fn>
+    double nsPerOp(uint32_t ops, Fn fn)
+    {
+        uint64_t start = nowNs();
+        fn();
+        return ops == 0 ? 0 : (double)(nowNs() - start) / ops;
+    }
+
+    inline void report(const char *format, ...)
+    {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        TEST_MESSAGE(buffer);
+    }
+} // namespace Bench
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef DEVICES_H
+#define DEVICES_H
+
+// 外设替身: 在 test/fakes 的虚拟时钟上按数据手册的时序驱动引脚，驱动程序 (Dht11.cpp、Ultrasonic.cpp)
+// 原样运行。电平变化作为 Fake 定时事件安排，由 Fake::run 推进时钟时产生，会触发引脚中断
+
+#include <Arduino.h>
+
+namespace Devices
+{
+    // DHT11: 主机拉低总线至少 18ms 后释放，传感器应答 (低 80us、高 80us)，再逐位输出
+    // 湿度整数、湿度小数、温度整数、温度小数和校验和 (每位低 50us + 高 26us 或 70us)，最后拉低 50us 后释放
+    class Dht11
+    {
+    public:
+        void attach(int pin)
+        {
+            this->pin = pin;
+            Fake::levels[pin] = HIGH; // 总线上拉
+            Fake::attachDevice(pin, onPin, this);
+        }
+
+        void set(float temperature, float humidity)
+        {
+            int t = (int)lrintf(fabsf(temperature) * 10), h = (int)lrintf(humidity * 10);
+            bytes[0] = h / 10;
+            bytes[1] = h % 10;
+            bytes[2] = t / 10;
+            bytes[3] = (t % 10) | (temperature < 0 ? 0x80 : 0);
+            bytes[4] = bytes[0] + bytes[1] + bytes[2] + bytes[3];
+        }
+
+        uint32_t replies = 0; // 完整输出的次数
+
+    private:
+        static const int STEPS = 2 + 40 * 2 + 1;
+
+        static void onPin(void *ctx, int pin)
+        {
+            Dht11 *d = (Dht11 *)ctx;
+            if (Fake::modes[pin] == OUTPUT)
+            {
+                if (Fake::levels[pin] == LOW)
+                    d->lowSince = Fake::nowUs;
+                return;
+            }
+            // 主机释放总线
+            Fake::levels[pin] = HIGH;
+            if (d->lowSince != NONE && Fake::nowUs - d->lowSince >= 18000 && d->step >= STEPS)
+                d->start();
+            d->lowSince = NONE;
+        }
+
+        void start()
+        {
+            int n = 0;
+            durations[n] = 80; // 应答
+            levelsOut[n++] = LOW;
+            durations[n] = 80;
+            levelsOut[n++] = HIGH;
+            for (int bit = 0; bit < 40; bit++)
+            {
+                durations[n] = 50;
+                levelsOut[n++] = LOW;
+                durations[n] = (bytes[bit / 8] & (0x80 >> (bit % 8))) ? 70 : 26;
+                levelsOut[n++] = HIGH;
+            }
+            durations[n] = 50;
+            levelsOut[n++] = LOW;
+            step = 0;
+            Fake::schedule(Fake::nowUs + 30, next, this); // 释放后约 30us 开始应答
+        }
+
+        static void next(void *ctx)
+        {
+            Dht11 *d = (Dht11 *)ctx;
+            if (d->step >= STEPS)
+            {
+                Fake::setLevel(d->pin, HIGH);
+                d->replies++;
+                return;
+            }
+            Fake::setLevel(d->pin, d->levelsOut[d->step]);
+            Fake::schedule(Fake::nowUs + d->durations[d->step], next, d);
+            d->step++;
+        }
+
+        static const uint64_t NONE = ~0ull;
+
+        int pin = -1;
+        uint8_t bytes[5] = {};
+        uint64_t lowSince = NONE;
+        int step = STEPS; // STEPS 表示空闲
+        uint16_t durations[STEPS];
+        uint8_t levelsOut[STEPS];
+    };
+
+    // HC-SR04: Trig 上至少 10us 的高电平结束后约 450us，Echo 拉高，持续时间为声波往返时间
+    // (每厘米 1000 / 17 us); 距离为 0 表示没有回波，Echo 保持 38ms 后拉低
+    class Sonar
+    {
+    public:
+        void attach(int trig, int echo)
+        {
+            trigPin = trig;
+            echoPin = echo;
+            Fake::attachDevice(trig, onTrig, this);
+        }
+
+        int distanceCm = 0;
+        uint32_t pings = 0;
+
+    private:
+        static void onTrig(void *ctx, int pin)
+        {
+            Sonar *s = (Sonar *)ctx;
+            if (Fake::modes[pin] != OUTPUT)
+                return;
+            bool high = Fake::levels[pin] == HIGH;
+            if (high && !s->trigHigh)
+                s->trigSince = Fake::nowUs;
+            else if (!high && s->trigHigh && Fake::nowUs - s->trigSince >= 10 && !s->busy)
+            {
+                s->busy = true;
+                s->pings++;
+                Fake::schedule(Fake::nowUs + 450, rise, s);
+            }
+            s->trigHigh = high;
+        }
+
+        static void rise(void *ctx)
+        {
+            Sonar *s = (Sonar *)ctx;
+            Fake::setLevel(s->echoPin, HIGH);
+            uint64_t width = s->distanceCm > 0 ? ((uint64_t)s->distanceCm * 1000 + 16) / 17 : 38000;
+            Fake::schedule(Fake::nowUs + width, fall, s);
+        }
+
+        static void fall(void *ctx)
+        {
+            Sonar *s = (Sonar *)ctx;
+            Fake::setLevel(s->echoPin, LOW);
+            s->busy = false;
+        }
+
+        int trigPin = -1, echoPin = -1;
+        bool trigHigh = false, busy = false;
+        uint64_t trigSince = 0;
+    };
+
+    // 接地按键 (上拉输入): 在 at 时刻按下，按住 holdMs 后松开
+    inline void press(int pin, uint64_t atUs, uint32_t holdMs)
+    {
+        Fake::schedule(atUs, [](void *arg) { Fake::setLevel((int)(intptr_t)arg, LOW); }, (void *)(intptr_t)pin);
+        Fake::schedule(atUs + (uint64_t)holdMs * 1000, [](void *arg) { Fake::setLevel((int)(intptr_t)arg, HIGH); },
+                       (void *)(intptr_t)pin);
+    }
+} // namespace Devices
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef FRAME_BASELINE_H
+#define FRAME_BASELINE_H
+
+// test_bench_* 逐帧基准的基线 (对比方法见 FrameBench.h)。
+// 帧数、堆分配次数、显示与串口字节数与机器无关，超过即失败; 每帧耗时是在参考机器上测得的，只用于报告变化。
+// 有意改变这些数字的提交同时更新这里，测试输出中有可以直接替换的一行
+
+#include <stdint.h>
+
+namespace FrameBaseline
+{
+    struct Entry
+    {
+        const char *name;
+        uint32_t frames;
+        uint64_t allocations;
+        uint64_t displayBytes;
+        uint64_t serialBytes;
+        double nsPerFrame;
+    };
+
+    const Entry ENTRIES[] = {
+        {"SmartHub::update", 1500, 0, 8064, 307, 7000},
+        {"SmartMonitor::update", 3000, 0, 30720, 5746, 240},
+        {"SmartHubTft::update", 3000, 0, 163584, 5866, 230},
+    };
+} // namespace FrameBaseline
+
+#endif
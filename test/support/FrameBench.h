@@ -0,0 +1,122 @@
+#ifndef FRAME_BENCH_H
+#define FRAME_BENCH_H
+
+// 逐帧基准: 在 test/fakes 上运行模块的 update()，统计每帧的主机耗时、update() 中的堆分配次数，
+// 以及显示和串口输出的字节数，与 FrameBaseline.h 中记录的基线对比。
+// 分配次数和字节数只取决于虚拟时间和输入，与机器无关，超过基线即失败; 耗时只报告相对基线的变化。
+// 本文件替换了全局 operator new / delete，每个测试程序只能有一个源文件包含它
+
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include "Bench.h"
+#include "FrameBaseline.h"
+
+namespace FrameBench
+{
+    // 只在 update() 执行期间统计; 此时后台任务都处于阻塞状态 (见 Arduino.h 替身)，不会混入它们的分配
+    inline bool counting = false;
+    inline uint64_t allocations = 0;
+    inline uint64_t allocatedBytes = 0;
+
+    const double SLOWER_WARNING = 0.2; // 每帧耗时比基线多出该比例时提示检查
+
+    struct Result
+    {
+        const char *name;
+        uint32_t frames;
+        uint64_t allocations;
+        uint64_t allocatedBytes;
+        uint64_t displayBytes; // 由调用方填写: 发送给显示屏的字节数
+        uint64_t serialBytes;  // 由调用方填写: 串口输出的字节数
+        double nsPerFrame;
+        uint64_t maxNs; // 最长的一帧 (大部分帧只检查时间，工作集中在少数帧里)
+    };
+
+    // 每帧先推进 frameUs 的虚拟时间 (其间执行定时器、中断和后台任务)，再调用 input(i) 改变输入，
+    // 最后计时执行 update()
+    template <typename Input, typename Update>
+    Result run(const char *name, uint32_t frames, uint32_t frameUs, Input input, Update update)
+    {
+        Result r = {name, frames, 0, 0, 0, 0, 0, 0};
+        uint64_t ns = 0;
+        allocations = 0;
+        allocatedBytes = 0;
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            Fake::run(frameUs);
+            input(i);
+            uint64_t start = Bench::nowNs();
+            counting = true;
+            update();
+            counting = false;
+            uint64_t frameNs = Bench::nowNs() - start;
+            ns += frameNs;
+            if (frameNs > r.maxNs)
+                r.maxNs = frameNs;
+        }
+        r.allocations = allocations;
+        r.allocatedBytes = allocatedBytes;
+        r.nsPerFrame = frames == 0 ? 0 : (double)ns / frames;
+        return r;
+    }
+
+    inline const FrameBaseline::Entry *baseline(const char *name)
+    {
+        for (const FrameBaseline::Entry &e : FrameBaseline::ENTRIES)
+        {
+            if (strcmp(e.name, name) == 0)
+                return &e;
+        }
+        return nullptr;
+    }
+
+    // 报告结果并与基线对比; 同时输出一行可以直接替换 FrameBaseline.h 中对应项的基线
+    inline void check(const Result &r)
+    {
+        Bench::report("%s: %lu 帧，主机上每帧 %.0fns (最长 %lluns)，堆分配 %llu 次 (%llu 字节)，显示 %llu 字节，串口 %llu 字节",
+                      r.name, (unsigned long)r.frames, r.nsPerFrame, (unsigned long long)r.maxNs,
+                      (unsigned long long)r.allocations, (unsigned long long)r.allocatedBytes,
+                      (unsigned long long)r.displayBytes, (unsigned long long)r.serialBytes);
+        Bench::report("基线: {\"%s\", %lu, %llu, %llu, %llu, %.0f},", r.name, (unsigned long)r.frames,
+                      (unsigned long long)r.allocations, (unsigned long long)r.displayBytes,
+                      (unsigned long long)r.serialBytes, r.nsPerFrame);
+
+        const FrameBaseline::Entry *b = baseline(r.name);
+        TEST_ASSERT_NOT_NULL(b);
+        TEST_ASSERT_EQUAL_UINT32(b->frames, r.frames);
+        if (b->nsPerFrame > 0)
+        {
+            double change = r.nsPerFrame / b->nsPerFrame - 1;
+            Bench::report("每帧耗时相对基线 %+.0f%%%s", change * 100,
+                          change > SLOWER_WARNING ? " (明显变慢，请在同一台机器上与上一个提交对比)" : "");
+        }
+        TEST_ASSERT_TRUE_MESSAGE(r.allocations <= b->allocations, "update() 的堆分配次数超过基线");
+        TEST_ASSERT_TRUE_MESSAGE(r.displayBytes <= b->displayBytes, "显示输出字节数超过基线");
+        TEST_ASSERT_TRUE_MESSAGE(r.serialBytes <= b->serialBytes, "串口输出字节数超过基线");
+        if (r.allocations < b->allocations || r.displayBytes < b->displayBytes || r.serialBytes < b->serialBytes)
+            Bench::report("低于基线，请更新 FrameBaseline.h，避免之后的回退被掩盖");
+    }
+} // namespace FrameBench
+
+void *operator new(size_t size)
+{
+    if (FrameBench::counting)
+    {
+        FrameBench::allocations++;
+        FrameBench::allocatedBytes += size;
+    }
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+#endif
@@ -0,0 +1,177 @@
+// AdcStream::Stream: 由 AdcStream::Synth 代替 ADC 按 200Hz 写入 SmartHub 的四个通道，
+// 检查抽取、环形缓冲回绕处分段、落后时跳过并保持相位，以及 latest() 的最新值 / 平均值
+
+#include <unity.h>
+#include "Bench.h"
+#include "AdcStream/AdcStream.h"
+
+const int RATE_HZ = 200; // 与 SmartHub 的 ADC_RATE_HZ 相同
+
+AdcStream::Stream *stream;
+AdcStream::Synth *synth;
+int joyX, ldr, saw, noise;
+
+void setUp()
+{
+    stream = new AdcStream::Stream();
+    synth = new AdcStream::Synth(*stream, RATE_HZ);
+    joyX = synth->add({AdcStream::Wave::SINE, 2048, 1500, 1});
+    ldr = synth->add({AdcStream::Wave::SQUARE, 1000, 200, 5});
+    saw = synth->add({AdcStream::Wave::TRIANGLE, 2048, 2000, 0.5f});
+    noise = synth->add({AdcStream::Wave::NOISE, 2048, 100, 0});
+}
+
+void tearDown()
+{
+    delete synth;
+    delete stream;
+}
+
+// 读出全部新样本，返回个数; out 不为空时按顺序保存
+int drain(AdcStream::Subscriber *s, uint16_t *out = nullptr, int *blocks = nullptr)
+{
+    AdcStream::Block b;
+    int n = 0;
+    while (s->read(&b))
+    {
+        for (int i = 0; i < b.count; i++, n++)
+        {
+            if (out != nullptr)
+                out[n] = b.at(i);
+        }
+        if (blocks != nullptr)
+            (*blocks)++;
+    }
+    return n;
+}
+
+void test_channels_and_limits()
+{
+    TEST_ASSERT_EQUAL_INT(4, stream->channels());
+    TEST_ASSERT_NULL(stream->subscribe(7));
+    synth->pump(1000000);
+    TEST_ASSERT_EQUAL_UINT32(RATE_HZ, stream->written(joyX));
+    TEST_ASSERT_EQUAL_UINT32(RATE_HZ, stream->written(noise));
+
+    // 初始化失败后清空，可以重新添加通道
+    stream->reset();
+    TEST_ASSERT_EQUAL_INT(0, stream->channels());
+    TEST_ASSERT_EQUAL_INT(0, stream->addChannel());
+    TEST_ASSERT_EQUAL_UINT32(0, stream->written(0));
+}
+
+void test_decimation_keeps_every_nth_sample()
+{
+    AdcStream::Subscriber *all = stream->subscribe(saw, 1);
+    AdcStream::Subscriber *tenth = stream->subscribe(saw, 10);
+    static uint16_t full[RATE_HZ], decimated[RATE_HZ];
+
+    // 每 50ms 处理一次，与 loop() 的节奏相近
+    int n = 0, m = 0;
+    for (uint32_t t = 50000; t <= 1000000; t += 50000)
+    {
+        synth->pump(t);
+        n += drain(all, full + n);
+        m += drain(tenth, decimated + m);
+    }
+    TEST_ASSERT_EQUAL_INT(RATE_HZ, n);
+    TEST_ASSERT_EQUAL_INT(RATE_HZ / 10, m);
+    for (int i = 0; i < m; i++)
+        TEST_ASSERT_EQUAL_UINT16(full[i * 10], decimated[i]);
+    TEST_ASSERT_EQUAL_UINT32(0, tenth->lostSamples());
+}
+
+void test_blocks_split_at_ring_wrap()
+{
+    AdcStream::Subscriber *s = stream->subscribe(joyX, 1);
+    synth->pump((uint64_t)(AdcStream::RING_LEN - 10) * 1000000 / RATE_HZ);
+    drain(s);
+
+    // 接下来的 20 个样本跨过缓冲末尾: 分成两段交出，内容与写入顺序一致
+    synth->pump((uint64_t)(AdcStream::RING_LEN + 10) * 1000000 / RATE_HZ);
+    uint16_t got[32];
+    int blocks = 0;
+    TEST_ASSERT_EQUAL_INT(20, drain(s, got, &blocks));
+    TEST_ASSERT_EQUAL_INT(2, blocks);
+
+    AdcStream::Stream ref;
+    AdcStream::Synth refSynth(ref, RATE_HZ);
+    refSynth.add({AdcStream::Wave::SINE, 2048, 1500, 1});
+    AdcStream::Subscriber *r = ref.subscribe(0, 1);
+    refSynth.pump((uint64_t)(AdcStream::RING_LEN - 10) * 1000000 / RATE_HZ);
+    drain(r);
+    refSynth.pump((uint64_t)(AdcStream::RING_LEN + 10) * 1000000 / RATE_HZ);
+    uint16_t expected[32];
+    drain(r, expected);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, got, 20);
+}
+
+void test_lagging_subscriber_skips_and_keeps_phase()
+{
+    AdcStream::Subscriber *s = stream->subscribe(saw, 4);
+    AdcStream::Subscriber *all = stream->subscribe(saw, 1);
+
+    // 3 秒没有读取 (600 个样本)，只保留最近 MAX_LAG 个，按抽取系数的整数倍跳过
+    synth->pump(3000000);
+    static uint16_t full[AdcStream::MAX_LAG], got[AdcStream::MAX_LAG];
+    int n = drain(all, full);
+    int m = drain(s, got);
+    TEST_ASSERT_EQUAL_INT(AdcStream::MAX_LAG, n);
+    TEST_ASSERT_EQUAL_INT(AdcStream::MAX_LAG / 4, m);
+    TEST_ASSERT_EQUAL_UINT32((600 - AdcStream::MAX_LAG) / 4, s->lostSamples());
+    TEST_ASSERT_EQUAL_UINT32(600 - AdcStream::MAX_LAG, all->lostSamples());
+    for (int i = 0; i < m; i++)
+        TEST_ASSERT_EQUAL_UINT16(full[i * 4], got[i]);
+}
+
+void test_latest_value_and_mean()
+{
+    AdcStream::Subscriber *x = stream->subscribe(joyX, 2);
+    AdcStream::Subscriber *light = stream->subscribe(ldr, 20);
+    TEST_ASSERT_EQUAL_INT(123, x->latest(123)); // 还没有样本
+
+    // 方波 5Hz: 1 秒内的平均值等于中心值
+    synth->pump(1000000);
+    TEST_ASSERT_INT_WITHIN(1, 1000, light->latest(0, true));
+    int last = x->latest(0);
+    TEST_ASSERT_EQUAL_INT(last, x->latest(last)); // 没有新样本时返回 fallback
+    TEST_ASSERT_INT_WITHIN(1500, 2048, last);
+}
+
+void test_read_benchmark()
+{
+    // SmartHub 的订阅组合: 摇杆 100Hz x2、光敏和电位器 10Hz 平均
+    AdcStream::Subscriber *subs[4] = {stream->subscribe(joyX, 2), stream->subscribe(ldr, 20),
+                                      stream->subscribe(saw, 20), stream->subscribe(noise, 2)};
+    const int SECONDS = 3600;
+    uint32_t delivered = 0;
+    double ns = Bench::nsPerOp(SECONDS * 20, [&] {
+        for (int tick = 1; tick <= SECONDS * 20; tick++)
+        {
+            synth->pump((uint64_t)tick * 50000);
+            for (AdcStream::Subscriber *s : subs)
+            {
+                AdcStream::Block b;
+                while (s->read(&b))
+                    delivered += b.count;
+            }
+        }
+    });
+    Bench::report("%d 秒 x 4 通道，交出 %lu 个样本，主机上每 50ms (合成 + 读取) %.0fns",
+                  SECONDS, (unsigned long)delivered, ns);
+    TEST_ASSERT_EQUAL_UINT32(SECONDS * (RATE_HZ / 2 * 2 + RATE_HZ / 20 * 2), delivered);
+    for (AdcStream::Subscriber *s : subs)
+        TEST_ASSERT_EQUAL_UINT32(0, s->lostSamples());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_channels_and_limits);
+    RUN_TEST(test_decimation_keeps_every_nth_sample);
+    RUN_TEST(test_blocks_split_at_ring_wrap);
+    RUN_TEST(test_lagging_subscriber_skips_and_keeps_phase);
+    RUN_TEST(test_latest_value_and_mean);
+    RUN_TEST(test_read_benchmark);
+    return UNITY_END();
+}
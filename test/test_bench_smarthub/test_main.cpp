@@ -0,0 +1,87 @@
+// SmartHub::update() 逐帧基准: init() 之后在替身上运行 30 秒，每 20ms 一帧。
+// DHT11、HC-SR04、连续模式 ADC、Wi-Fi 与 NTP 都是模拟外设; 摇杆每 3 秒向右推一次，两次经过全部 5 个页面，
+// 趋势页中按下摇杆切换时间跨度，中途物体靠近触发报警、光照变暗。
+// 统计每帧耗时、堆分配次数、OLED 和串口输出字节数，与 FrameBaseline.h 对比 (见 FrameBench.h)
+
+#include <unity.h>
+#include <U8g2lib.h>
+#include "Bench.h"
+#include "Devices.h"
+#include "FrameBench.h"
+#include "SmartHub/SmartHub.h"
+#include "AdcStream/AdcStream.h"
+#include "NetManager/NetManager.h"
+#include "Ultrasonic/Ultrasonic.h"
+
+namespace SmartHub
+{
+    extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+    extern int currentMenu;
+    extern float temp;
+    extern bool alarmActive;
+}
+
+const int TRIG_PIN = 5, ECHO_PIN = 18, DHT_PIN = 13;
+const int LDR_PIN = 35, JOY_X_PIN = 34, JOY_Y_PIN = 32, JOY_SW_PIN = 14, POT_PIN = 33;
+
+const uint32_t FRAMES = 1500;
+const uint32_t FRAME_US = 20000;
+
+Devices::Dht11 dht;
+Devices::Sonar sonar;
+int pagesSeen = 0;   // 显示过的页面 (位)
+int alarmFrames = 0; // 报警的帧数
+
+void setUp() {}
+void tearDown() {}
+
+// 每帧的输入: 时间轴见文件开头
+void input(uint32_t)
+{
+    unsigned long ms = millis();
+    Fake::analog[JOY_X_PIN] = ms >= 3000 && ms % 3000 < 200 ? 4095 : 2048;
+    Fake::analog[LDR_PIN] = ms < 20000 ? 1500 : 500;
+    sonar.distanceCm = ms >= 12000 && ms < 15000 ? 30 : 80;
+    if (ms == 10000)
+        dht.set(24.1f, 58);
+    if (ms == 13500 || ms == 28500)
+        Devices::press(JOY_SW_PIN, Fake::nowUs + 1000, 100);
+    pagesSeen |= 1 << SmartHub::currentMenu;
+    alarmFrames += SmartHub::alarmActive;
+}
+
+void test_update_frames()
+{
+    Serial.capture = false;
+    dht.attach(DHT_PIN);
+    dht.set(23.4f, 61);
+    sonar.attach(TRIG_PIN, ECHO_PIN);
+    Fake::analog[JOY_X_PIN] = 2048; // 开机时摇杆居中，用于校准
+    Fake::analog[JOY_Y_PIN] = 2048;
+    Fake::analog[POT_PIN] = 2048; // 报警距离约 52cm
+    SmartHub::init();
+
+    uint32_t tiles = SmartHub::u8g2.tilesSent;
+    uint64_t serial = Serial.bytes;
+    FrameBench::Result r = FrameBench::run("SmartHub::update", FRAMES, FRAME_US, input, SmartHub::update);
+    r.displayBytes = (uint64_t)(SmartHub::u8g2.tilesSent - tiles) * 8;
+    r.serialBytes = Serial.bytes - serial;
+
+    // 外设替身与驱动配合正常，界面确实经过了全部页面
+    TEST_ASSERT_EQUAL_INT(0x1F, pagesSeen);
+    TEST_ASSERT_TRUE(alarmFrames > 0);
+    TEST_ASSERT_EQUAL_FLOAT(24.1f, SmartHub::temp);
+    TEST_ASSERT_EQUAL_INT(80, Ultrasonic::getDistance());
+    TEST_ASSERT_EQUAL_INT(NetManager::CONNECTED, NetManager::getLinkState());
+    TEST_ASSERT_TRUE(NetManager::isTimeSynced());
+    TEST_ASSERT_EQUAL_UINT32(0, AdcStream::getStats().overflows);
+    TEST_ASSERT_TRUE(AdcStream::getStats().samples > 0);
+    FrameBench::check(r);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_update_frames);
+    return UNITY_END();
+}
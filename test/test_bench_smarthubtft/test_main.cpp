@@ -0,0 +1,68 @@
+// SmartHubTft::update() 逐帧基准: init() 之后在替身上运行 30 秒，每 10ms 一帧。
+// ST7789 是内存中的帧缓冲，U8g2_for_Adafruit_GFX 替身逐像素画字形; 按键在 8 秒和 16 秒各单击一次，
+// 两种显示模式都会出现，20 秒后光照超过阈值触发报警。
+// 统计每帧耗时、堆分配次数、写入 TFT 的字节数 (每像素 2 字节) 和串口输出字节数，与 FrameBaseline.h 对比 (见 FrameBench.h)
+
+#include <unity.h>
+#include <Adafruit_ST7789.h>
+#include "Bench.h"
+#include "Devices.h"
+#include "FrameBench.h"
+#include "SmartHubTft/SmartHubTft.h"
+#include "GlyphCache/GlyphCache.h"
+
+namespace SmartHubTft
+{
+    extern Adafruit_ST7789 tft;
+    extern GlyphCache::Cache glyphCache;
+    extern float temperature;
+    extern bool displayMode;
+}
+
+const int DHT_PIN = 13, LDR_PIN = 35, POT_PIN = 34, BTN_PIN = 14;
+
+const uint32_t FRAMES = 3000;
+const uint32_t FRAME_US = 10000;
+
+Devices::Dht11 dht;
+int modeFrames[2]; // 每种显示模式的帧数
+
+void setUp() {}
+void tearDown() {}
+
+void input(uint32_t)
+{
+    unsigned long ms = millis();
+    Fake::analog[LDR_PIN] = ms < 20000 ? 1500 : 3000;
+    if (ms == 8000 || ms == 16000)
+        Devices::press(BTN_PIN, Fake::nowUs + 1000, 80);
+    modeFrames[SmartHubTft::displayMode]++;
+}
+
+void test_update_frames()
+{
+    Serial.capture = false;
+    dht.attach(DHT_PIN);
+    dht.set(26.5f, 48);
+    Fake::analog[POT_PIN] = 2500;
+    SmartHubTft::init();
+
+    uint64_t pixels = SmartHubTft::tft.pixelsWritten;
+    uint64_t serial = Serial.bytes;
+    FrameBench::Result r = FrameBench::run("SmartHubTft::update", FRAMES, FRAME_US, input, SmartHubTft::update);
+    r.displayBytes = (SmartHubTft::tft.pixelsWritten - pixels) * 2;
+    r.serialBytes = Serial.bytes - serial;
+
+    TEST_ASSERT_TRUE(modeFrames[0] > 0 && modeFrames[1] > 0);
+    TEST_ASSERT_FALSE(SmartHubTft::displayMode);
+    TEST_ASSERT_EQUAL_FLOAT(26.5f, SmartHubTft::temperature);
+    TEST_ASSERT_TRUE(SmartHubTft::glyphCache.getStats().hits > 0);
+    FrameBench::check(r);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_update_frames);
+    return UNITY_END();
+}
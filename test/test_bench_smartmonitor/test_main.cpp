@@ -0,0 +1,66 @@
+// SmartMonitor::update() 逐帧基准: init() 之后在替身上运行 30 秒，每 10ms 一帧。
+// DHT11 是模拟外设，光照和阈值由 analogRead 给出; 按键在 8 秒和 16 秒各单击一次 (经引脚中断进入手势引擎)，
+// 两种显示模式都会出现，20 秒后光照超过阈值触发报警。
+// 统计每帧耗时、堆分配次数、OLED 和串口 (二进制遥测) 输出字节数，与 FrameBaseline.h 对比 (见 FrameBench.h)
+
+#include <unity.h>
+#include <U8g2lib.h>
+#include "Bench.h"
+#include "Devices.h"
+#include "FrameBench.h"
+#include "SmartMonitor/SmartMonitor.h"
+
+namespace SmartMonitor
+{
+    extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+    extern float temperature;
+    extern bool displayMode;
+}
+
+const int DHT_PIN = 13, LDR_PIN = 35, POT_PIN = 34, BTN_PIN = 14;
+
+const uint32_t FRAMES = 3000;
+const uint32_t FRAME_US = 10000;
+
+Devices::Dht11 dht;
+int modeFrames[2]; // 每种显示模式的帧数
+
+void setUp() {}
+void tearDown() {}
+
+void input(uint32_t)
+{
+    unsigned long ms = millis();
+    Fake::analog[LDR_PIN] = ms < 20000 ? 1500 : 3000;
+    if (ms == 8000 || ms == 16000)
+        Devices::press(BTN_PIN, Fake::nowUs + 1000, 80);
+    modeFrames[SmartMonitor::displayMode]++;
+}
+
+void test_update_frames()
+{
+    Serial.capture = false;
+    dht.attach(DHT_PIN);
+    dht.set(26.5f, 48);
+    Fake::analog[POT_PIN] = 2500;
+    SmartMonitor::init();
+
+    uint32_t tiles = SmartMonitor::u8g2.tilesSent;
+    uint64_t serial = Serial.bytes;
+    FrameBench::Result r = FrameBench::run("SmartMonitor::update", FRAMES, FRAME_US, input, SmartMonitor::update);
+    r.displayBytes = (uint64_t)(SmartMonitor::u8g2.tilesSent - tiles) * 8;
+    r.serialBytes = Serial.bytes - serial;
+
+    TEST_ASSERT_TRUE(modeFrames[0] > 0 && modeFrames[1] > 0);
+    TEST_ASSERT_FALSE(SmartMonitor::displayMode); // 两次单击后回到环境数据
+    TEST_ASSERT_EQUAL_FLOAT(26.5f, SmartMonitor::temperature);
+    TEST_ASSERT_TRUE(Fake::ledcWrites > 0); // 颜色过渡由 "timers" 任务写入 LEDC
+    FrameBench::check(r);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_update_frames);
+    return UNITY_END();
+}
@@ -0,0 +1,169 @@
+// Dht11::Decoder: 按数据手册时序生成下降沿序列 (带抖动)，检查解码和各类错误
+
+#include <unity.h>
+#include "Dht11/Dht11.h"
+
+Dht11::Decoder decoder;
+uint32_t seed = 1;
+
+// ±6us 抖动，与实测中断延迟同一量级
+int jitter()
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int)((seed >> 8) % 13) - 6;
+}
+
+// 喂入一次完整应答: 应答低电平 80us + 高电平 80us，之后每位 50us 低电平 + 27us (0) / 70us (1) 高电平
+void feedResponse(const uint8_t bytes[5], uint32_t t = 1000)
+{
+    decoder.onFall(t); // 应答低电平开始
+    t += 160;
+    decoder.onFall(t + jitter()); // 起始位
+    for (int bit = 0; bit < 40; bit++)
+    {
+        bool one = bytes[bit / 8] & (0x80 >> (bit % 8));
+        t += 50 + (one ? 70 : 27);
+        decoder.onFall(t + jitter());
+    }
+}
+
+void makeFrame(uint8_t hum, uint8_t humDec, uint8_t temp, uint8_t tempDec, uint8_t out[5])
+{
+    out[0] = hum;
+    out[1] = humDec;
+    out[2] = temp;
+    out[3] = tempDec;
+    out[4] = hum + humDec + temp + tempDec;
+}
+
+void setUp()
+{
+    decoder.reset();
+    seed = 1;
+}
+
+void tearDown() {}
+
+void test_decodes_reading()
+{
+    uint8_t frame[5], bytes[5];
+    makeFrame(55, 0, 24, 3, frame);
+    feedResponse(frame);
+    TEST_ASSERT_EQUAL_INT(Dht11::EDGE_COUNT, decoder.edgeCount());
+    TEST_ASSERT_EQUAL_INT(Dht11::OK, decoder.decode(bytes));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, bytes, 5);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 55.0f, Dht11::Decoder::toHumidity(bytes));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 24.3f, Dht11::Decoder::toTemperature(bytes));
+}
+
+void test_all_bit_patterns()
+{
+    uint8_t frame[5], bytes[5];
+    for (int v = 0; v < 256; v++)
+    {
+        decoder.reset();
+        makeFrame(v, 255 - v, v ^ 0x5A, v >> 1, frame);
+        feedResponse(frame);
+        TEST_ASSERT_EQUAL_INT(Dht11::OK, decoder.decode(bytes));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, bytes, 5);
+    }
+}
+
+void test_negative_temperature()
+{
+    uint8_t frame[5], bytes[5];
+    makeFrame(40, 0, 3, 0x80 | 5, frame);
+    feedResponse(frame);
+    TEST_ASSERT_EQUAL_INT(Dht11::OK, decoder.decode(bytes));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -3.5f, Dht11::Decoder::toTemperature(bytes));
+}
+
+void test_checksum_error()
+{
+    uint8_t frame[5], bytes[5];
+    makeFrame(55, 0, 24, 3, frame);
+    frame[2] ^= 0x01; // 传输中翻转一位
+    feedResponse(frame);
+    TEST_ASSERT_EQUAL_INT(Dht11::CHECKSUM, decoder.decode(bytes));
+}
+
+void test_timeout_when_edges_missing()
+{
+    uint8_t bytes[5];
+    for (int i = 0; i < 30; i++)
+        decoder.onFall(1000 + i * 100);
+    TEST_ASSERT_EQUAL_INT(Dht11::TIMEOUT, decoder.decode(bytes));
+    decoder.reset();
+    TEST_ASSERT_EQUAL_INT(Dht11::TIMEOUT, decoder.decode(bytes));
+}
+
+void test_bad_pulse_when_edge_lost()
+{
+    // 中断丢掉中间一个下降沿: 两位合成一个 150us 以上的间隔，尾部多一个毛刺凑足数量
+    uint8_t frame[5], bytes[5];
+    makeFrame(55, 0, 24, 3, frame);
+    uint32_t t = 1000;
+    decoder.onFall(t);
+    t += 160;
+    decoder.onFall(t);
+    for (int bit = 0; bit < 40; bit++)
+    {
+        bool one = frame[bit / 8] & (0x80 >> (bit % 8));
+        t += 50 + (one ? 70 : 27);
+        if (bit != 18)
+            decoder.onFall(t);
+    }
+    decoder.onFall(t + 80);
+    TEST_ASSERT_EQUAL_INT(Dht11::EDGE_COUNT, decoder.edgeCount());
+    TEST_ASSERT_EQUAL_INT(Dht11::BAD_PULSE, decoder.decode(bytes));
+}
+
+void test_leading_glitches_ignored()
+{
+    // 主机释放总线时的毛刺多出两个下降沿，只取最后 41 个
+    uint8_t frame[5], bytes[5];
+    makeFrame(61, 0, 19, 8, frame);
+    decoder.onFall(500);
+    decoder.onFall(503);
+    feedResponse(frame);
+    TEST_ASSERT_EQUAL_INT(Dht11::EDGE_COUNT + 2, decoder.edgeCount());
+    TEST_ASSERT_EQUAL_INT(Dht11::OK, decoder.decode(bytes));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, bytes, 5);
+}
+
+void test_many_glitches_keep_last_edges()
+{
+    // 毛刺比缓冲余量多: 旧边沿被覆盖，最后 41 个仍然完整
+    uint8_t frame[5], bytes[5];
+    makeFrame(33, 0, 27, 6, frame);
+    for (int i = 0; i < 20; i++)
+        decoder.onFall(100 + i * 3);
+    feedResponse(frame);
+    TEST_ASSERT_EQUAL_INT(Dht11::EDGE_COUNT + 20, decoder.edgeCount());
+    TEST_ASSERT_EQUAL_INT(Dht11::OK, decoder.decode(bytes));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, bytes, 5);
+}
+
+void test_timestamp_wraparound()
+{
+    uint8_t frame[5], bytes[5];
+    makeFrame(47, 0, 31, 1, frame);
+    feedResponse(frame, 0xFFFFFFFFu - 2000);
+    TEST_ASSERT_EQUAL_INT(Dht11::OK, decoder.decode(bytes));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, bytes, 5);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_decodes_reading);
+    RUN_TEST(test_all_bit_patterns);
+    RUN_TEST(test_negative_temperature);
+    RUN_TEST(test_checksum_error);
+    RUN_TEST(test_timeout_when_edges_missing);
+    RUN_TEST(test_bad_pulse_when_edge_lost);
+    RUN_TEST(test_leading_glitches_ignored);
+    RUN_TEST(test_many_glitches_keep_last_edges);
+    RUN_TEST(test_timestamp_wraparound);
+    return UNITY_END();
+}
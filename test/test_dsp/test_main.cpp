@@ -0,0 +1,238 @@
+// Dsp: BiquadQ15 / FirQ15 的冲激响应和阶跃响应与 float 参考内核 (biquadRef / firRef) 对比，
+// Fir::init() 的系数检查，以及块处理与参考内核一致
+
+#include <type_traits>
+#include <unity.h>
+#include "Bench.h"
+#include "Dsp/Dsp.h"
+
+const int SAMPLE_HZ = 100; // 与 HeartBratTest 相同
+const int LEN = 512;       // 约 5 秒，覆盖 0.5Hz 高通的主要衰减过程
+const int16_t AMPLITUDE = 8192; // Q15 的 1/4 满量程，即要求的 2 位余量
+
+// 容差 (Q15 LSB，AMPLITUDE = 8192 LSB):
+// - 双二阶定点运算: 与使用同样 Q14 系数的 float 参考相比不超过 12 LSB (0.15%)。0.5Hz 高通的极点
+//   接近 1，每个样本的舍入误差经反馈放大，第一级截成 int16 的误差再经第二级放大
+// - 双二阶总误差: 与未量化系数的 float 参考相比不超过 32 LSB (0.4%)，主要来自 Q14 系数量化使
+//   高通极点偏移，阶跃响应的长拖尾上差别最大
+// - FIR: 不超过 1 LSB。没有反馈，只有系数舍入 (每个不超过 0.5 / 32768) 和一次输出舍入
+const int BIQUAD_ARITH_TOLERANCE = 12;
+const int BIQUAD_TOLERANCE = 32;
+const int FIR_TOLERANCE = 1;
+
+static_assert(!std::is_copy_constructible<Dsp::Fir>::value, "Fir 保存指向自身缓冲的指针，不能复制");
+static_assert(!std::is_copy_assignable<Dsp::Fir>::value, "Fir 保存指向自身缓冲的指针，不能复制");
+
+float inF[LEN], outF[LEN];
+int16_t inQ[LEN], outQ[LEN];
+
+// 冲激 (step = false) 或阶跃 (step = true)，float 与 Q15 输入数值相同
+void makeInput(bool step)
+{
+    for (int i = 0; i < LEN; i++)
+    {
+        inQ[i] = step || i == 0 ? AMPLITUDE : 0;
+        inF[i] = inQ[i];
+    }
+}
+
+int maxError()
+{
+    int worst = 0;
+    for (int i = 0; i < LEN; i++)
+    {
+        int e = (int)lrintf(fabsf(outF[i] - outQ[i]));
+        if (e > worst)
+            worst = e;
+    }
+    return worst;
+}
+
+// 把系数量化为 BiquadQ15 使用的 Q14 再转回 float
+Dsp::Coeffs quantized(const Dsp::Coeffs &k)
+{
+    Dsp::Coeffs q;
+    for (int i = 0; i < 5; i++)
+        q.c[i] = lrintf(k.c[i] * 16384) / 16384.0f;
+    return q;
+}
+
+// 两级双二阶 (HeartBratTest 的 0.5 - 5Hz 带通)，返回最大误差;
+// sameCoeffs 时 float 参考也使用 Q14 量化后的系数，只比较定点运算本身的误差
+int compareBiquads(bool step, bool sameCoeffs)
+{
+    Dsp::Coeffs stages[2] = {Dsp::highPass(SAMPLE_HZ, 0.5f), Dsp::lowPass(SAMPLE_HZ, 5)};
+    makeInput(step);
+    memcpy(outF, inF, sizeof(outF));
+    memcpy(outQ, inQ, sizeof(outQ));
+    for (const Dsp::Coeffs &k : stages)
+    {
+        float w[2] = {0, 0};
+        Dsp::Coeffs ref = sameCoeffs ? quantized(k) : k;
+        Dsp::biquadRef(outF, outF, LEN, ref.c, w);
+        Dsp::BiquadQ15 q(k);
+        q.process(outQ, outQ, LEN);
+    }
+    return maxError();
+}
+
+// 15 阶 Hamming 窗低通 (截止 0.1fs)，严格对称
+void designFir(float *h, int n)
+{
+    const float PI_F = 3.14159265f;
+    float sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        float m = i - (n - 1) / 2.0f;
+        float sinc = m == 0 ? 0.2f : sinf(2 * PI_F * 0.1f * m) / (PI_F * m);
+        h[i] = sinc * (0.54f - 0.46f * cosf(2 * PI_F * i / (n - 1)));
+        sum += h[i];
+    }
+    for (int i = 0; i < n; i++)
+        h[i] /= sum;
+    for (int i = 0; i < n / 2; i++)
+        h[n - 1 - i] = h[i]; // 消除 cosf 的舍入差异
+}
+
+const int TAPS = 15;
+
+int compareFirs(bool step)
+{
+    float h[TAPS], delay[TAPS] = {};
+    int pos = 0;
+    designFir(h, TAPS);
+    makeInput(step);
+    Dsp::firRef(inF, outF, LEN, h, delay, TAPS, &pos);
+    Dsp::FirQ15 q(h, TAPS);
+    q.process(inQ, outQ, LEN);
+    return maxError();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_biquad_q15_impulse_response()
+{
+    int arith = compareBiquads(false, true);
+    int total = compareBiquads(false, false);
+    Bench::report("双二阶冲激响应最大误差: 定点运算 %d LSB, 含系数量化 %d LSB", arith, total);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(BIQUAD_ARITH_TOLERANCE, arith);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(BIQUAD_TOLERANCE, total);
+}
+
+void test_biquad_q15_step_response()
+{
+    int arith = compareBiquads(true, true);
+    int total = compareBiquads(true, false);
+    Bench::report("双二阶阶跃响应最大误差: 定点运算 %d LSB, 含系数量化 %d LSB", arith, total);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(BIQUAD_ARITH_TOLERANCE, arith);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(BIQUAD_TOLERANCE, total);
+    // 带通没有直流增益: 5 秒后阶跃响应回到 0 附近，Q15 版本不能卡在误差反馈的极限环上
+    TEST_ASSERT_INT_WITHIN(BIQUAD_ARITH_TOLERANCE, 0, outQ[LEN - 1]);
+}
+
+void test_fir_q15_impulse_response()
+{
+    int e = compareFirs(false);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(FIR_TOLERANCE, e);
+    // 冲激响应就是系数本身
+    float h[TAPS];
+    designFir(h, TAPS);
+    for (int i = 0; i < TAPS; i++)
+        TEST_ASSERT_INT_WITHIN(FIR_TOLERANCE, lrintf(h[i] * AMPLITUDE), outQ[i]);
+    TEST_ASSERT_EQUAL_INT16(0, outQ[TAPS]);
+}
+
+void test_fir_q15_step_response()
+{
+    int e = compareFirs(true);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(FIR_TOLERANCE, e);
+    // 直流增益为 1: 填满延迟线后输出等于输入
+    TEST_ASSERT_INT_WITHIN(FIR_TOLERANCE, AMPLITUDE, outQ[LEN - 1]);
+}
+
+void test_fir_init_checks_symmetry()
+{
+    float h[TAPS];
+    designFir(h, TAPS);
+    Dsp::Fir fir;
+    TEST_ASSERT_TRUE(fir.init(h, TAPS));
+
+    h[2] += 0.01f;
+    Dsp::Fir skewed;
+    TEST_ASSERT_FALSE(skewed.init(h, TAPS));
+    // 初始化失败的滤波器输出 0，不读未初始化的系数
+    makeInput(true);
+    skewed.process(inF, outF, 16);
+    for (int i = 0; i < 16; i++)
+        TEST_ASSERT_EQUAL_FLOAT(0, outF[i]);
+
+    float big[Dsp::MAX_TAPS + 1] = {};
+    TEST_ASSERT_FALSE(skewed.init(big, Dsp::MAX_TAPS + 1));
+    TEST_ASSERT_FALSE(skewed.init(h, 0));
+    const float odd[] = {0.25f, 0.5f, 0.25f};
+    TEST_ASSERT_TRUE(skewed.init(odd, 3));
+}
+
+void test_fir_chain_matches_reference()
+{
+    // 经 Chain 按块 (跨越 MAX_BLOCK) 处理与参考内核一次处理的结果相同
+    float h[TAPS], delay[TAPS] = {};
+    int pos = 0;
+    designFir(h, TAPS);
+    makeInput(true);
+    for (int i = 0; i < LEN; i++)
+        inF[i] = AMPLITUDE * sinf(i * 0.3f);
+    Dsp::firRef(inF, outF, LEN, h, delay, TAPS, &pos);
+
+    Dsp::Fir fir;
+    TEST_ASSERT_TRUE(fir.init(h, TAPS));
+    Dsp::Chain chain;
+    chain.add(fir);
+    static float blocked[LEN];
+    chain.process(inF, blocked, LEN);
+    for (int i = 0; i < LEN; i++)
+        TEST_ASSERT_EQUAL_FLOAT(outF[i], blocked[i]);
+}
+
+void test_q15_benchmark()
+{
+    // 与板上 Dsp::benchmark() 相同的两级带通: 块 float 与块 Q15 每个样本的耗时
+    const int ROUNDS = 2000;
+    Dsp::Biquad a(Dsp::highPass(SAMPLE_HZ, 0.5f)), b(Dsp::lowPass(SAMPLE_HZ, 5));
+    Dsp::Chain chain;
+    chain.add(a);
+    chain.add(b);
+    Dsp::BiquadQ15 c(Dsp::highPass(SAMPLE_HZ, 0.5f)), d(Dsp::lowPass(SAMPLE_HZ, 5));
+    for (int i = 0; i < LEN; i++)
+    {
+        inF[i] = 600 * sinf(2 * 3.14159265f * 1.2f * i / SAMPLE_HZ); // 72 BPM
+        inQ[i] = (int16_t)(inF[i] * 4);
+    }
+    double floatNs = Bench::nsPerOp(ROUNDS * LEN, [&] {
+        for (int r = 0; r < ROUNDS; r++)
+            chain.process(inF, outF, LEN);
+    });
+    double q15Ns = Bench::nsPerOp(ROUNDS * LEN, [&] {
+        for (int r = 0; r < ROUNDS; r++)
+        {
+            c.process(inQ, outQ, LEN);
+            d.process(outQ, outQ, LEN);
+        }
+    });
+    Bench::report("两级双二阶，主机上每样本: 块 float %.2fns, 块 Q15 %.2fns", floatNs, q15Ns);
+    TEST_ASSERT_TRUE(isfinite(outF[LEN - 1]));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_biquad_q15_impulse_response);
+    RUN_TEST(test_biquad_q15_step_response);
+    RUN_TEST(test_fir_q15_impulse_response);
+    RUN_TEST(test_fir_q15_step_response);
+    RUN_TEST(test_fir_init_checks_symmetry);
+    RUN_TEST(test_fir_chain_matches_reference);
+    RUN_TEST(test_q15_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,192 @@
+// Fade::Sequencer: 在主机上模拟 LEDC 逐步执行 (跳变立即生效，渐变和保持各占 ms 毫秒)，
+// 检查预设动画的周期 (呼吸 5120ms、闪烁 500ms)、伽马分段端点、步骤首尾相接，以及停止条件
+
+#include <unity.h>
+#include "Bench.h"
+#include "Fade/Fade.h"
+
+using Fade::GAMMA_TABLE;
+using Fade::MAX_DUTY;
+using Fade::SEGMENTS;
+
+// 代替 Fade.cpp 的 advance(): 跳变直接写入，其余步骤交给 "硬件" 并推进时间
+struct Sim
+{
+    Fade::Sequencer seq;
+    uint32_t now = 0;  // ms
+    uint32_t duty = 0; // 当前占空比
+    uint32_t jumps = 0, steps = 0, gaps = 0;
+    uint32_t litMs = 0; // 占空比不为 0 的时间 (保持步骤)
+
+    void start(const Fade::Animation &a, uint8_t level)
+    {
+        seq.start(a, level);
+        duty = GAMMA_TABLE[level];
+    }
+
+    // 执行一个非跳变步骤 (之前的跳变一并执行)，动画结束返回 false
+    bool step(Fade::Step *out = nullptr)
+    {
+        Fade::Step s;
+        while (seq.next(&s))
+        {
+            if (s.from != duty)
+                gaps++; // 硬件从上一步结束的占空比接着渐变，步骤之间不能断开
+            duty = s.to;
+            if (s.isJump())
+            {
+                jumps++;
+                continue;
+            }
+            if (s.isHold() && duty > 0)
+                litMs += s.ms;
+            now += s.ms;
+            steps++;
+            if (out != nullptr)
+                *out = s;
+            return true;
+        }
+        return false;
+    }
+};
+
+Sim *sim;
+
+void setUp() { sim = new Sim(); }
+void tearDown() { delete sim; }
+
+void test_breathe_cycle_is_5120ms()
+{
+    sim->start(Fade::BREATHE, 0);
+    for (int cycle = 0; cycle < 10; cycle++)
+    {
+        uint32_t begin = sim->now;
+        // 渐亮: 4 段，每段结束在感知亮度的 1/4、2/4 ... 处
+        for (int part = 1; part <= SEGMENTS; part++)
+        {
+            Fade::Step s;
+            TEST_ASSERT_TRUE(sim->step(&s));
+            TEST_ASSERT_EQUAL_UINT32(GAMMA_TABLE[255 * part / SEGMENTS], s.to);
+            TEST_ASSERT_TRUE(s.to > s.from);
+        }
+        TEST_ASSERT_EQUAL_UINT32(begin + 2560, sim->now);
+        TEST_ASSERT_EQUAL_UINT32(MAX_DUTY, sim->duty);
+        // 渐灭
+        for (int part = 1; part <= SEGMENTS; part++)
+        {
+            Fade::Step s;
+            TEST_ASSERT_TRUE(sim->step(&s));
+            TEST_ASSERT_EQUAL_UINT32(GAMMA_TABLE[255 - 255 * part / SEGMENTS], s.to);
+            TEST_ASSERT_TRUE(s.to < s.from);
+        }
+        TEST_ASSERT_EQUAL_UINT32(begin + 5120, sim->now);
+        TEST_ASSERT_EQUAL_UINT32(0, sim->duty);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sim->gaps);
+    TEST_ASSERT_EQUAL_UINT32(0, sim->jumps);
+    TEST_ASSERT_FALSE(sim->seq.isDone());
+}
+
+void test_blink_cycle_is_500ms()
+{
+    sim->start(Fade::BLINK, 0);
+    for (int cycle = 0; cycle < 20; cycle++)
+    {
+        uint32_t begin = sim->now;
+        Fade::Step s;
+        TEST_ASSERT_TRUE(sim->step(&s)); // 跳到全亮后保持 250ms
+        TEST_ASSERT_TRUE(s.isHold());
+        TEST_ASSERT_EQUAL_UINT32(MAX_DUTY, s.to);
+        TEST_ASSERT_TRUE(sim->step(&s)); // 跳到熄灭后保持 250ms
+        TEST_ASSERT_TRUE(s.isHold());
+        TEST_ASSERT_EQUAL_UINT32(0, s.to);
+        TEST_ASSERT_EQUAL_UINT32(begin + 500, sim->now);
+    }
+    TEST_ASSERT_EQUAL_UINT32(20 * 250, sim->litMs);
+    TEST_ASSERT_EQUAL_UINT32(40, sim->jumps);
+    TEST_ASSERT_EQUAL_UINT32(0, sim->gaps);
+}
+
+void test_ramp_stops_at_full()
+{
+    // 从半亮开始: 先跳到 0，再用 2 秒渐亮，然后停止
+    sim->start(Fade::RAMP, 128);
+    while (sim->step())
+        ;
+    TEST_ASSERT_EQUAL_UINT32(2000, sim->now);
+    TEST_ASSERT_EQUAL_UINT32(SEGMENTS, sim->steps);
+    TEST_ASSERT_EQUAL_UINT32(1, sim->jumps);
+    TEST_ASSERT_EQUAL_UINT32(MAX_DUTY, sim->duty);
+    TEST_ASSERT_TRUE(sim->seq.isDone());
+    TEST_ASSERT_EQUAL_UINT8(255, sim->seq.level());
+}
+
+void test_start_from_current_level()
+{
+    // Ledc 在渐亮到一半时重新播放: 从当前亮度开始，关键帧的时长不变
+    sim->start(Fade::BREATHE, 0);
+    for (int i = 0; i < 5; i++)
+        sim->step();
+    TEST_ASSERT_EQUAL_UINT8(255, sim->seq.level()); // 最近完成的关键帧
+
+    sim->start(Fade::BREATHE, 100);
+    uint32_t begin = sim->now;
+    Fade::Step s;
+    TEST_ASSERT_TRUE(sim->step(&s));
+    TEST_ASSERT_EQUAL_UINT32(GAMMA_TABLE[100], s.from);
+    TEST_ASSERT_EQUAL_UINT32(GAMMA_TABLE[100 + 155 / SEGMENTS], s.to);
+    for (int i = 1; i < SEGMENTS; i++)
+        sim->step();
+    TEST_ASSERT_EQUAL_UINT32(begin + 2560, sim->now);
+    TEST_ASSERT_EQUAL_UINT32(MAX_DUTY, sim->duty);
+    TEST_ASSERT_EQUAL_UINT32(0, sim->gaps);
+}
+
+void test_short_keys_and_jump_only_loops()
+{
+    // 比段数还短的关键帧: 没有时间的段并入下一段，总时长不变
+    const Fade::Key shortKeys[] = {{255, 2}, {0, 3}};
+    const Fade::Animation shortAnim = {shortKeys, 2, false};
+    sim->start(shortAnim, 0);
+    Fade::Step s;
+    while (sim->step(&s))
+        TEST_ASSERT_TRUE(s.ms > 0);
+    TEST_ASSERT_EQUAL_UINT32(5, sim->now);
+    TEST_ASSERT_EQUAL_UINT32(0, sim->duty);
+    TEST_ASSERT_EQUAL_UINT32(0, sim->gaps);
+
+    // 全是跳变的循环动画执行一轮后停止，不会空转
+    const Fade::Key jumpKeys[] = {{255, 0}, {0, 0}};
+    const Fade::Animation jumpLoop = {jumpKeys, 2, true};
+    sim->start(jumpLoop, 0);
+    TEST_ASSERT_FALSE(sim->step());
+    TEST_ASSERT_EQUAL_UINT32(2, sim->jumps);
+    TEST_ASSERT_TRUE(sim->seq.isDone());
+}
+
+void test_sequencer_benchmark()
+{
+    // 呼吸灯连续运行 1000 个周期 (约 85 分钟)
+    const int CYCLES = 1000;
+    sim->start(Fade::BREATHE, 0);
+    double ns = Bench::nsPerOp(CYCLES * 2 * SEGMENTS, [&] {
+        for (int i = 0; i < CYCLES * 2 * SEGMENTS; i++)
+            sim->step();
+    });
+    Bench::report("%d 个呼吸周期，%lu 步，模拟 %lu ms，主机上每步 %.1fns",
+                  CYCLES, (unsigned long)sim->steps, (unsigned long)sim->now, ns);
+    TEST_ASSERT_EQUAL_UINT32(CYCLES * 5120u, sim->now);
+    TEST_ASSERT_EQUAL_UINT32(0, sim->gaps);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_breathe_cycle_is_5120ms);
+    RUN_TEST(test_blink_cycle_is_500ms);
+    RUN_TEST(test_ramp_stops_at_full);
+    RUN_TEST(test_start_from_current_level);
+    RUN_TEST(test_short_keys_and_jump_only_loops);
+    RUN_TEST(test_sequencer_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,245 @@
+// Gesture::Engine: 喂入带触点抖动的边沿序列，检查消抖和单击 / 双击 / 长按 / 重复的识别，
+// 以及 poll() 读取时间之后中断又写入边沿的竞争
+
+#include <unity.h>
+#include "Bench.h"
+#include "Gesture/Gesture.h"
+
+using Gesture::Event;
+
+Gesture::Engine *engine;
+int button;
+uint32_t now;
+uint32_t seed = 1;
+
+// 机械按键每次动作产生 3 - 8 个间隔 50 - 800us 的抖动边沿，最后停在 level
+void bounce(bool level)
+{
+    seed = seed * 1664525u + 1013904223u;
+    int n = 3 + (seed >> 8) % 6;
+    bool l = !level;
+    for (int i = 0; i < n; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        now += 50 + (seed >> 8) % 750;
+        l = !l;
+        engine->edge(button, l, now);
+    }
+    if (l != level)
+    {
+        now += 100;
+        engine->edge(button, level, now);
+    }
+}
+
+// 按 loop() 的节奏 (每 5ms) 推进到 now + us
+void idle(uint32_t us)
+{
+    uint32_t end = now + us;
+    while ((int32_t)(end - now) > 0)
+    {
+        now += (int32_t)(end - now) < 5000 ? end - now : 5000;
+        engine->update(now);
+    }
+}
+
+// 取出全部事件，类型依次写成字符串: C 单击、D 双击、L 长按、R 重复
+const char *events()
+{
+    static char out[64];
+    int n = 0;
+    Event e;
+    while (engine->poll(button, &e) && n < (int)sizeof(out) - 1)
+        out[n++] = "CDLR"[e.type];
+    out[n] = 0;
+    return out;
+}
+
+void setUp()
+{
+    engine = new Gesture::Engine();
+    button = engine->add(true);
+    now = 1000000;
+    seed = 1;
+}
+
+void tearDown() { delete engine; }
+
+void test_bouncy_click()
+{
+    bounce(true);
+    idle(120000);
+    TEST_ASSERT_TRUE(engine->isPressed(button));
+    bounce(false);
+    idle(50000);
+    TEST_ASSERT_FALSE(engine->isPressed(button));
+    TEST_ASSERT_EQUAL_STRING("", events()); // 还在等双击
+    idle(Gesture::DOUBLE_GAP_US);
+    TEST_ASSERT_EQUAL_STRING("C", events());
+}
+
+void test_click_time_is_end_of_bounce()
+{
+    bounce(true);
+    uint32_t settled = now;
+    idle(100000);
+    bounce(false);
+    uint32_t released = now;
+    idle(Gesture::DOUBLE_GAP_US + 20000);
+    Event e;
+    TEST_ASSERT_TRUE(engine->poll(button, &e));
+    TEST_ASSERT_EQUAL_INT(Gesture::CLICK, e.type);
+    TEST_ASSERT_EQUAL_UINT32(released + Gesture::DOUBLE_GAP_US, e.atUs);
+    TEST_ASSERT_TRUE(settled < released);
+}
+
+void test_bouncy_double_click()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        bounce(true);
+        idle(80000);
+        bounce(false);
+        idle(80000);
+    }
+    TEST_ASSERT_EQUAL_STRING("D", events());
+    idle(Gesture::DOUBLE_GAP_US);
+    TEST_ASSERT_EQUAL_STRING("", events());
+}
+
+void test_long_press_and_repeat()
+{
+    bounce(true);
+    idle(Gesture::LONG_PRESS_US + 3 * Gesture::REPEAT_US + 10000);
+    TEST_ASSERT_EQUAL_STRING("LRRR", events());
+    bounce(false);
+    idle(Gesture::DOUBLE_GAP_US + 20000);
+    TEST_ASSERT_EQUAL_STRING("", events()); // 长按松开不再产生单击
+}
+
+void test_short_glitches_ignored()
+{
+    // 干扰脉冲: 200us 的按下，短于消抖时间
+    for (int i = 0; i < 20; i++)
+    {
+        engine->edge(button, true, now + 10);
+        engine->edge(button, false, now + 210);
+        idle(50000);
+    }
+    TEST_ASSERT_FALSE(engine->isPressed(button));
+    idle(Gesture::DOUBLE_GAP_US);
+    TEST_ASSERT_EQUAL_STRING("", events());
+}
+
+void test_edge_after_time_read()
+{
+    // poll() 先读时间再 update(); 两者之间中断写入一个毛刺边沿 (晚 5us)，195us 后松开
+    uint32_t t = now;
+    engine->edge(button, true, t + 5);
+    engine->update(t);
+    TEST_ASSERT_FALSE(engine->isPressed(button));
+    engine->edge(button, false, t + 200);
+    now = t + 200;
+    idle(Gesture::LONG_PRESS_US + Gesture::DOUBLE_GAP_US);
+    TEST_ASSERT_FALSE(engine->isPressed(button));
+    TEST_ASSERT_EQUAL_STRING("", events());
+
+    // 按住时同样的竞争: 不能立即判为长按
+    t = now;
+    engine->edge(button, true, t + 5);
+    engine->update(t);
+    now = t + 5;
+    idle(20000);
+    TEST_ASSERT_TRUE(engine->isPressed(button));
+    TEST_ASSERT_EQUAL_STRING("", events());
+}
+
+void test_no_double_click_mode()
+{
+    int single = engine->add(false);
+    engine->edge(single, true, now + 100);
+    engine->edge(single, false, now + 50000);
+    int keep = button;
+    idle(70000);
+    button = single;
+    TEST_ASSERT_EQUAL_STRING("C", events()); // 松开消抖后立即产生
+    button = keep;
+}
+
+void test_timestamp_wraparound()
+{
+    now = 0xFFFFFFFFu - 40000;
+    bounce(true);
+    idle(80000); // 跨过 32 位回绕
+    bounce(false);
+    idle(Gesture::DOUBLE_GAP_US + 20000);
+    TEST_ASSERT_EQUAL_STRING("C", events());
+}
+
+void test_edge_queue_overflow()
+{
+    for (int i = 0; i < Gesture::EDGE_QUEUE_LEN + 10; i++)
+        engine->edge(button, i % 2 == 0, now + i);
+    TEST_ASSERT_EQUAL_UINT32(10, engine->edgeOverflows());
+    engine->update(now + 100);
+    TEST_ASSERT_EQUAL_UINT32(10, engine->edgeOverflows());
+}
+
+void test_update_benchmark()
+{
+    // 4 个按键每 500ms 各点击一次 (按住 100ms，带抖动)，按 5ms 轮询 10 分钟
+    for (int i = 1; i < 4; i++)
+        engine->add(i != 3);
+    uint32_t gestures = 0, updates = 0;
+    double ns = Bench::nsPerOp(1, [&] {
+        for (int period = 0; period < 1200; period++)
+        {
+            for (int level = 1; level >= 0; level--)
+            {
+                uint32_t start = now;
+                for (button = 0; button < 4; button++)
+                {
+                    now = start;
+                    bounce(level);
+                }
+                now = start;
+                for (int i = 0; i < (level ? 20 : 80); i++, updates++)
+                {
+                    now += 5000;
+                    engine->update(now);
+                }
+            }
+            Event e;
+            for (button = 0; button < 4; button++)
+            {
+                while (engine->poll(button, &e))
+                {
+                    TEST_ASSERT_EQUAL_INT(Gesture::CLICK, e.type);
+                    gestures++;
+                }
+            }
+        }
+    });
+    Bench::report("%lu 次 update，识别 %lu 次单击，主机上每次 update %.0fns",
+                  (unsigned long)updates, (unsigned long)gestures, ns / updates);
+    // 松开后还有 400ms，支持双击的按键也已确认为单击
+    TEST_ASSERT_EQUAL_UINT32(4 * 1200, gestures);
+    TEST_ASSERT_EQUAL_UINT32(0, engine->edgeOverflows());
+    TEST_ASSERT_EQUAL_UINT32(0, engine->eventDrops());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bouncy_click);
+    RUN_TEST(test_click_time_is_end_of_bounce);
+    RUN_TEST(test_bouncy_double_click);
+    RUN_TEST(test_long_press_and_repeat);
+    RUN_TEST(test_short_glitches_ignored);
+    RUN_TEST(test_edge_after_time_read);
+    RUN_TEST(test_no_double_click_mode);
+    RUN_TEST(test_timestamp_wraparound);
+    RUN_TEST(test_edge_queue_overflow);
+    RUN_TEST(test_update_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,134 @@
+// GpioEvent::Ring: 生产者和消费者各一个 std::thread 并发，检查记录不丢失、不重复、不乱序、内容完整，
+// 满时的丢弃计数; Gesture 和 Pulse 使用的记录类型同样适用
+// 配合 -fsanitize=thread 运行时不应报告数据竞争
+
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "Bench.h"
+#include "GpioEvent/GpioEvent.h"
+#include "Gesture/Gesture.h"
+#include "Pulse/Pulse.h"
+
+// 每个字段都由序号推出，复制到一半的记录一定对不上
+GpioEvent::Record makeRecord(uint32_t n)
+{
+    GpioEvent::Record r = {(uint8_t)(n * 7), (uint8_t)(n & 1), n};
+    return r;
+}
+
+bool consistent(const GpioEvent::Record &r)
+{
+    return r.pin == (uint8_t)(r.cycles * 7) && r.level == (r.cycles & 1);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_single_thread()
+{
+    GpioEvent::Ring<GpioEvent::Record, 8> ring;
+    for (uint32_t i = 0; i < 10; i++)
+        ring.push(makeRecord(i));
+    TEST_ASSERT_EQUAL_INT(8, ring.pending());
+    TEST_ASSERT_EQUAL_UINT32(8, ring.pushed());
+    TEST_ASSERT_EQUAL_UINT32(2, ring.overflows()); // 满了丢弃新记录
+
+    GpioEvent::Record batch[5];
+    TEST_ASSERT_EQUAL_INT(5, ring.popBatch(batch, 5));
+    TEST_ASSERT_EQUAL_UINT32(4, batch[4].cycles);
+    TEST_ASSERT_TRUE(ring.push(makeRecord(100))); // 跨过缓冲末尾
+    TEST_ASSERT_EQUAL_INT(4, ring.popBatch(batch, 5));
+    TEST_ASSERT_EQUAL_UINT32(100, batch[3].cycles);
+    TEST_ASSERT_FALSE(ring.pop(batch));
+}
+
+void test_other_record_types()
+{
+    GpioEvent::Ring<Gesture::Edge, 4> edges;
+    Gesture::Edge e = {3, true, 12345};
+    TEST_ASSERT_TRUE(edges.push(e));
+    Gesture::Edge out;
+    TEST_ASSERT_TRUE(edges.pop(&out));
+    TEST_ASSERT_EQUAL_UINT8(3, out.button);
+    TEST_ASSERT_TRUE(out.pressed);
+    TEST_ASSERT_EQUAL_UINT32(12345, out.atUs);
+
+    Pulse::SampleRing<4> samples;
+    for (uint16_t v = 1000; v < 1006; v++)
+        samples.push(v);
+    TEST_ASSERT_EQUAL_UINT32(2, samples.overflows());
+    uint16_t v;
+    TEST_ASSERT_TRUE(samples.pop(&v));
+    TEST_ASSERT_EQUAL_UINT16(1000, v);
+}
+
+void test_concurrent_producer_consumer()
+{
+    const uint32_t RECORDS = 1000000;
+    static GpioEvent::Ring<GpioEvent::Record, 256> ring; // 与 Exti 相同的长度
+    std::atomic<bool> done{false};
+    uint32_t received = 0, corrupt = 0, outOfOrder = 0, batches = 0;
+    int64_t last = -1;
+
+    // 消费者: 与 Exti::update() 一样成批取出
+    std::thread consumer([&] {
+        GpioEvent::Record batch[32];
+        for (;;)
+        {
+            bool finished = done.load(std::memory_order_acquire);
+            int n = ring.popBatch(batch, 32);
+            if (n == 0 && finished)
+                break;
+            if (n == 0)
+            {
+                std::this_thread::yield(); // 单核主机上让出 CPU 给生产者
+                continue;
+            }
+            batches++;
+            for (int i = 0; i < n; i++)
+            {
+                if (!consistent(batch[i]))
+                    corrupt++;
+                if ((int64_t)batch[i].cycles <= last)
+                    outOfOrder++;
+                last = batch[i].cycles;
+                received++;
+            }
+        }
+    });
+
+    // 生产者: 本线程代替中断; 满了计入 overflows 后重试，这样每条记录都应该送到
+    uint32_t full = 0;
+    double ns = Bench::nsPerOp(RECORDS, [&] {
+        for (uint32_t i = 0; i < RECORDS; i++)
+        {
+            while (!ring.push(makeRecord(i)))
+            {
+                full++;
+                std::this_thread::yield();
+            }
+        }
+    });
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, corrupt);
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_EQUAL_UINT32(RECORDS, received);
+    TEST_ASSERT_EQUAL_UINT32(RECORDS - 1, (uint32_t)last);
+    TEST_ASSERT_EQUAL_UINT32(RECORDS, ring.pushed());
+    TEST_ASSERT_EQUAL_UINT32(full, ring.overflows());
+    TEST_ASSERT_EQUAL_INT(0, ring.pending());
+    Bench::report("%lu 条记录 (%.1fns/条)，分 %lu 批取出，缓冲满 %lu 次",
+                  (unsigned long)RECORDS, ns, (unsigned long)batches, (unsigned long)full);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_single_thread);
+    RUN_TEST(test_other_record_types);
+    RUN_TEST(test_concurrent_producer_consumer);
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+// Profiler: 直方图的分桶与分位数计算，以及 PROFILE_SCOPE 在虚拟周期计数器上的测量
+
+#include <Arduino.h>
+#include <unity.h>
+#include "Profiler/Profiler.h"
+
+using Profiler::Histogram;
+
+Histogram hist;
+
+void setUp()
+{
+    hist.reset();
+    Fake::reset();
+    Profiler::setEnabled(true);
+    Profiler::reset();
+}
+
+void tearDown() {}
+
+void test_buckets_cover_range()
+{
+    // 相邻桶首尾相接，覆盖整个 uint32 范围
+    TEST_ASSERT_EQUAL_UINT32(0, Histogram::lowerBound(0));
+    for (int b = 0; b + 1 < Histogram::BUCKETS; b++)
+        TEST_ASSERT_EQUAL_UINT32(Histogram::lowerBound(b + 1), Histogram::upperBound(b) + 1);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, Histogram::upperBound(Histogram::BUCKETS - 1));
+    TEST_ASSERT_EQUAL_INT(Histogram::BUCKETS - 1, Histogram::bucketOf(UINT32_MAX));
+}
+
+void test_bucket_relative_error()
+{
+    uint32_t seed = 1;
+    for (int i = 0; i < 100000; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t v = seed >> (seed & 31);
+        int b = Histogram::bucketOf(v);
+        uint32_t lo = Histogram::lowerBound(b), hi = Histogram::upperBound(b);
+        TEST_ASSERT_TRUE(lo <= v && v <= hi);
+        // 桶宽不超过下界的 1/SUB
+        TEST_ASSERT_TRUE((uint64_t)(hi - lo) * Histogram::SUB <= (uint64_t)lo || hi - lo == 0);
+    }
+}
+
+void test_percentiles_uniform()
+{
+    for (uint32_t v = 1; v <= 1000; v++)
+        hist.record(v);
+    TEST_ASSERT_EQUAL_UINT32(1000, hist.count());
+    TEST_ASSERT_EQUAL_UINT32(1000, hist.max());
+    // 返回所在桶的上界: 误差在 +25% 以内，且不低于真实值
+    const int ps[] = {1, 10, 50, 90, 99};
+    for (int p : ps)
+    {
+        uint32_t exact = 10 * p;
+        uint32_t got = hist.percentile(p);
+        TEST_ASSERT_TRUE(got >= exact);
+        TEST_ASSERT_LESS_OR_EQUAL(exact + exact / Histogram::SUB, got);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, hist.percentile(100));
+}
+
+void test_percentile_edges()
+{
+    TEST_ASSERT_EQUAL_UINT32(0, hist.percentile(50));
+    hist.record(3);
+    TEST_ASSERT_EQUAL_UINT32(3, hist.percentile(0));
+    TEST_ASSERT_EQUAL_UINT32(3, hist.percentile(100));
+    // 长尾: 99 个 100，1 个 100000; p99 仍落在 100 的桶，p100 是最大值
+    hist.reset();
+    for (int i = 0; i < 99; i++)
+        hist.record(100);
+    hist.record(100000);
+    TEST_ASSERT_EQUAL_UINT32(Histogram::upperBound(Histogram::bucketOf(100)), hist.percentile(99));
+    TEST_ASSERT_EQUAL_UINT32(100000, hist.percentile(100));
+}
+
+void busy(uint32_t us)
+{
+    PROFILE_SCOPE("busy");
+    Fake::advanceUs(us);
+}
+
+void test_scope_on_fake_clock()
+{
+    for (int i = 0; i < 98; i++)
+        busy(100);
+    busy(2000);
+    busy(5000);
+
+    StringStream out;
+    Profiler::dump(out);
+    char count[16], p50[16], p99[16], max[16];
+    const char *line = strstr(out.text.c_str(), "busy");
+    TEST_ASSERT_NOT_NULL(line);
+    TEST_ASSERT_EQUAL_INT(4, sscanf(line, "busy %15s %15s %15s %15s", count, p50, p99, max));
+    TEST_ASSERT_EQUAL_STRING("100", count);
+    // 100us = 24000 周期，所在桶上界 24575 周期 = 102.4us
+    TEST_ASSERT_EQUAL_STRING("102.4", p50);
+    // p99 是 2000us 那一次: 480000 周期所在桶 [458752, 524287]，上界 2184.5us
+    TEST_ASSERT_EQUAL_STRING("2184.5", p99);
+    TEST_ASSERT_EQUAL_STRING("5000.0", max);
+}
+
+void test_disabled_and_serial_commands()
+{
+    Profiler::setEnabled(false);
+    busy(100);
+    StringStream serial;
+    serial.input = "pe";
+    Profiler::pollSerial(serial);
+    TEST_ASSERT_TRUE(serial.text.find("已暂停") != std::string::npos);
+    TEST_ASSERT_TRUE(serial.text.find("耗时测量已开启") != std::string::npos);
+    busy(100);
+    serial.input += "rp";
+    Profiler::pollSerial(serial);
+    TEST_ASSERT_TRUE(serial.text.find("耗时统计已清空") != std::string::npos);
+    TEST_ASSERT_TRUE(serial.text.rfind("busy                  0") != std::string::npos);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_buckets_cover_range);
+    RUN_TEST(test_bucket_relative_error);
+    RUN_TEST(test_percentiles_uniform);
+    RUN_TEST(test_percentile_edges);
+    RUN_TEST(test_scope_on_fake_clock);
+    RUN_TEST(test_disabled_and_serial_commands);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+// Pulse::Detector: 喂入 Pulse::Synth 合成的 PPG 波形 (重搏波、呼吸基线漂移、噪声)，
+// 检查 45 - 180 BPM 的读数、节律突变、手指移开，以及逐个采样与按块带通两条路径一致
+
+#include <unity.h>
+#include "Bench.h"
+#include "Pulse/Pulse.h"
+
+const int SAMPLE_HZ = 100; // 与 HeartBratTest 相同
+const int BLOCK = 32;
+
+// 逐个采样 feed() N 秒
+void run(Pulse::Detector &d, Pulse::Synth &synth, int seconds)
+{
+    for (int i = 0; i < seconds * SAMPLE_HZ; i++)
+        d.feed(synth.next());
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_exact_bpm_45_to_180()
+{
+    const int rates[] = {45, 50, 60, 72, 80, 90, 100, 110, 120, 135, 150, 180};
+    for (int bpm : rates)
+    {
+        Pulse::Synth synth(SAMPLE_HZ, bpm);
+        Pulse::Detector d;
+        d.begin(SAMPLE_HZ);
+        run(d, synth, 30);
+        TEST_ASSERT_EQUAL_INT(bpm, d.bpm());
+        TEST_ASSERT_GREATER_THAN(80, d.confidence());
+        // 每个周期只确认一次心跳 (重搏波不计入)，开头滤波器稳定期间最多少一两次
+        TEST_ASSERT_INT_WITHIN(2, bpm * 30 / 60, d.beatCount());
+    }
+}
+
+void test_every_rate_within_one_bpm()
+{
+    // 间隔按 10ms 采样量化，周期不是整数个采样时 (如 165 BPM = 36.4 个采样) 平均值可能差 1
+    for (int bpm = 45; bpm <= 180; bpm++)
+    {
+        Pulse::Synth synth(SAMPLE_HZ, bpm);
+        Pulse::Detector d;
+        d.begin(SAMPLE_HZ);
+        run(d, synth, 30);
+        TEST_ASSERT_INT_WITHIN(1, bpm, d.bpm());
+    }
+}
+
+void test_block_path_matches_feed()
+{
+    // HeartBratTest 的做法: 按块经 Dsp::Chain 带通后 feedFiltered()
+    Pulse::Synth a(SAMPLE_HZ, 72), b(SAMPLE_HZ, 72);
+    Pulse::Detector single, blocked;
+    single.begin(SAMPLE_HZ);
+    blocked.begin(SAMPLE_HZ);
+    Dsp::Biquad low(Pulse::Detector::bandLow(SAMPLE_HZ));
+    Dsp::Biquad high(Pulse::Detector::bandHigh(SAMPLE_HZ));
+    Dsp::Chain chain;
+    chain.add(low);
+    chain.add(high);
+
+    float block[BLOCK];
+    for (int done = 0; done < 30 * SAMPLE_HZ; done += BLOCK)
+    {
+        for (int i = 0; i < BLOCK; i++)
+        {
+            block[i] = b.next();
+            single.feed(a.next());
+        }
+        if (done == 0)
+            chain.settle(block[0]);
+        chain.process(block, block, BLOCK);
+        for (int i = 0; i < BLOCK; i++)
+            blocked.feedFiltered(block[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(72, blocked.bpm());
+    TEST_ASSERT_EQUAL_INT(single.bpm(), blocked.bpm());
+    TEST_ASSERT_EQUAL_UINT32(single.beatCount(), blocked.beatCount());
+}
+
+void test_rate_change_is_followed()
+{
+    // 节律突变超过 30%: 连续误检后重新开始平均，10 秒内跟上
+    const int changes[][2] = {{60, 90}, {72, 100}, {120, 60}};
+    for (const int *c : changes)
+    {
+        Pulse::Synth synth(SAMPLE_HZ, c[0]);
+        Pulse::Detector d;
+        d.begin(SAMPLE_HZ);
+        run(d, synth, 20);
+        TEST_ASSERT_EQUAL_INT(c[0], d.bpm());
+        synth.setBpm(c[1]);
+        run(d, synth, 10);
+        TEST_ASSERT_EQUAL_INT(c[1], d.bpm());
+    }
+}
+
+void test_finger_removed()
+{
+    Pulse::Synth synth(SAMPLE_HZ, 72);
+    Pulse::Detector d;
+    d.begin(SAMPLE_HZ, 1);
+    run(d, synth, 20);
+    TEST_ASSERT_EQUAL_INT(72, d.bpm());
+
+    // 只剩噪声: 超过两倍最长间隔后清空历史
+    Pulse::Synth noise(SAMPLE_HZ, 72, 0, 0.5f);
+    run(d, noise, 5);
+    TEST_ASSERT_EQUAL_INT(0, d.bpm());
+    TEST_ASSERT_EQUAL_INT(0, d.confidence());
+}
+
+void test_throughput()
+{
+    const int SAMPLES = 200000;
+    static float trace[SAMPLES];
+    Pulse::Synth synth(SAMPLE_HZ, 72);
+    for (int i = 0; i < SAMPLES; i++)
+        trace[i] = synth.next();
+
+    Pulse::Detector d;
+    d.begin(SAMPLE_HZ);
+    double ns = Bench::nsPerOp(SAMPLES, [&] {
+        for (int i = 0; i < SAMPLES; i++)
+            d.feed(trace[i]);
+    });
+    Bench::report("%d 个采样 -> %d BPM，置信度 %d%%，主机上每个采样 %.1fns",
+                  SAMPLES, d.bpm(), d.confidence(), ns);
+    TEST_ASSERT_EQUAL_INT(72, d.bpm());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_exact_bpm_45_to_180);
+    RUN_TEST(test_every_rate_within_one_bpm);
+    RUN_TEST(test_block_path_matches_feed);
+    RUN_TEST(test_rate_change_is_followed);
+    RUN_TEST(test_finger_removed);
+    RUN_TEST(test_throughput);
+    return UNITY_END();
+}
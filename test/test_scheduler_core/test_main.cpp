@@ -0,0 +1,171 @@
+// Scheduler::Core: 用虚拟时钟检查 EDF 选择、跳过与超时统计，并测量满任务表时的调度开销
+
+#include <unity.h>
+#include "Bench.h"
+#include "Scheduler/Scheduler.h"
+
+Scheduler::Core core;
+uint32_t vnow = 0; // 虚拟时钟 (us)
+char order[16];
+int orderLen = 0;
+
+uint32_t virtualClock() { return vnow; }
+
+template <char NAME, uint32_t COST_US>
+void work()
+{
+    if (orderLen < (int)sizeof(order) - 1)
+        order[orderLen++] = NAME;
+    vnow += COST_US;
+}
+
+// 按虚拟时间运行到 untilUs: 有就绪任务就执行，否则直接跳到下一次释放
+void runUntil(uint32_t untilUs)
+{
+    while (Scheduler::Core::before(vnow, untilUs))
+    {
+        if (core.runOnce(virtualClock) < 0)
+        {
+            uint32_t wait = core.untilNext(vnow);
+            vnow += wait < untilUs - vnow ? wait : untilUs - vnow;
+        }
+    }
+}
+
+void setUp()
+{
+    core.reset();
+    vnow = 0;
+    orderLen = 0;
+    order[0] = 0;
+}
+
+void tearDown() {}
+
+void test_earliest_deadline_first()
+{
+    core.add("a", work<'a', 100>, 10000, 10000, 0, 0);
+    core.add("b", work<'b', 100>, 10000, 2000, 0, 0);
+    core.add("c", work<'c', 100>, 10000, 2000, 5, 0); // 截止时间相同，优先级高的先执行
+    runUntil(1000);
+    order[orderLen] = 0;
+    TEST_ASSERT_EQUAL_STRING("cba", order);
+}
+
+void test_not_released_yet()
+{
+    core.add("a", work<'a', 0>, 1000, 0, 0, 500);
+    TEST_ASSERT_EQUAL_INT(-1, core.pick(0));
+    TEST_ASSERT_EQUAL_UINT32(500, core.untilNext(0));
+    TEST_ASSERT_EQUAL_INT(0, core.pick(500));
+    core.reset();
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, core.untilNext(0));
+}
+
+void test_overrun_and_skip()
+{
+    // 周期 1ms 的任务执行了 3.5ms: 记一次超时，跳过整落后的 2 个周期 (1ms、2ms)，不连续补跑;
+    // 3ms 的释放只晚了 0.5ms，照常执行
+    int id = core.add("slow", work<'s', 3500>, 1000, 0, 0, 0);
+    core.runOnce(virtualClock);
+    const Scheduler::TaskStats &s = core.task(id).stats;
+    TEST_ASSERT_EQUAL_UINT32(1, s.overruns);
+    TEST_ASSERT_EQUAL_UINT32(2, s.skipped);
+    TEST_ASSERT_EQUAL_UINT32(3500, s.maxRun);
+    TEST_ASSERT_EQUAL_UINT32(3000, core.task(id).releaseAt);
+}
+
+void test_slightly_late_release_not_skipped()
+{
+    // 执行时间比周期长 1us: 下一次释放只晚 1us，不能跳过
+    int id = core.add("tight", work<'t', 1001>, 1000, 0, 0, 0);
+    core.runOnce(virtualClock);
+    TEST_ASSERT_EQUAL_UINT32(0, core.task(id).stats.skipped);
+    TEST_ASSERT_EQUAL_UINT32(1000, core.task(id).releaseAt);
+    TEST_ASSERT_EQUAL_INT(id, core.pick(vnow));
+
+    // 落后刚好一个周期时才跳过
+    core.reset();
+    vnow = 0;
+    id = core.add("late", work<'l', 2000>, 1000, 0, 0, 0);
+    core.runOnce(virtualClock);
+    TEST_ASSERT_EQUAL_UINT32(1, core.task(id).stats.skipped);
+    TEST_ASSERT_EQUAL_UINT32(2000, core.task(id).releaseAt);
+}
+
+void test_jitter()
+{
+    int fast = core.add("fast", work<'f', 200>, 1000, 0, 1, 0);
+    core.add("long", work<'l', 700>, 5000, 500, 0, 0);
+    runUntil(20000);
+    // 长任务先执行 (截止时间 500us)，快任务最多被推迟 700us
+    TEST_ASSERT_EQUAL_UINT32(700, core.task(fast).stats.maxJitter);
+    TEST_ASSERT_EQUAL_UINT32(0, core.task(fast).stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(20, core.task(fast).stats.runs);
+}
+
+void test_clock_wraparound()
+{
+    vnow = 0xFFFFFFFFu - 2500;
+    int id = core.add("w", work<'w', 10>, 1000, 0, 0, vnow);
+    runUntil(vnow + 10000); // 跨过 32 位回绕
+    TEST_ASSERT_EQUAL_UINT32(10, core.task(id).stats.runs);
+    TEST_ASSERT_EQUAL_UINT32(0, core.task(id).stats.skipped);
+    TEST_ASSERT_EQUAL_UINT32(0, core.task(id).stats.maxJitter);
+}
+
+// 满任务表 (12 个任务，利用率约 60%) 虚拟运行 60s
+void test_full_table_benchmark()
+{
+    core.add("t0", work<'0', 300>, 5000, 0, 0, 0);
+    core.add("t1", work<'1', 200>, 7000, 0, 0, 0);
+    core.add("t2", work<'2', 400>, 10000, 0, 0, 0);
+    core.add("t3", work<'3', 500>, 20000, 0, 0, 0);
+    core.add("t4", work<'4', 1000>, 33000, 0, 0, 0);
+    core.add("t5", work<'5', 300>, 50000, 0, 0, 0);
+    core.add("t6", work<'6', 2000>, 100000, 0, 0, 0);
+    core.add("t7", work<'7', 1000>, 100000, 0, 0, 0);
+    core.add("t8", work<'8', 2000>, 250000, 0, 0, 0);
+    core.add("t9", work<'9', 3000>, 500000, 0, 0, 0);
+    core.add("ta", work<'a', 5000>, 1000000, 0, 0, 0);
+    core.add("tb", work<'b', 1000>, 2000000, 0, 0, 0);
+    TEST_ASSERT_EQUAL_INT(-1, core.add("full", work<'x', 0>, 1000, 0, 0, 0));
+
+    const uint32_t RUN_US = 60000000;
+    uint32_t dispatches = 0;
+    double ns = Bench::nsPerOp(1, [&] {
+        while (vnow < RUN_US)
+        {
+            if (core.runOnce(virtualClock) >= 0)
+                dispatches++;
+            else
+                vnow += core.untilNext(vnow);
+        }
+    });
+
+    uint32_t maxJitter = 0;
+    for (int i = 0; i < core.size(); i++)
+    {
+        const Scheduler::Task &t = core.task(i);
+        TEST_ASSERT_EQUAL_UINT32(0, t.stats.overruns);
+        TEST_ASSERT_EQUAL_UINT32(0, t.stats.skipped);
+        TEST_ASSERT_INT_WITHIN(1, RUN_US / t.period, t.stats.runs);
+        if (t.stats.maxJitter > maxJitter)
+            maxJitter = t.stats.maxJitter;
+    }
+    Bench::report("%lu 次调度，最大抖动 %luus，主机上每次调度 %.0fns",
+                  (unsigned long)dispatches, (unsigned long)maxJitter, ns / dispatches);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_earliest_deadline_first);
+    RUN_TEST(test_not_released_yet);
+    RUN_TEST(test_overrun_and_skip);
+    RUN_TEST(test_slightly_late_release_not_skipped);
+    RUN_TEST(test_jitter);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_full_table_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,88 @@
+// Scheduler::run() 在 Arduino 替身上运行 SmartHub 的任务组合:
+// 每个任务按板上实测量级消耗虚拟时间，检查调度结果并报告空转比例
+
+#include <Arduino.h>
+#include <unity.h>
+#include "Bench.h"
+#include "Scheduler/Scheduler.h"
+
+namespace Scheduler
+{
+    extern Core core;
+}
+
+const uint32_t RUN_US = 10000000; // 虚拟运行 10s
+const uint32_t LOOP_US = 20;      // 不睡眠时一次 loop() 的开销
+
+void sense() { Fake::advanceUs(2000); }
+void input() { Fake::advanceUs(300); }
+void frame() { Fake::advanceUs(8000); }
+void net() { Fake::advanceUs(100); }
+
+uint32_t loops = 0;
+uint64_t spinUs = 0;
+
+void setUp()
+{
+    Fake::reset();
+    Scheduler::core.reset();
+    loops = 0;
+    spinUs = 0;
+}
+
+void tearDown() {}
+
+void runFor(uint32_t us)
+{
+    while (Fake::nowUs < us)
+    {
+        uint32_t sleeps = Fake::sleeps;
+        Scheduler::run();
+        loops++;
+        if (Fake::sleeps == sleeps)
+        {
+            Fake::advanceUs(LOOP_US);
+            spinUs += LOOP_US;
+        }
+    }
+}
+
+void test_smarthub_task_set()
+{
+    Scheduler::add("sense", sense, 500, 20, 2);
+    Scheduler::add("input", input, 10, 10, 3);
+    Scheduler::add("frame", frame, 33, 33, 1);
+    Scheduler::add("net", net, 100, 0, 0);
+
+    double ns = Bench::nsPerOp(1, [] { runFor(RUN_US); });
+
+    const Scheduler::Task &in = Scheduler::core.task(1);
+    const Scheduler::Task &fr = Scheduler::core.task(2);
+    TEST_ASSERT_INT_WITHIN(1, 20, Scheduler::core.task(0).stats.runs);
+    TEST_ASSERT_INT_WITHIN(1, 1000, in.stats.runs);
+    TEST_ASSERT_INT_WITHIN(1, 304, fr.stats.runs);
+    TEST_ASSERT_INT_WITHIN(1, 100, Scheduler::core.task(3).stats.runs);
+
+    // 摇杆采样最多被一帧渲染推迟，仍在 10ms 截止时间内完成
+    TEST_ASSERT_EQUAL_UINT32(0, in.stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(0, fr.stats.overruns);
+    TEST_ASSERT_LESS_OR_EQUAL(8000 + 2000, in.stats.maxJitter);
+    for (int i = 0; i < Scheduler::core.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(0, Scheduler::core.task(i).stats.skipped);
+
+    // 大部分空闲时间在 vTaskDelay 中，而不是在 loop() 里空转
+    TEST_ASSERT_LESS_THAN(RUN_US / 10, spinUs);
+
+    StringPrint out;
+    Scheduler::dump(out);
+    TEST_ASSERT_TRUE(out.text.find("frame") != std::string::npos);
+    Bench::report("%lu 次 loop()，%lu 次睡眠，空转 %.1f%%，主机上每次 run() %.0fns",
+                  (unsigned long)loops, (unsigned long)Fake::sleeps, 100.0 * spinUs / RUN_US, ns / loops);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_smarthub_task_set);
+    return UNITY_END();
+}
@@ -0,0 +1,209 @@
+// Telemetry: 记录帧与文本帧的编解码、丢帧与重新同步，以及二进制与文本两种格式的字节数和耗时
+
+#include <Arduino.h>
+#include <unity.h>
+#include "Bench.h"
+#include "Profiler/Profiler.h"
+#include "Telemetry/Telemetry.h"
+
+using Telemetry::Decoder;
+
+// 把 out 中的全部字节喂给解码器
+void decodeAll(const std::string &bytes, Decoder &decoder, Telemetry::EnvRecord *last = nullptr)
+{
+    Telemetry::EnvRecord r;
+    for (char c : bytes)
+    {
+        if (decoder.feed((uint8_t)c, r) == Decoder::RECORD && last != nullptr)
+            *last = r;
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_record_round_trip()
+{
+    StringStream port;
+    Telemetry::Writer writer;
+    writer.begin(port);
+    TEST_ASSERT_TRUE(writer.send(-12.34f, 55.5f, 4095, 0, 123456789));
+    TEST_ASSERT_EQUAL_INT(Telemetry::FRAME_SIZE, (int)port.text.size());
+
+    Decoder decoder;
+    Telemetry::EnvRecord r = {};
+    decodeAll(port.text, decoder, &r);
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.frameCount());
+    TEST_ASSERT_EQUAL_INT(-123, r.temp10);
+    TEST_ASSERT_EQUAL_UINT16(555, r.hum10);
+    TEST_ASSERT_EQUAL_UINT16(4095, r.light);
+    TEST_ASSERT_EQUAL_UINT16(0, r.threshold);
+    TEST_ASSERT_EQUAL_UINT32(123456789, r.timestamp);
+}
+
+void test_text_frames_keep_the_stream_intact()
+{
+    StringStream port;
+    Telemetry::Writer writer;
+    writer.begin(port);
+    for (int i = 0; i < 100; i++)
+    {
+        writer.send(24.5f, 55, 1200, 2048, i * 100);
+        if (i % 10 == 0)
+            writer.printf("切换显示模式 %d", i);
+    }
+
+    Decoder decoder;
+    decodeAll(port.text, decoder);
+    TEST_ASSERT_EQUAL_UINT32(100, decoder.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(10, decoder.textCount());
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.errorCount());
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.lostCount());
+    TEST_ASSERT_EQUAL_STRING("切换显示模式 90", decoder.text());
+}
+
+void test_profiler_dump_as_text_frames()
+{
+    // SmartMonitor 的 'p' / 'e' 串口命令: 统计经 lines() 按行变成文本帧，记录流不被打断
+    StringStream port;
+    Telemetry::Writer writer;
+    writer.begin(port);
+    Profiler::setEnabled(false);
+    for (int i = 0; i < 10; i++)
+    {
+        writer.send(24.5f, 55, 1200, 2048, i * 100);
+        if (i == 5)
+        {
+            port.input = "pe";
+            Profiler::pollSerial(port, writer.lines());
+        }
+    }
+
+    Decoder decoder;
+    decodeAll(port.text, decoder);
+    TEST_ASSERT_EQUAL_UINT32(10, decoder.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(3, decoder.textCount()); // 标题、表头、开启提示
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.errorCount());
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.lostCount());
+    TEST_ASSERT_EQUAL_STRING("耗时测量已开启", decoder.text());
+    Profiler::setEnabled(false);
+}
+
+void test_raw_text_costs_a_record()
+{
+    // 直接 Serial.println 的文本没有分隔符，会和下一帧粘在一起被丢弃
+    StringStream port;
+    Telemetry::Writer writer;
+    writer.begin(port);
+    writer.send(24.5f, 55, 1200, 2048, 0);
+    port.print("切换显示模式\r\n");
+    writer.send(24.5f, 55, 1200, 2048, 100);
+    writer.send(24.5f, 55, 1200, 2048, 200);
+
+    Decoder decoder;
+    decodeAll(port.text, decoder);
+    TEST_ASSERT_EQUAL_UINT32(2, decoder.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.errorCount());
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.lostCount());
+}
+
+void test_long_text_truncated()
+{
+    char longText[200];
+    memset(longText, 'x', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = 0;
+    uint8_t frame[Telemetry::MAX_FRAME_SIZE];
+    int n = Telemetry::encodeText(longText, frame);
+    TEST_ASSERT_EQUAL_INT(Telemetry::MAX_FRAME_SIZE, n);
+
+    Decoder decoder;
+    Telemetry::EnvRecord r;
+    Decoder::Result result = Decoder::NONE;
+    for (int i = 0; i < n; i++)
+        result = decoder.feed(frame[i], r);
+    TEST_ASSERT_EQUAL_INT(Decoder::TEXT, result);
+    TEST_ASSERT_EQUAL_INT(Telemetry::MAX_TEXT, (int)strlen(decoder.text()));
+}
+
+void test_corrupt_frames_rejected()
+{
+    uint8_t frame[Telemetry::MAX_FRAME_SIZE];
+    Telemetry::EnvRecord in = {7, 1000, 245, 550, 1, 2}, out;
+    int n = Telemetry::encode(in, frame);
+    frame[5] ^= 0x40; // 翻转一位，CRC 不符
+    Decoder decoder;
+    for (int i = 0; i < n; i++)
+        decoder.feed(frame[i], out);
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.errorCount());
+
+    // 超长的垃圾数据不会越界，遇到分隔符后恢复
+    for (int i = 0; i < 500; i++)
+        decoder.feed('a', out);
+    decoder.feed(0, out);
+    TEST_ASSERT_EQUAL_UINT32(2, decoder.errorCount());
+    n = Telemetry::encode(in, frame);
+    for (int i = 0; i < n; i++)
+        decoder.feed(frame[i], out);
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.frameCount());
+}
+
+void test_full_buffer_drops_without_blocking()
+{
+    StringStream port;
+    Telemetry::Writer writer;
+    writer.begin(port);
+    port.space = 128;
+    TEST_ASSERT_TRUE(writer.send(24.5f, 55, 1200, 2048, 0));
+    port.space = Telemetry::FRAME_SIZE - 1;
+    TEST_ASSERT_FALSE(writer.send(24.5f, 55, 1200, 2048, 100));
+    port.space = 128;
+    TEST_ASSERT_TRUE(writer.send(24.5f, 55, 1200, 2048, 200));
+    TEST_ASSERT_EQUAL_UINT32(1, writer.getStats().dropped);
+
+    Decoder decoder;
+    decodeAll(port.text, decoder);
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.lostCount()); // 丢弃的帧占用了序号
+}
+
+// 同样的 10000 条记录分别按两种格式写出
+void test_binary_vs_text_benchmark()
+{
+    const uint32_t RECORDS = 10000;
+    uint32_t bytes[2];
+    double ns[2];
+    for (int f = 0; f < 2; f++)
+    {
+        StringStream port;
+        port.text.reserve(RECORDS * 40);
+        Telemetry::Writer writer;
+        writer.begin(port, f == 0 ? Telemetry::BINARY : Telemetry::TEXT);
+        ns[f] = Bench::nsPerOp(RECORDS, [&] {
+            for (uint32_t i = 0; i < RECORDS; i++)
+                writer.send(20 + (i % 100) * 0.1f, 40 + (i % 37), 1000 + i % 3000, 2048, i * 100);
+        });
+        TEST_ASSERT_EQUAL_UINT32(RECORDS, writer.getStats().sent);
+        TEST_ASSERT_EQUAL_UINT32(port.text.size(), writer.getStats().bytes);
+        bytes[f] = writer.getStats().bytes;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(RECORDS * Telemetry::FRAME_SIZE, bytes[0]);
+    TEST_ASSERT_GREATER_THAN(bytes[0], bytes[1]);
+    Bench::report("二进制: %.1f 字节/条 %.0fns/条; printf 文本: %.1f 字节/条 %.0fns/条",
+                  (double)bytes[0] / RECORDS, ns[0], (double)bytes[1] / RECORDS, ns[1]);
+    Bench::report("115200 波特率下最高记录率: 二进制 %lu 条/秒，文本 %lu 条/秒",
+                  (unsigned long)(11520 * RECORDS / bytes[0]), (unsigned long)(11520 * RECORDS / bytes[1]));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_record_round_trip);
+    RUN_TEST(test_text_frames_keep_the_stream_intact);
+    RUN_TEST(test_profiler_dump_as_text_frames);
+    RUN_TEST(test_raw_text_costs_a_record);
+    RUN_TEST(test_long_text_truncated);
+    RUN_TEST(test_corrupt_frames_rejected);
+    RUN_TEST(test_full_buffer_drops_without_blocking);
+    RUN_TEST(test_binary_vs_text_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,253 @@
+// TftField::Field: 用带 U8g2 截断规则的假字体检查部分重画的位置和字形缓存路径的残留像素，
+// 并按 1Hz 重放 SmartHubTft 环境页 10 分钟，统计写入 TFT 的像素数
+
+#include <unity.h>
+#include <string>
+#include "Bench.h"
+#include "GlyphCache/GlyphCache.h"
+#include "TftField/TftField.h"
+
+const int X = 10;
+const int HEIGHT = 20; // wqy16 上升 + 下降
+
+// 一个字形的度量: 前进宽度、位图宽度和 x 偏移 (与 U8g2 字体数据相同的含义)
+struct Metrics
+{
+    int dx, w, xOff;
+};
+
+Metrics metrics(uint32_t c)
+{
+    if (c >= 0x4E00)
+        return {16, 15, 0}; // 汉字
+    switch (c)
+    {
+    case ' ':
+        return {4, 0, 0};
+    case '.':
+    case ':':
+        return {4, 2, 1};
+    case '-':
+        return {6, 5, 0};
+    case 0xB0: // °
+        return {6, 4, 1};
+    default:
+        return {8, 7, 0};
+    }
+}
+
+// 前进宽度之和: 逐字形绘制时光标的移动量
+int advance(const char *s)
+{
+    int w = 0;
+    while (*s != 0)
+        w += metrics(GlyphCache::nextCodepoint(&s)).dx;
+    return w;
+}
+
+// 与 U8g2 getUTF8Width() 相同: 最后一个字形按位图宽度 + x 偏移截断
+int trimmed(const char *s)
+{
+    int w = 0;
+    Metrics last = {0, 0, 0};
+    while (*s != 0)
+    {
+        last = metrics(GlyphCache::nextCodepoint(&s));
+        w += last.dx;
+    }
+    if (last.w != 0)
+        w += last.w + last.xOff - last.dx;
+    return w;
+}
+
+// TftField::measure 的做法: 补一个参考字符后相减
+int probe(void *, const char *s)
+{
+    std::string t = std::string(s) + "0";
+    return trimmed(t.c_str()) - trimmed("0");
+}
+
+int measureTrimmed(void *, const char *s) { return trimmed(s); }
+
+// GlyphCache::Cache::width(): 缓存的字形宽度之和
+int measureCached(void *, const char *s) { return advance(s); }
+
+// 一行像素: 0 为背景，其余为 (码位, 列) 的编号
+const int ROW = 240;
+
+// 与 GlyphCache::Cache::drawString 相同: 每个字形按前进宽度画一个不透明单元格
+int drawString(int *row, int x, const char *s)
+{
+    int cx = x;
+    while (*s != 0)
+    {
+        uint32_t c = GlyphCache::nextCodepoint(&s);
+        Metrics m = metrics(c);
+        for (int col = 0; col < m.dx; col++)
+            row[cx + col] = col >= m.xOff && col < m.xOff + m.w ? (int)c * 32 + col + 1 : 0;
+        cx += m.dx;
+    }
+    return cx - x;
+}
+
+// 与 Painter::draw 的字形缓存路径相同: 画剩余文本，再清除新文本没有覆盖到的尾部
+void paintCached(int *row, TftField::Field &field, const char *text, TftField::MeasureFn measure)
+{
+    TftField::Plan p = field.plan(text, 0xFFFF, measure, nullptr);
+    if (!p.dirty)
+        return;
+    int drawn = drawString(row, p.drawX, text + p.prefixBytes);
+    for (int i = p.drawX + drawn; i < p.clearX + p.clearW; i++)
+        row[i] = 0;
+}
+
+// 依次更新字段，返回第一次与整行重画结果不同的更新序号，全部一致返回 -1
+int firstMismatch(TftField::MeasureFn measure)
+{
+    const char *texts[] = {"距离: 5 cm", "距离: 12 cm", "距离: 123 cm", "距离: 99 cm", "距离: 100 cm",
+                           "温度: 23.4 °C", "温度: 23.5 °C", "温度: 9.5 °C", "温度: -1.0 °C", "温度: 23.5 °C"};
+    int row[ROW] = {0};
+    TftField::Field field(X, 70);
+    for (int i = 0; i < (int)(sizeof(texts) / sizeof(texts[0])); i++)
+    {
+        paintCached(row, field, texts[i], measure);
+        int expected[ROW] = {0};
+        drawString(expected, X, texts[i]);
+        if (memcmp(row, expected, sizeof(row)) != 0)
+            return i;
+    }
+    return -1;
+}
+
+// 部分重画后剩余文本第一个字形的位置应与整行重画时相同
+int fullRedrawPen(const char *text, int prefixBytes)
+{
+    std::string head(text, prefixBytes);
+    return X + advance(head.c_str());
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_probe_equals_advance_sum()
+{
+    const char *samples[] = {"", "0", "温度: 23.", "温度: 23.4 °C", "湿度: 55.0 %", "光照: 1234", "--- 环境监测 ---"};
+    for (const char *s : samples)
+        TEST_ASSERT_EQUAL_INT(advance(s), probe(nullptr, s));
+}
+
+void test_partial_redraw_lands_on_full_redraw_position()
+{
+    TftField::Field field(X, 70);
+    field.plan("温度: 23.4 °C", 0xFFFF, probe, nullptr);
+    TftField::Plan p = field.plan("温度: 23.5 °C", 0xFFFF, probe, nullptr);
+    TEST_ASSERT_TRUE(p.dirty);
+    TEST_ASSERT_EQUAL_INT(strlen("温度: 23."), p.prefixBytes);
+    TEST_ASSERT_EQUAL_INT(fullRedrawPen("温度: 23.5 °C", p.prefixBytes), p.drawX);
+    TEST_ASSERT_EQUAL_INT(advance("5 °C"), p.clearW);
+
+    // 截断宽度把 "." 算成 3 像素，剩余文本会左移 1 像素
+    TftField::Field old(X, 70);
+    old.plan("温度: 23.4 °C", 0xFFFF, measureTrimmed, nullptr);
+    p = old.plan("温度: 23.5 °C", 0xFFFF, measureTrimmed, nullptr);
+    TEST_ASSERT_EQUAL_INT(fullRedrawPen("温度: 23.5 °C", p.prefixBytes) - 1, p.drawX);
+}
+
+void test_shorter_text_clears_old_tail()
+{
+    TftField::Field field(X, 110);
+    field.plan("光照: 1234", 0xFFFF, probe, nullptr);
+    TftField::Plan p = field.plan("光照: 987", 0xFFFF, probe, nullptr);
+    TEST_ASSERT_EQUAL_INT(strlen("光照: "), p.prefixBytes);
+    TEST_ASSERT_EQUAL_INT(X + advance("光照: "), p.clearX);
+    TEST_ASSERT_EQUAL_INT(advance("1234"), p.clearW);
+}
+
+void test_unchanged_and_recolored()
+{
+    TftField::Field field(X, 150);
+    field.plan("状态: 正常", 0x07E0, probe, nullptr);
+    TEST_ASSERT_FALSE(field.plan("状态: 正常", 0x07E0, probe, nullptr).dirty);
+
+    // 颜色变了整行重画
+    TftField::Plan p = field.plan("状态: 警告!", 0xF800, probe, nullptr);
+    TEST_ASSERT_EQUAL_INT(0, p.prefixBytes);
+    TEST_ASSERT_EQUAL_INT(X, p.drawX);
+
+    field.invalidate();
+    p = field.plan("状态: 警告!", 0xF800, probe, nullptr);
+    TEST_ASSERT_TRUE(p.dirty);
+    TEST_ASSERT_EQUAL_INT(0, p.prefixBytes);
+}
+
+void test_glyph_cache_path_matches_full_redraw()
+{
+    // 前缀与清除区间和字形缓存使用同一种宽度 (前进宽度之和): 每次都与整行重画逐像素相同
+    TEST_ASSERT_EQUAL_INT(-1, firstMismatch(measureCached));
+    // 混用截断宽度时后缀左移，旧像素残留在后面
+    TEST_ASSERT_NOT_EQUAL(-1, firstMismatch(measureTrimmed));
+}
+
+// 与 SmartHubTft 环境页相同的三个字段，读数按实际的采集频率变化
+void test_pixel_count_benchmark()
+{
+    TftField::Field fields[3] = {{X, 70}, {X, 110}, {X, 150}};
+    int lastFull[3] = {0, 0, 0};
+    uint32_t pixels = 0, fullPixels = 0, updates = 0, skipped = 0;
+    float temp = 23.4f, hum = 55;
+    int light = 900;
+    uint32_t seed = 1;
+
+    double ns = Bench::nsPerOp(600 * 3, [&] {
+        for (int sec = 0; sec < 600; sec++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            if (sec % 2 == 0) // DHT11 每 2s
+            {
+                temp += ((int)((seed >> 8) % 3) - 1) * 0.1f;
+                hum += (int)((seed >> 12) % 3) - 1;
+            }
+            light += (int)((seed >> 16) % 41) - 20;
+
+            char line1[TftField::MAX_TEXT], line2[TftField::MAX_TEXT], line3[TftField::MAX_TEXT];
+            snprintf(line1, sizeof(line1), "温度: %.1f °C", temp);
+            snprintf(line2, sizeof(line2), "湿度: %.1f %%", hum);
+            snprintf(line3, sizeof(line3), "光照: %d", light);
+            const char *text[3] = {line1, line2, line3};
+
+            for (int i = 0; i < 3; i++)
+            {
+                updates++;
+                TftField::Plan p = fields[i].plan(text[i], 0xFFFF, probe, nullptr);
+                int w = advance(text[i]);
+                if (!p.dirty)
+                {
+                    skipped++;
+                    continue;
+                }
+                // 增量: 清除变化区间 + 重画剩余文本; 整行: 清除旧行 + 重画整行
+                pixels += (p.clearW + advance(text[i] + p.prefixBytes)) * HEIGHT;
+                fullPixels += ((w > lastFull[i] ? w : lastFull[i]) + w) * HEIGHT;
+                lastFull[i] = w;
+            }
+        }
+    });
+
+    Bench::report("%lu 次更新，跳过 %lu，写入 %lu / %lu 像素 (%.1f%%)，主机上每次 %.0fns",
+                  (unsigned long)updates, (unsigned long)skipped, (unsigned long)pixels,
+                  (unsigned long)fullPixels, 100.0 * pixels / fullPixels, ns);
+    TEST_ASSERT_GREATER_THAN(0, skipped);
+    TEST_ASSERT_LESS_THAN(fullPixels / 3, pixels);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_probe_equals_advance_sum);
+    RUN_TEST(test_partial_redraw_lands_on_full_redraw_position);
+    RUN_TEST(test_shorter_text_clears_old_tail);
+    RUN_TEST(test_unchanged_and_recolored);
+    RUN_TEST(test_glyph_cache_path_matches_full_redraw);
+    RUN_TEST(test_pixel_count_benchmark);
+    return UNITY_END();
+}
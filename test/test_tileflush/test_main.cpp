@@ -0,0 +1,168 @@
+// TileFlush: 在 U8G2 替身上按 30fps 重放 SmartHub 的四个菜单页面 10s，
+// 对比只发送脏 tile 与每帧 sendBuffer() 的总线字节数
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <unity.h>
+#include "Bench.h"
+#include "TileFlush/TileFlush.h"
+
+const uint32_t FRAME_MS = 33;
+const uint32_t REPLAY_MS = 10000;
+
+U8G2 u8g2;
+
+// 与 SmartHub 的页面布局相同，数值随时间按实际的采集频率变化
+struct Inputs
+{
+    float temp, hum;
+    int dist, light;
+    uint32_t uptime;
+};
+
+uint32_t seed = 1;
+
+int noise(int range)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int)((seed >> 8) % (2 * range + 1)) - range;
+}
+
+void update(Inputs &in, uint32_t nowMs)
+{
+    if (nowMs % 2000 < FRAME_MS) // DHT11 每 2s
+    {
+        in.temp += noise(1) * 0.1f;
+        in.hum += noise(1);
+    }
+    if (nowMs % 50 < FRAME_MS) // 超声波 20Hz
+        in.dist = constrain(in.dist + noise(2), 2, 100);
+    if (nowMs % 500 < FRAME_MS) // 光敏 2Hz
+        in.light += noise(20);
+    in.uptime = nowMs / 1000;
+}
+
+void drawHeader(const char *title)
+{
+    u8g2.setCursor(0, 12);
+    u8g2.print(title);
+    u8g2.drawLine(0, 15, 128, 15);
+}
+
+void drawScreen(int menu, const Inputs &in)
+{
+    u8g2.clearBuffer();
+    switch (menu)
+    {
+    case 0:
+        drawHeader("1. 环境监测");
+        u8g2.setCursor(0, 35);
+        u8g2.printf("温度: %.1f C", in.temp);
+        u8g2.setCursor(0, 55);
+        u8g2.printf("湿度: %.1f %%", in.hum);
+        u8g2.drawCircle(105, 45, 18, U8G2_DRAW_ALL);
+        u8g2.setCursor(92, 48);
+        u8g2.print("12:34");
+        break;
+    case 1:
+    {
+        drawHeader("2. 距离雷达");
+        u8g2.setCursor(0, 30);
+        u8g2.printf("当前距离: %d cm", in.dist);
+        u8g2.setCursor(0, 42);
+        u8g2.printf("报警阈值: %d cm", 20);
+        u8g2.drawFrame(0, 48, 128, 10);
+        u8g2.drawBox(2, 50, map(in.dist, 2, 100, 124, 0), 6);
+        int thresholdPos = map(20, 2, 100, 124, 0);
+        u8g2.drawLine(2 + thresholdPos, 46, 2 + thresholdPos, 60);
+        break;
+    }
+    case 2:
+        drawHeader("3. 光感与灯光");
+        u8g2.setCursor(0, 35);
+        u8g2.printf("光照强度: %d", in.light);
+        u8g2.setCursor(0, 55);
+        u8g2.print(in.light < 1000 ? "状态: 黑暗 (开启夜灯)" : "状态: 明亮");
+        break;
+    default:
+        drawHeader("4. 系统信息");
+        u8g2.setCursor(0, 35);
+        u8g2.print("ESP32 核心: 240MHz");
+        u8g2.setCursor(0, 55);
+        u8g2.printf("运行时间: %lu s", (unsigned long)in.uptime);
+        break;
+    }
+    // 已连接的 Wi-Fi 图标
+    for (int i = 0; i < 3; i++)
+        u8g2.drawBox(117 + i * 3, 9 - i * 3, 2, 2 + i * 3);
+}
+
+TileFlush::Stats replay(int menu)
+{
+    TileFlush::Flusher flusher;
+    Inputs in = {24.5f, 55, 40, 900, 0};
+    seed = 1;
+    for (uint32_t now = 0; now < REPLAY_MS; now += FRAME_MS)
+    {
+        update(in, now);
+        drawScreen(menu, in);
+        flusher.flush(u8g2);
+    }
+    return flusher.getStats();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_identical_frames_are_skipped()
+{
+    TileFlush::Flusher flusher;
+    Inputs in = {24.5f, 55, 40, 900, 0};
+    drawScreen(3, in);
+    flusher.flush(u8g2);
+    flusher.flush(u8g2);
+    TEST_ASSERT_EQUAL_UINT32(2, flusher.getStats().frames);
+    TEST_ASSERT_EQUAL_UINT32(1, flusher.getStats().skipped);
+    TEST_ASSERT_EQUAL_UINT32(U8G2::TILE_COLS * U8G2::TILE_ROWS, flusher.getStats().tilesSent);
+}
+
+void test_only_changed_tiles_are_sent()
+{
+    TileFlush::Flusher flusher;
+    u8g2.clearBuffer();
+    flusher.flush(u8g2);
+    u8g2.drawPixel(9, 20); // tile (1, 2)
+    u8g2.drawPixel(17, 20); // tile (2, 2)，与上一个相邻，合并为一段
+    u8g2.drawPixel(127, 63);
+    uint32_t areas = u8g2.areas;
+    flusher.flush(u8g2);
+    TEST_ASSERT_EQUAL_UINT32(areas + 2, u8g2.areas);
+    TEST_ASSERT_EQUAL_UINT32(U8G2::TILE_COLS * U8G2::TILE_ROWS + 3, flusher.getStats().tilesSent);
+}
+
+void test_replay_menu_screens()
+{
+    const char *names[] = {"环境监测", "距离雷达", "光感与灯光", "系统信息"};
+    for (int menu = 0; menu < 4; menu++)
+    {
+        TileFlush::Stats s;
+        double ns = Bench::nsPerOp(REPLAY_MS / FRAME_MS, [&] { s = replay(menu); });
+        Bench::report("%s: %lu 帧，跳过 %lu，发送 %lu / %lu 字节 (%.1f%%)，主机上每帧 %.0fns",
+                      names[menu], (unsigned long)s.frames, (unsigned long)s.skipped,
+                      (unsigned long)s.bytesSent, (unsigned long)s.bytesFullSend,
+                      100.0 * s.bytesSent / s.bytesFullSend, ns);
+
+        // 每帧只有数字和距离条附近的几个 tile 会变，总流量不到整屏发送的 5%
+        TEST_ASSERT_GREATER_THAN(0, s.skipped);
+        TEST_ASSERT_LESS_THAN(s.bytesFullSend / 20, s.bytesSent);
+    }
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_identical_frames_are_skipped);
+    RUN_TEST(test_only_changed_tiles_are_sent);
+    RUN_TEST(test_replay_menu_screens);
+    return UNITY_END();
+}
@@ -0,0 +1,265 @@
+// TimerWheel::Wheel: 检查定时器在各层 (含级联边界和最长延时) 准时到期、周期定时器、取消与句柄代数、
+// 回调中启动和取消定时器、分发函数收到的 flags，以及 10000 个定时器时启动、取消和每个 tick 的开销
+
+#include <unity.h>
+#include "Bench.h"
+#include "TimerWheel/TimerWheel.h"
+
+using TimerWheel::Handle;
+using TimerWheel::MAX_DELAY;
+
+const int TIMERS = 10000;
+typedef TimerWheel::Wheel<TIMERS> Wheel;
+
+Wheel *wheel;
+
+struct Probe
+{
+    uint32_t due;     // 预期的到期时刻
+    uint32_t firedAt; // 最后一次触发的时刻
+    uint32_t count;
+    uint32_t late;    // 触发时刻与预期不符的次数
+    uint32_t period;
+};
+
+void record(void *arg)
+{
+    Probe *p = (Probe *)arg;
+    if (wheel->now() != p->due)
+        p->late++;
+    p->firedAt = wheel->now();
+    p->count++;
+    p->due += p->period;
+}
+
+void setUp() { wheel = new Wheel(); } // 约 400KB，不放在栈上
+void tearDown() { delete wheel; }
+
+void test_expires_on_exact_tick_at_every_level()
+{
+    // 各层边界前后的延时: 64、4096、262144 个 tick 处需要级联
+    const uint32_t delays[] = {0, 1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 5000,
+                               262143, 262144, 262145, 1000000, MAX_DELAY - 1, MAX_DELAY, MAX_DELAY + 100};
+    const int COUNT = sizeof(delays) / sizeof(delays[0]);
+    static Probe probes[COUNT];
+
+    // 从非零时刻开始，槽号不与延时对齐
+    wheel->advance(12345);
+    uint32_t t0 = wheel->now();
+    for (int i = 0; i < COUNT; i++)
+    {
+        uint32_t d = delays[i] == 0 ? 1 : delays[i] > MAX_DELAY ? MAX_DELAY : delays[i];
+        probes[i] = {t0 + d, 0, 0, 0, 0};
+        TEST_ASSERT_NOT_EQUAL(0, wheel->start(delays[i], record, &probes[i]));
+    }
+    uint32_t fired = wheel->advance(MAX_DELAY + 10);
+    TEST_ASSERT_EQUAL_UINT32(COUNT, fired);
+    for (int i = 0; i < COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(1, probes[i].count);
+        TEST_ASSERT_EQUAL_UINT32(0, probes[i].late);
+    }
+    TEST_ASSERT_EQUAL_INT(0, wheel->activeCount());
+}
+
+void test_random_delays_fire_on_time()
+{
+    // 随机延时和启动时刻: 每个定时器都必须恰好在 start 时刻 + 延时到期
+    static Probe probes[TIMERS];
+    uint32_t seed = 7;
+    for (int i = 0; i < TIMERS; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        if (i % 100 == 0)
+            wheel->advance((seed >> 8) % 50);
+        uint32_t d = (seed >> 4) % 300000 + 1;
+        probes[i] = {wheel->now() + d, 0, 0, 0, 0};
+        wheel->start(d, record, &probes[i]);
+    }
+    wheel->advance(300000 + 5000);
+    uint32_t late = 0;
+    for (int i = 0; i < TIMERS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(1, probes[i].count);
+        late += probes[i].late;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, late);
+}
+
+void test_periodic()
+{
+    Probe p = {wheel->now() + 7, 0, 0, 0, 7};
+    Probe slow = {wheel->now() + 100, 0, 0, 0, 5000}; // 第一次延时与周期不同，周期跨层
+    Handle h = wheel->start(7, record, &p, 7);
+    wheel->start(100, record, &slow, 5000);
+    wheel->advance(700);
+    TEST_ASSERT_EQUAL_UINT32(100, p.count);
+    TEST_ASSERT_EQUAL_UINT32(0, p.late);
+    TEST_ASSERT_TRUE(wheel->isActive(h));
+
+    wheel->advance(100000 - 700);
+    TEST_ASSERT_EQUAL_UINT32(20, slow.count); // 100, 5100, ..., 95100
+    TEST_ASSERT_EQUAL_UINT32(0, slow.late);
+    TEST_ASSERT_TRUE(wheel->cancel(h));
+    uint32_t count = p.count;
+    wheel->advance(100);
+    TEST_ASSERT_EQUAL_UINT32(count, p.count);
+}
+
+void test_cancel_and_stale_handles()
+{
+    Probe a = {}, b = {};
+    Handle h = wheel->start(10, record, &a);
+    TEST_ASSERT_TRUE(wheel->isActive(h));
+    TEST_ASSERT_TRUE(wheel->cancel(h));
+    TEST_ASSERT_FALSE(wheel->cancel(h));
+    TEST_ASSERT_FALSE(wheel->isActive(h));
+
+    // 编号被重新使用后，旧句柄的代数不同，不会取消新的定时器
+    b.due = wheel->now() + 20;
+    Handle h2 = wheel->start(20, record, &b);
+    TEST_ASSERT_EQUAL_UINT32(h & 0xFFFF, h2 & 0xFFFF);
+    TEST_ASSERT_NOT_EQUAL(h, h2);
+    TEST_ASSERT_FALSE(wheel->cancel(h));
+    wheel->advance(20);
+    TEST_ASSERT_EQUAL_UINT32(0, a.count);
+    TEST_ASSERT_EQUAL_UINT32(1, b.count);
+    TEST_ASSERT_FALSE(wheel->isActive(h2)); // 单次定时器到期后失效
+    TEST_ASSERT_FALSE(wheel->cancel(h2));
+
+    TEST_ASSERT_FALSE(wheel->cancel(0));
+    TEST_ASSERT_FALSE(wheel->cancel(0xFFFF)); // 编号超出范围
+    TEST_ASSERT_EQUAL_UINT32(0, wheel->start(1, nullptr, nullptr));
+}
+
+void test_capacity()
+{
+    static Probe p;
+    for (int i = 0; i < TIMERS; i++)
+        TEST_ASSERT_NOT_EQUAL(0, wheel->start(1000, record, &p));
+    TEST_ASSERT_EQUAL_UINT32(0, wheel->start(1000, record, &p));
+    wheel->advance(1000);
+    TEST_ASSERT_EQUAL_UINT32(TIMERS, p.count);
+    TEST_ASSERT_NOT_EQUAL(0, wheel->start(1000, record, &p)); // 到期后归还
+}
+
+// 回调中的操作: 周期定时器第 3 次触发时取消自己并启动一个单次定时器，同时取消另一个定时器
+struct Chain
+{
+    Handle self, victim;
+    uint32_t count;
+    Probe next;
+};
+
+void chainCallback(void *arg)
+{
+    Chain *c = (Chain *)arg;
+    TEST_ASSERT_TRUE(wheel->isActive(c->self)); // 周期定时器触发时仍然有效
+    if (++c->count == 3)
+    {
+        TEST_ASSERT_TRUE(wheel->cancel(c->self));
+        TEST_ASSERT_TRUE(wheel->cancel(c->victim));
+        c->next.due = wheel->now() + 1;
+        wheel->start(1, record, &c->next);
+    }
+}
+
+void oneShotCallback(void *arg)
+{
+    // 单次定时器先释放再回调
+    TEST_ASSERT_FALSE(wheel->isActive(*(Handle *)arg));
+}
+
+void test_start_and_cancel_from_callback()
+{
+    static Chain c = {};
+    static Probe victim = {};
+    c.self = wheel->start(5, chainCallback, &c, 5);
+    c.victim = wheel->start(100, record, &victim);
+    static Handle h;
+    h = wheel->start(3, oneShotCallback, &h);
+
+    wheel->advance(200);
+    TEST_ASSERT_EQUAL_UINT32(3, c.count);
+    TEST_ASSERT_EQUAL_UINT32(1, c.next.count);
+    TEST_ASSERT_EQUAL_UINT32(0, c.next.late);
+    TEST_ASSERT_EQUAL_UINT32(16, c.next.firedAt);
+    TEST_ASSERT_EQUAL_UINT32(0, victim.count);
+    TEST_ASSERT_EQUAL_INT(0, wheel->activeCount());
+}
+
+uint32_t dispatched[4];
+
+void countDispatch(TimerWheel::Callback cb, void *arg, uint8_t flags)
+{
+    dispatched[flags & 3]++;
+    if (flags & 1)
+        cb(arg); // 与板上一样: 标记为中断上下文的直接执行，其余只记下
+}
+
+void test_dispatcher_receives_flags()
+{
+    Probe isr = {wheel->now() + 10, 0, 0, 0, 10}, task = {};
+    wheel->setDispatcher(countDispatch);
+    wheel->start(10, record, &isr, 10, 1);
+    wheel->start(15, record, &task, 15, 2);
+    wheel->advance(30);
+    TEST_ASSERT_EQUAL_UINT32(3, dispatched[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, dispatched[2]);
+    TEST_ASSERT_EQUAL_UINT32(0, dispatched[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, isr.count);
+    TEST_ASSERT_EQUAL_UINT32(0, task.count);
+}
+
+void benchCallback(void *arg) { (*(uint32_t *)arg)++; }
+
+void test_benchmark_10000_timers()
+{
+    // 与板上 benchmark() 相同的负载 (延时 1 - 60000 tick，一半为周期定时器)，定时器数量增加到 10000
+    const uint32_t TICKS = 60000;
+    static Handle handles[TIMERS];
+    static uint32_t delays[TIMERS];
+    uint32_t calls = 0, seed = 1;
+    for (int i = 0; i < TIMERS; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        delays[i] = (seed >> 8) % 60000 + 1;
+    }
+
+    double startNs = Bench::nsPerOp(TIMERS, [&] {
+        for (int i = 0; i < TIMERS; i++)
+            handles[i] = wheel->start(delays[i], benchCallback, &calls, i % 2 ? delays[i] : 0);
+    });
+    uint32_t fired = 0;
+    double tickNs = Bench::nsPerOp(TICKS, [&] { fired = wheel->advance(TICKS); });
+    uint32_t cancelled = 0;
+    double cancelNs = Bench::nsPerOp(TIMERS, [&] {
+        for (int i = 0; i < TIMERS; i++)
+            cancelled += wheel->cancel(handles[i]);
+    });
+
+    // 单次定时器各触发一次; 周期定时器在 d, 2d, ... <= TICKS 时触发，之后仍然有效
+    uint32_t expected = 0;
+    for (int i = 0; i < TIMERS; i++)
+        expected += i % 2 ? TICKS / delays[i] : 1;
+    Bench::report("%d 个定时器，主机上平均: 启动 %.1fns, 取消 %.1fns, 每 tick %.1fns (%lu 次触发)",
+                  TIMERS, startNs, cancelNs, tickNs, (unsigned long)fired);
+    TEST_ASSERT_EQUAL_UINT32(expected, fired);
+    TEST_ASSERT_EQUAL_UINT32(expected, calls);
+    TEST_ASSERT_EQUAL_UINT32(TIMERS / 2, cancelled);
+    TEST_ASSERT_EQUAL_INT(0, wheel->activeCount());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_expires_on_exact_tick_at_every_level);
+    RUN_TEST(test_random_delays_fire_on_time);
+    RUN_TEST(test_periodic);
+    RUN_TEST(test_cancel_and_stale_handles);
+    RUN_TEST(test_capacity);
+    RUN_TEST(test_start_and_cancel_from_callback);
+    RUN_TEST(test_dispatcher_receives_flags);
+    RUN_TEST(test_benchmark_10000_timers);
+    return UNITY_END();
+}
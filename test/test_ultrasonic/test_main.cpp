@@ -0,0 +1,129 @@
+// Ultrasonic::Ranger: 模拟 HC-SR04 的触发 / 回波边沿时间戳
+
+#include <unity.h>
+#include "Ultrasonic/Ultrasonic.h"
+
+const uint32_t TIMEOUT_US = 30000;
+const uint32_t ECHO_DELAY_US = 450; // 触发后模块发出 8 个 40kHz 脉冲再拉高 Echo
+
+Ultrasonic::Ranger ranger;
+
+void setUp()
+{
+    ranger.begin(5, TIMEOUT_US);
+}
+
+void tearDown() {}
+
+// 回波高电平宽度: 距离 * 2 / 声速 (0.034 cm/us)，取整到 us
+uint32_t echoUs(int cm)
+{
+    return (uint32_t)(cm * 1000 + 16) / 17;
+}
+
+// 在 t 触发一次测量，回波对应 cm 厘米; 返回下一次测量的开始时间
+uint32_t measure(uint32_t t, int cm)
+{
+    ranger.trigger(t);
+    ranger.onEdge(true, t + ECHO_DELAY_US);
+    ranger.onEdge(false, t + ECHO_DELAY_US + echoUs(cm));
+    ranger.poll(t + 50000);
+    return t + 50000;
+}
+
+void test_single_echo()
+{
+    uint32_t before = ranger.sequence();
+    measure(1000, 100);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, ranger.sequence());
+    TEST_ASSERT_EQUAL_INT(100, ranger.raw());
+    TEST_ASSERT_EQUAL_INT(100, ranger.distance());
+    TEST_ASSERT_EQUAL_INT(Ultrasonic::Ranger::IDLE, ranger.getState());
+}
+
+void test_distances_2_to_400cm()
+{
+    uint32_t t = 0;
+    for (int cm = 2; cm <= 400; cm++)
+    {
+        t = measure(t, cm);
+        TEST_ASSERT_EQUAL_INT(cm, ranger.raw());
+    }
+}
+
+void test_median_rejects_spikes()
+{
+    const int cms[] = {80, 81, 300, 80, 0, 82, 81};
+    uint32_t t = 0;
+    for (int cm : cms)
+        t = measure(t, cm);
+    // 窗口为最后 5 个结果 {300, 80, 0, 82, 81}
+    TEST_ASSERT_EQUAL_INT(81, ranger.raw());
+    TEST_ASSERT_EQUAL_INT(81, ranger.distance());
+}
+
+void test_timeout_without_fall()
+{
+    measure(0, 50);
+    ranger.trigger(100000);
+    ranger.onEdge(true, 100000 + ECHO_DELAY_US);
+    ranger.poll(100000 + TIMEOUT_US);
+    TEST_ASSERT_EQUAL_INT(Ultrasonic::Ranger::WAIT_FALL, ranger.getState());
+    uint32_t seq = ranger.sequence();
+    ranger.poll(100000 + TIMEOUT_US + 1);
+    TEST_ASSERT_EQUAL_UINT32(seq + 1, ranger.sequence());
+    TEST_ASSERT_EQUAL_INT(0, ranger.raw());
+    TEST_ASSERT_EQUAL_INT(Ultrasonic::Ranger::IDLE, ranger.getState());
+    // 迟到的下降沿不会再产生结果
+    ranger.onEdge(false, 100000 + TIMEOUT_US + 100);
+    TEST_ASSERT_EQUAL_UINT32(seq + 1, ranger.sequence());
+}
+
+void test_retrigger_counts_as_out_of_range()
+{
+    ranger.trigger(0);
+    uint32_t seq = ranger.sequence();
+    ranger.trigger(20000);
+    TEST_ASSERT_EQUAL_UINT32(seq + 1, ranger.sequence());
+    TEST_ASSERT_EQUAL_INT(0, ranger.raw());
+    TEST_ASSERT_EQUAL_INT(Ultrasonic::Ranger::WAIT_RISE, ranger.getState());
+}
+
+void test_ignores_stray_edges()
+{
+    // 空闲时和等待上升沿时的下降沿都被忽略
+    ranger.onEdge(true, 10);
+    ranger.onEdge(false, 20);
+    TEST_ASSERT_EQUAL_UINT32(0, ranger.sequence());
+    ranger.trigger(100);
+    ranger.onEdge(false, 200);
+    TEST_ASSERT_EQUAL_INT(Ultrasonic::Ranger::WAIT_RISE, ranger.getState());
+    ranger.onEdge(true, 100 + ECHO_DELAY_US);
+    ranger.onEdge(true, 100 + ECHO_DELAY_US + 10); // 重复的上升沿不改变起点
+    ranger.onEdge(false, 100 + ECHO_DELAY_US + echoUs(30));
+    TEST_ASSERT_EQUAL_INT(30, ranger.raw());
+}
+
+void test_micros_wraparound()
+{
+    uint32_t t = 0xFFFFFFFFu - 3000;
+    ranger.trigger(t);
+    ranger.onEdge(true, t + ECHO_DELAY_US);
+    ranger.poll(t + 5000); // 跨过回绕，未超时
+    TEST_ASSERT_EQUAL_INT(Ultrasonic::Ranger::WAIT_FALL, ranger.getState());
+    ranger.onEdge(false, t + ECHO_DELAY_US + echoUs(120));
+    TEST_ASSERT_EQUAL_INT(120, ranger.raw());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_single_echo);
+    RUN_TEST(test_distances_2_to_400cm);
+    RUN_TEST(test_median_rejects_spikes);
+    RUN_TEST(test_timeout_without_fall);
+    RUN_TEST(test_retrigger_counts_as_out_of_range);
+    RUN_TEST(test_ignores_stray_edges);
+    RUN_TEST(test_micros_wraparound);
+    return UNITY_END();
+}
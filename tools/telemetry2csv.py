@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""把 Telemetry 二进制流 (COBS + CRC16) 转换为 CSV。
+
+用法:
+    python3 tools/telemetry2csv.py /dev/cu.usbserial-0001 > data.csv   # 直接读串口 (需要 pyserial)
+    python3 tools/telemetry2csv.py capture.bin > data.csv               # 读取录制的文件
+    cat capture.bin | python3 tools/telemetry2csv.py - > data.csv
+
+帧格式见 src/Telemetry/Telemetry.h。模块的状态提示和 Profiler 的统计都以文本帧发送，
+原样打印到 stderr; 错误与丢帧数量在结束时打印到 stderr。
+"""
+
+import struct
+import sys
+
+RECORD_ENV = 1
+RECORD_TEXT = 2
+PAYLOAD_SIZE = 15
+RAW_SIZE = PAYLOAD_SIZE + 2
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_frame(frame):
+    """返回记录元组、文本 (str) 或 None (帧错误)。"""
+    raw = cobs_decode(frame)
+    if raw is None or len(raw) < 3:
+        return None
+    (crc,) = struct.unpack_from("<H", raw, len(raw) - 2)
+    if crc != crc16(raw[:-2]):
+        return None
+    if raw[0] == RECORD_TEXT:
+        return raw[1:-2].decode("utf-8", errors="replace")
+    if raw[0] != RECORD_ENV or len(raw) != RAW_SIZE:
+        return None
+    return struct.unpack_from("<HIhHHH", raw, 1)
+
+
+def open_input(path):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+        return serial.Serial(path, 115200)
+    return open(path, "rb")
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__, file=sys.stderr)
+        return 1
+
+    src = open_input(sys.argv[1])
+    print("seq,timestamp_ms,temp_c,hum_pct,light,threshold")
+    frames = errors = lost = 0
+    last_seq = None
+    buf = bytearray()
+    try:
+        while True:
+            chunk = src.read(src.in_waiting or 1) if hasattr(src, "in_waiting") else src.read(4096)
+            if not chunk:
+                break
+            for b in chunk:
+                if b != 0:
+                    buf.append(b)
+                    continue
+                if not buf:
+                    continue
+                record = decode_frame(bytes(buf))
+                buf.clear()
+                if record is None:
+                    errors += 1
+                    continue
+                if isinstance(record, str):
+                    print(f"# {record}", file=sys.stderr)
+                    continue
+                seq, ts, temp10, hum10, light, threshold = record
+                if last_seq is not None:
+                    lost += (seq - last_seq - 1) & 0xFFFF
+                last_seq = seq
+                frames += 1
+                print(f"{seq},{ts},{temp10 / 10:.1f},{hum10 / 10:.1f},{light},{threshold}")
+    except KeyboardInterrupt:
+        pass
+
+    print(f"frames={frames} errors={errors} lost={lost}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())